@@ -15,7 +15,8 @@
  * - Parser descendente recursivo
  * - Tratamento correto de precedência de operadores
  * - Construção de árvore sintática abstrata (AST)
- * - Avaliação de expressões
+ * - Avaliação de expressões (percorrendo a árvore ou por bytecode)
+ * - Compilação da AST para bytecode e máquina virtual de pilha
  * - Detecção de erros sintáticos
  * 
  * Exemplos de entrada válida:
@@ -24,14 +25,32 @@
  * - "(a + b) * c"
  * - "10 / (2 + 3)"
  * 
+ * Uso:
+ *   ./exemploSimplificado                 demonstração
+ *   ./exemploSimplificado --benchmark [N] avaliações/s: árvore x bytecode x JIT
+ *   ./exemploSimplificado --lote [LINHAS] uma fórmula sobre colunas de valores
+ *   ./exemploSimplificado --cache [N]     fórmulas repetidas com cache LRU
+ * 
  * Autor: Disciplina de Compiladores
  * Data: 2024
  */
 
+#define _DEFAULT_SOURCE  // MAP_ANONYMOUS com -std=c99
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <time.h>
+
+// JIT só em x86-64 com a convenção de chamada System V (Linux, macOS)
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define JIT_AVAILABLE 1
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
 
 #define MAX_TOKEN_LENGTH 100
 
@@ -70,6 +89,7 @@ typedef struct ASTNode {
     char op;                    // Para operadores
     double value;               // Para números
     char name[MAX_TOKEN_LENGTH]; // Para identificadores
+    int slot;                   // Para identificadores: índice em variable_values (-1 = não resolvido)
     struct ASTNode* left;
     struct ASTNode* right;
 } ASTNode;
@@ -83,14 +103,19 @@ typedef struct {
     char error_message[200];
 } Parser;
 
-// Tabela de símbolos simples para variáveis
-typedef struct {
-    char name[MAX_TOKEN_LENGTH];
-    double value;
-} Variable;
-
-Variable variables[100];
+/*
+ * Ambiente de variáveis: cada nome recebe um slot denso na primeira vez que
+ * aparece, e os valores ficam lado a lado em variable_values. Os vetores
+ * crescem sem limite fixo; o índice por hash só é consultado para achar o
+ * slot de um nome (resolução e set/get por nome), nunca na avaliação.
+ */
+char (*variable_names)[MAX_TOKEN_LENGTH] = NULL;
+double* variable_values = NULL;
 int var_count = 0;
+int var_capacity = 0;
+
+int* var_index = NULL;      // hash aberto nome -> slot (-1 = vazio)
+int var_index_capacity = 0; // potência de 2, sempre mais que o dobro de var_count
 
 // ==================== LEXER ====================
 
@@ -178,6 +203,7 @@ ASTNode* create_identifier_node(const char* name) {
     ASTNode* node = malloc(sizeof(ASTNode));
     node->type = NODE_IDENTIFIER;
     strcpy(node->name, name);
+    node->slot = -1;
     node->left = NULL;
     node->right = NULL;
     return node;
@@ -192,6 +218,18 @@ ASTNode* create_binary_op_node(char op, ASTNode* left, ASTNode* right) {
     return node;
 }
 
+void free_ast(ASTNode* node) {
+    if (!node) return;
+    free_ast(node->left);
+    free_ast(node->right);
+    free(node);
+}
+
+int count_ast_nodes(ASTNode* node) {
+    if (!node) return 0;
+    return 1 + count_ast_nodes(node->left) + count_ast_nodes(node->right);
+}
+
 void print_ast(ASTNode* node, int depth) {
     if (!node) return;
     
@@ -302,29 +340,73 @@ ASTNode* parse(Parser* parser) {
 
 // ==================== AVALIADOR ====================
 
-double get_variable_value(const char* name) {
-    for (int i = 0; i < var_count; i++) {
-        if (strcmp(variables[i].name, name) == 0) {
-            return variables[i].value;
-        }
-    }
-    return 0.0; // valor padrão se variável não encontrada
+unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;
+    while (*name) hash = (hash ^ (unsigned char)*name++) * 16777619u;
+    return hash;
 }
 
-void set_variable_value(const char* name, double value) {
-    for (int i = 0; i < var_count; i++) {
-        if (strcmp(variables[i].name, name) == 0) {
-            variables[i].value = value;
-            return;
-        }
+// Posição do nome no índice: o slot que o contém ou a primeira posição vazia
+int* index_position(const char* name) {
+    unsigned int mask = var_index_capacity - 1;
+    unsigned int i = hash_name(name) & mask;
+    while (var_index[i] >= 0 && strcmp(variable_names[var_index[i]], name) != 0) {
+        i = (i + 1) & mask;
     }
-    
-    // Adiciona nova variável
-    if (var_count < 100) {
-        strcpy(variables[var_count].name, name);
-        variables[var_count].value = value;
-        var_count++;
+    return &var_index[i];
+}
+
+void grow_index(void) {
+    free(var_index);
+    var_index_capacity = var_index_capacity ? var_index_capacity * 2 : 64;
+    var_index = malloc(var_index_capacity * sizeof(int));
+    for (int i = 0; i < var_index_capacity; i++) var_index[i] = -1;
+    for (int slot = 0; slot < var_count; slot++) *index_position(variable_names[slot]) = slot;
+}
+
+// Slot da variável, ou -1 se o nome ainda não apareceu
+int find_variable(const char* name) {
+    return var_count > 0 ? *index_position(name) : -1;
+}
+
+// Slot da variável, criado (com valor 0) se o nome ainda não apareceu
+int resolve_variable(const char* name) {
+    if (2 * (var_count + 1) > var_index_capacity) grow_index();
+    int* position = index_position(name);
+    if (*position >= 0) return *position;
+
+    if (var_count == var_capacity) {
+        var_capacity = var_capacity ? var_capacity * 2 : 16;
+        variable_names = realloc(variable_names, var_capacity * sizeof(*variable_names));
+        variable_values = realloc(variable_values, var_capacity * sizeof(double));
     }
+    strcpy(variable_names[var_count], name);
+    variable_values[var_count] = 0.0;  // valor padrão de variável não definida
+    *position = var_count;
+    return var_count++;
+}
+
+double get_variable_value(const char* name) {
+    int slot = find_variable(name);
+    return slot >= 0 ? variable_values[slot] : 0.0; // valor padrão se variável não encontrada
+}
+
+void set_variable_value(const char* name, double value) {
+    int slot = resolve_variable(name);  // pode realocar variable_values
+    variable_values[slot] = value;
+}
+
+/*
+ * Passo de resolução: liga cada identificador ao seu slot uma única vez,
+ * depois da análise sintática. Variáveis ainda não definidas ganham um slot
+ * com valor 0, e um set_variable_value posterior escreve nesse mesmo slot,
+ * então a árvore resolvida enxerga os valores atuais.
+ */
+void resolve_variables(ASTNode* node) {
+    if (!node) return;
+    if (node->type == NODE_IDENTIFIER) node->slot = resolve_variable(node->name);
+    resolve_variables(node->left);
+    resolve_variables(node->right);
 }
 
 double evaluate_ast(ASTNode* node) {
@@ -335,7 +417,7 @@ double evaluate_ast(ASTNode* node) {
             return node->value;
             
         case NODE_IDENTIFIER:
-            return get_variable_value(node->name);
+            return node->slot >= 0 ? variable_values[node->slot] : get_variable_value(node->name);
             
         case NODE_BINARY_OP:
             {
@@ -361,6 +443,1016 @@ double evaluate_ast(ASTNode* node) {
     }
 }
 
+// ==================== BYTECODE ====================
+
+/*
+ * evaluate_ast percorre a árvore de ponteiros a cada avaliação: uma chamada
+ * recursiva e um switch por nó, com os nós espalhados pela memória. Quando
+ * a mesma fórmula é avaliada milhões de vezes, compensa traduzi-la uma
+ * única vez para um código linear de máquina de pilha, em pós-ordem:
+ *
+ *     (x + 2) * y   =>   LOAD x; CONST 2; ADD; LOAD y; MUL; HALT
+ *
+ * Cada instrução ocupa 1 byte de opcode, seguido, em CONST e LOAD, de um
+ * operando de 2 bytes: o índice na tabela de constantes ou o slot da
+ * variável (ver resolve_variables).
+ */
+typedef enum {
+    OP_CONST,   // empilha constants[operando]
+    OP_LOAD,    // empilha variable_values[operando]
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_HALT     // fim: o resultado está no topo da pilha
+} OpCode;
+
+#define MAX_OPERAND 65536  // operandos de 2 bytes
+
+typedef struct {
+    unsigned char* code;
+    int length;
+    int capacity;
+
+    double* constants;
+    int constant_count;
+    int constant_capacity;
+
+    int max_stack;  // profundidade máxima da pilha, calculada na compilação
+    int has_error;
+} Bytecode;
+
+static const char* const opcode_names[] = {"CONST", "LOAD", "ADD", "SUB", "MUL", "DIV", "HALT"};
+
+void emit_byte(Bytecode* bc, unsigned char byte) {
+    if (bc->length == bc->capacity) {
+        bc->capacity = bc->capacity ? bc->capacity * 2 : 64;
+        bc->code = realloc(bc->code, bc->capacity);
+    }
+    bc->code[bc->length++] = byte;
+}
+
+void emit_with_operand(Bytecode* bc, OpCode op, int operand) {
+    emit_byte(bc, (unsigned char)op);
+    emit_byte(bc, (unsigned char)(operand & 0xff));
+    emit_byte(bc, (unsigned char)(operand >> 8));
+}
+
+// Índice da constante (constantes repetidas são armazenadas uma vez)
+int add_constant(Bytecode* bc, double value) {
+    for (int i = 0; i < bc->constant_count; i++) {
+        if (bc->constants[i] == value) return i;
+    }
+    if (bc->constant_count == MAX_OPERAND) {
+        bc->has_error = 1;
+        return 0;
+    }
+    if (bc->constant_count == bc->constant_capacity) {
+        bc->constant_capacity = bc->constant_capacity ? bc->constant_capacity * 2 : 8;
+        bc->constants = realloc(bc->constants, bc->constant_capacity * sizeof(double));
+    }
+    bc->constants[bc->constant_count] = value;
+    return bc->constant_count++;
+}
+
+// Gera o código de 'node' supondo 'depth' valores já na pilha
+void compile_node(Bytecode* bc, ASTNode* node, int depth) {
+    if (depth + 1 > bc->max_stack) bc->max_stack = depth + 1;
+
+    if (!node) {
+        emit_with_operand(bc, OP_CONST, add_constant(bc, 0.0));
+        return;
+    }
+
+    switch (node->type) {
+        case NODE_NUMBER:
+            emit_with_operand(bc, OP_CONST, add_constant(bc, node->value));
+            break;
+
+        case NODE_IDENTIFIER: {
+            int slot = node->slot >= 0 ? node->slot : resolve_variable(node->name);
+            if (slot >= MAX_OPERAND) bc->has_error = 1;
+            emit_with_operand(bc, OP_LOAD, slot);
+            break;
+        }
+
+        case NODE_BINARY_OP: {
+            OpCode op;
+            switch (node->op) {
+                case '+': op = OP_ADD; break;
+                case '-': op = OP_SUB; break;
+                case '*': op = OP_MUL; break;
+                case '/': op = OP_DIV; break;
+                default:
+                    // Mesmo resultado de evaluate_ast: operador desconhecido vale 0
+                    emit_with_operand(bc, OP_CONST, add_constant(bc, 0.0));
+                    return;
+            }
+            compile_node(bc, node->left, depth);
+            compile_node(bc, node->right, depth + 1);
+            emit_byte(bc, (unsigned char)op);
+            break;
+        }
+
+        default:
+            emit_with_operand(bc, OP_CONST, add_constant(bc, 0.0));
+            break;
+    }
+}
+
+Bytecode* compile_ast(ASTNode* ast) {
+    Bytecode* bc = calloc(1, sizeof(Bytecode));
+    compile_node(bc, ast, 0);
+    emit_byte(bc, OP_HALT);
+    if (bc->has_error) {
+        printf("Erro: mais de %d constantes ou variáveis distintas\n", MAX_OPERAND);
+    }
+    return bc;
+}
+
+void free_bytecode(Bytecode* bc) {
+    free(bc->code);
+    free(bc->constants);
+    free(bc);
+}
+
+void print_bytecode(const Bytecode* bc) {
+    int pc = 0;
+    while (pc < bc->length) {
+        OpCode op = (OpCode)bc->code[pc];
+        printf("  %04d  %s", pc, opcode_names[op]);
+        if (op == OP_CONST || op == OP_LOAD) {
+            int operand = bc->code[pc + 1] | (bc->code[pc + 2] << 8);
+            if (op == OP_CONST) {
+                printf("%*s%g", 6 - (int)strlen(opcode_names[op]), "", bc->constants[operand]);
+            } else {
+                printf("%*s%s", 6 - (int)strlen(opcode_names[op]), "", variable_names[operand]);
+            }
+            pc += 3;
+        } else {
+            pc++;
+        }
+        printf("\n");
+    }
+    printf("  (%d bytes de código, pilha máxima %d)\n", bc->length, bc->max_stack);
+}
+
+/*
+ * Máquina virtual de pilha. Com GCC/Clang o despacho usa "computed goto"
+ * (rótulos como valores): cada instrução salta direto para a próxima pela
+ * tabela de endereços, sem voltar ao topo de um switch, e o preditor de
+ * desvios aprende um padrão por instrução. Nos demais compiladores, um
+ * switch dentro de um laço faz o mesmo trabalho.
+ */
+#if defined(__GNUC__)
+#define VM_COMPUTED_GOTO 1
+#endif
+
+double run_bytecode(const Bytecode* bc) {
+    double stack_buffer[64];
+    double* stack = bc->max_stack <= 64 ? stack_buffer : malloc(bc->max_stack * sizeof(double));
+    double* sp = stack;     // próxima posição livre
+    const unsigned char* ip = bc->code;
+    double result;
+
+#ifdef VM_COMPUTED_GOTO
+    static void* const dispatch_table[] = {
+        &&label_OP_CONST, &&label_OP_LOAD, &&label_OP_ADD, &&label_OP_SUB,
+        &&label_OP_MUL, &&label_OP_DIV, &&label_OP_HALT
+    };
+#define VM_CASE(op) label_##op:
+#define VM_NEXT() goto *dispatch_table[*ip++]
+    VM_NEXT();
+#else
+#define VM_CASE(op) case op:
+#define VM_NEXT() break
+    for (;;) switch (*ip++) {
+#endif
+
+    VM_CASE(OP_CONST)
+        *sp++ = bc->constants[ip[0] | (ip[1] << 8)];
+        ip += 2;
+        VM_NEXT();
+
+    VM_CASE(OP_LOAD)
+        *sp++ = variable_values[ip[0] | (ip[1] << 8)];
+        ip += 2;
+        VM_NEXT();
+
+    VM_CASE(OP_ADD)
+        sp--;
+        sp[-1] += sp[0];
+        VM_NEXT();
+
+    VM_CASE(OP_SUB)
+        sp--;
+        sp[-1] -= sp[0];
+        VM_NEXT();
+
+    VM_CASE(OP_MUL)
+        sp--;
+        sp[-1] *= sp[0];
+        VM_NEXT();
+
+    VM_CASE(OP_DIV)
+        sp--;
+        if (sp[0] == 0.0) {
+            printf("Erro: Divisão por zero!\n");
+            sp[-1] = 0.0;
+        } else {
+            sp[-1] /= sp[0];
+        }
+        VM_NEXT();
+
+    VM_CASE(OP_HALT)
+        result = sp[-1];
+        goto done;
+
+#ifndef VM_COMPUTED_GOTO
+    }
+#endif
+#undef VM_CASE
+#undef VM_NEXT
+
+done:
+    if (stack != stack_buffer) free(stack);
+    return result;
+}
+
+// ==================== JIT x86-64 ====================
+
+/*
+ * Para as fórmulas mais quentes, o bytecode é traduzido para código de
+ * máquina x86-64 com instruções escalares SSE2. A pilha da VM desaparece:
+ * a posição d da pilha vira o registrador xmm<d> (xmm0..xmm14), então
+ *
+ *     LOAD x; CONST 2; ADD   =>   movsd xmm0, [rdi + 8*slot_x]
+ *                                 movsd xmm1, [rip + constante_2]
+ *                                 addsd xmm0, xmm1
+ *
+ * A função gerada segue a convenção System V:
+ *
+ *     double f(const double* variable_values, long* zero_divisions)
+ *
+ * e devolve o resultado em xmm0. As constantes ficam logo depois do
+ * código, no mesmo buffer, endereçadas relativamente ao RIP. O buffer é
+ * obtido com mmap como leitura/escrita e, depois de preenchido, passa a
+ * leitura/execução (nunca escrita e execução ao mesmo tempo).
+ *
+ * Divisão por zero segue evaluate_ast: com xmm15 = 0,
+ *
+ *     ucomisd b, xmm15        ; b == 0? (NaN não é zero: testa PF)
+ *     jp  divide
+ *     jne divide
+ *     inc qword [rsi]         ; conta a divisão por zero
+ *     xorpd a, a              ; resultado 0
+ *     jmp fim
+ *   divide:
+ *     divsd a, b
+ *   fim:
+ *
+ * e run_jit imprime a mensagem de erro uma vez por divisão contada.
+ * Sem x86-64, se a expressão precisar de mais de 15 registradores ou se o
+ * sistema negar memória executável, jit_compile devolve NULL e a avaliação
+ * continua no interpretador de bytecode.
+ */
+#define JIT_REGISTERS 15     // xmm0..xmm14; xmm15 guarda o zero
+
+typedef double (*JitFunction)(const double* variable_values, long* zero_divisions);
+
+typedef struct {
+    JitFunction function;
+    void* memory;
+    size_t size;
+} JitCode;
+
+#ifdef JIT_AVAILABLE
+
+typedef struct {
+    unsigned char* code;
+    int length;
+    int capacity;
+    int* fixups;        // pares (posição do deslocamento, índice da constante)
+    int fixup_count;
+} JitBuffer;
+
+static void jit_byte(JitBuffer* jb, unsigned char byte) {
+    if (jb->length == jb->capacity) {
+        jb->capacity = jb->capacity ? jb->capacity * 2 : 256;
+        jb->code = realloc(jb->code, jb->capacity);
+    }
+    jb->code[jb->length++] = byte;
+}
+
+static void jit_int32(JitBuffer* jb, int value) {
+    for (int i = 0; i < 4; i++) jit_byte(jb, (unsigned char)((unsigned int)value >> (8 * i)));
+}
+
+// Prefixo obrigatório, REX (se algum registrador for xmm8..xmm15) e opcode 0F xx
+static void jit_sse_prefix(JitBuffer* jb, unsigned char prefix, unsigned char opcode, int reg, int rm) {
+    jit_byte(jb, prefix);
+    if (reg >= 8 || rm >= 8) jit_byte(jb, (unsigned char)(0x40 | ((reg >> 3) << 2) | (rm >> 3)));
+    jit_byte(jb, 0x0F);
+    jit_byte(jb, opcode);
+}
+
+// op xmm<reg>, xmm<rm>
+static void jit_sse_rr(JitBuffer* jb, unsigned char prefix, unsigned char opcode, int reg, int rm) {
+    jit_sse_prefix(jb, prefix, opcode, reg, rm);
+    jit_byte(jb, (unsigned char)(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+}
+
+// movsd xmm<reg>, [rdi + 8 * slot]
+static void jit_load_variable(JitBuffer* jb, int reg, int slot) {
+    jit_sse_prefix(jb, 0xF2, 0x10, reg, 0);
+    jit_byte(jb, (unsigned char)(0x80 | ((reg & 7) << 3) | 7));
+    jit_int32(jb, slot * 8);
+}
+
+// movsd xmm<reg>, [rip + constante]; o deslocamento é corrigido no fim
+static void jit_load_constant(JitBuffer* jb, int reg, int index) {
+    jit_sse_prefix(jb, 0xF2, 0x10, reg, 0);
+    jit_byte(jb, (unsigned char)(((reg & 7) << 3) | 5));
+    jb->fixups = realloc(jb->fixups, (jb->fixup_count + 1) * 2 * sizeof(int));
+    jb->fixups[2 * jb->fixup_count] = jb->length;
+    jb->fixups[2 * jb->fixup_count + 1] = index;
+    jb->fixup_count++;
+    jit_int32(jb, 0);
+}
+
+// Salto curto com deslocamento a preencher; devolve a posição do deslocamento
+static int jit_jump(JitBuffer* jb, unsigned char opcode) {
+    jit_byte(jb, opcode);
+    jit_byte(jb, 0);
+    return jb->length - 1;
+}
+
+static void jit_patch_jump(JitBuffer* jb, int position) {
+    jb->code[position] = (unsigned char)(jb->length - (position + 1));
+}
+
+static void jit_divide(JitBuffer* jb, int a, int b) {
+    jit_sse_rr(jb, 0x66, 0x2E, b, 15);         // ucomisd b, xmm15
+    int unordered = jit_jump(jb, 0x7A);         // jp divide
+    int not_zero = jit_jump(jb, 0x75);          // jne divide
+    jit_byte(jb, 0x48);                         // inc qword [rsi]
+    jit_byte(jb, 0xFF);
+    jit_byte(jb, 0x06);
+    jit_sse_rr(jb, 0x66, 0x57, a, a);           // xorpd a, a
+    int done = jit_jump(jb, 0xEB);              // jmp fim
+    jit_patch_jump(jb, unordered);
+    jit_patch_jump(jb, not_zero);
+    jit_sse_rr(jb, 0xF2, 0x5E, a, b);           // divsd a, b
+    jit_patch_jump(jb, done);
+}
+
+JitCode* jit_compile(const Bytecode* bc) {
+    if (bc->has_error || bc->max_stack > JIT_REGISTERS) return NULL;
+
+    JitBuffer jb = {NULL, 0, 0, NULL, 0};
+    jit_sse_rr(&jb, 0x66, 0x57, 15, 15);        // xorpd xmm15, xmm15
+
+    int depth = 0;
+    int pc = 0;
+    while (bc->code[pc] != OP_HALT) {
+        OpCode op = (OpCode)bc->code[pc];
+        if (op == OP_CONST || op == OP_LOAD) {
+            int operand = bc->code[pc + 1] | (bc->code[pc + 2] << 8);
+            if (op == OP_CONST) {
+                jit_load_constant(&jb, depth, operand);
+            } else {
+                jit_load_variable(&jb, depth, operand);
+            }
+            depth++;
+            pc += 3;
+            continue;
+        }
+
+        depth--;
+        int a = depth - 1, b = depth;
+        switch (op) {
+            case OP_ADD: jit_sse_rr(&jb, 0xF2, 0x58, a, b); break;
+            case OP_SUB: jit_sse_rr(&jb, 0xF2, 0x5C, a, b); break;
+            case OP_MUL: jit_sse_rr(&jb, 0xF2, 0x59, a, b); break;
+            case OP_DIV: jit_divide(&jb, a, b); break;
+            default: break;
+        }
+        pc++;
+    }
+    jit_byte(&jb, 0xC3);                        // ret (resultado em xmm0)
+
+    // Constantes alinhadas em 8 bytes logo após o código
+    int constants_offset = (jb.length + 7) & ~7;
+    size_t size = constants_offset + bc->constant_count * sizeof(double);
+    for (int i = 0; i < jb.fixup_count; i++) {
+        int position = jb.fixups[2 * i];
+        int displacement = constants_offset + 8 * jb.fixups[2 * i + 1] - (position + 4);
+        memcpy(jb.code + position, &displacement, 4);
+    }
+
+    void* memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    JitCode* jit = NULL;
+    if (memory != MAP_FAILED) {
+        memcpy(memory, jb.code, jb.length);
+        memset((unsigned char*)memory + jb.length, 0xCC, constants_offset - jb.length);  // int3
+        if (bc->constant_count > 0) {
+            memcpy((unsigned char*)memory + constants_offset, bc->constants, bc->constant_count * sizeof(double));
+        }
+        if (mprotect(memory, size, PROT_READ | PROT_EXEC) == 0) {
+            jit = malloc(sizeof(JitCode));
+            jit->function = (JitFunction)memory;
+            jit->memory = memory;
+            jit->size = size;
+        } else {
+            munmap(memory, size);
+        }
+    }
+
+    free(jb.code);
+    free(jb.fixups);
+    return jit;
+}
+
+void free_jit(JitCode* jit) {
+    if (!jit) return;
+    munmap(jit->memory, jit->size);
+    free(jit);
+}
+
+#else
+
+JitCode* jit_compile(const Bytecode* bc) {
+    (void)bc;
+    return NULL;
+}
+
+void free_jit(JitCode* jit) {
+    (void)jit;
+}
+
+#endif
+
+// Executa o código nativo; as divisões por zero são reportadas como em evaluate_ast
+double run_jit(const JitCode* jit) {
+    long zero_divisions = 0;
+    double result = jit->function(variable_values, &zero_divisions);
+    for (long i = 0; i < zero_divisions; i++) printf("Erro: Divisão por zero!\n");
+    return result;
+}
+
+// Avalia pelo JIT quando houver código nativo, senão pelo interpretador
+double run_compiled(const Bytecode* bc, const JitCode* jit) {
+    return jit ? run_jit(jit) : run_bytecode(bc);
+}
+
+// ==================== AVALIAÇÃO EM LOTE ====================
+
+/*
+ * Uma fórmula avaliada sobre milhões de linhas de valores não precisa de
+ * uma execução do bytecode por linha. Em evaluate_batch os valores de cada
+ * variável vêm em colunas (um vetor por variável, indexado pela linha), e
+ * a VM executa cada instrução sobre um bloco inteiro de linhas: a pilha
+ * passa a ser de vetores, e ADD vira um laço "a[i] += b[i]" sobre o bloco.
+ * O despacho é pago uma vez por bloco, e os laços internos, sem desvios e
+ * sem aliasing (restrict), são vetorizados pelo compilador (SSE2/AVX com
+ * -O3 ou -O2 -ftree-vectorize).
+ */
+#define BATCH_BLOCK 256
+
+static void fill_block(double* restrict out, double value, int n) {
+    for (int i = 0; i < n; i++) out[i] = value;
+}
+
+static void add_block(double* restrict a, const double* restrict b, int n) {
+    for (int i = 0; i < n; i++) a[i] += b[i];
+}
+
+static void sub_block(double* restrict a, const double* restrict b, int n) {
+    for (int i = 0; i < n; i++) a[i] -= b[i];
+}
+
+static void mul_block(double* restrict a, const double* restrict b, int n) {
+    for (int i = 0; i < n; i++) a[i] *= b[i];
+}
+
+// Divisão com a regra de evaluate_ast (divisor zero dá 0); devolve quantas linhas tinham divisor zero
+static int div_block(double* restrict a, const double* restrict b, int n) {
+    int zeros = 0;
+    for (int i = 0; i < n; i++) {
+        zeros += b[i] == 0.0;
+        a[i] = b[i] == 0.0 ? 0.0 : a[i] / b[i];
+    }
+    return zeros;
+}
+
+/*
+ * Avalia o bytecode para as linhas [0, row_count) e grava os resultados em
+ * out. columns[slot] é a coluna da variável de slot 'slot' (ver
+ * resolve_variable); uma coluna NULL (ou slot além de column_count) usa o
+ * valor atual da variável em todas as linhas. Divisões por zero dão 0, como
+ * na avaliação por linha, e são reportadas uma única vez com a contagem.
+ */
+void evaluate_batch(const Bytecode* bc, const double* const* columns, int column_count,
+                    long row_count, double* out) {
+    double* stack = malloc((size_t)bc->max_stack * BATCH_BLOCK * sizeof(double));
+    long zero_divisions = 0;
+
+    for (long start = 0; start < row_count; start += BATCH_BLOCK) {
+        int n = row_count - start < BATCH_BLOCK ? (int)(row_count - start) : BATCH_BLOCK;
+        double* top = stack;    // próximo vetor livre da pilha
+        const unsigned char* ip = bc->code;
+
+        for (;;) {
+            OpCode op = (OpCode)*ip++;
+            if (op == OP_HALT) break;
+
+            switch (op) {
+                case OP_CONST:
+                    fill_block(top, bc->constants[ip[0] | (ip[1] << 8)], n);
+                    top += BATCH_BLOCK;
+                    ip += 2;
+                    break;
+
+                case OP_LOAD: {
+                    int slot = ip[0] | (ip[1] << 8);
+                    if (slot < column_count && columns[slot]) {
+                        memcpy(top, columns[slot] + start, n * sizeof(double));
+                    } else {
+                        fill_block(top, variable_values[slot], n);
+                    }
+                    top += BATCH_BLOCK;
+                    ip += 2;
+                    break;
+                }
+
+                case OP_ADD: top -= BATCH_BLOCK; add_block(top - BATCH_BLOCK, top, n); break;
+                case OP_SUB: top -= BATCH_BLOCK; sub_block(top - BATCH_BLOCK, top, n); break;
+                case OP_MUL: top -= BATCH_BLOCK; mul_block(top - BATCH_BLOCK, top, n); break;
+                case OP_DIV: top -= BATCH_BLOCK; zero_divisions += div_block(top - BATCH_BLOCK, top, n); break;
+                default: break;
+            }
+        }
+
+        memcpy(out + start, top - BATCH_BLOCK, n * sizeof(double));
+    }
+
+    if (zero_divisions > 0) {
+        printf("Erro: Divisão por zero em %ld linha(s)!\n", zero_divisions);
+    }
+    free(stack);
+}
+
+// ==================== CACHE DE EXPRESSÕES ====================
+
+/*
+ * Em produção as mesmas poucas centenas de fórmulas chegam repetidamente.
+ * O cache guarda, para cada texto de fórmula, a forma já compilada (AST
+ * resolvida, bytecode e, se houver, código JIT), e uma avaliação repetida
+ * não passa mais pelo léxico, pelo parser nem pelo compilador.
+ *
+ * - Chave: o texto normalizado. Espaços só são mantidos entre dois
+ *   caracteres de palavra (onde separam tokens), então "( x+2 )" e
+ *   "(x + 2)" são a mesma entrada.
+ * - Tabela hash com encadeamento para achar a entrada, e uma lista
+ *   duplamente ligada na ordem de uso: a cabeça é a mais recente.
+ * - Orçamento de memória: cada entrada conta os bytes da chave, da AST, do
+ *   bytecode e do código nativo; ao passar do orçamento, as entradas menos
+ *   usadas recentemente (cauda da lista) são descartadas.
+ * - Erros de sintaxe não são guardados.
+ */
+typedef struct CacheEntry {
+    char* key;
+    unsigned int hash;
+    ASTNode* ast;
+    Bytecode* bc;
+    JitCode* jit;
+    size_t bytes;
+    struct CacheEntry* bucket_next;     // encadeamento na tabela hash
+    struct CacheEntry* newer;           // lista de uso (LRU)
+    struct CacheEntry* older;
+} CacheEntry;
+
+typedef struct {
+    CacheEntry** buckets;
+    int bucket_count;       // potência de 2
+    int count;
+    size_t bytes;
+    size_t budget;
+    CacheEntry* newest;
+    CacheEntry* oldest;
+    long hits;
+    long misses;
+    long evictions;
+} ExpressionCache;
+
+static int is_word_char(char c) {
+    return isalnum((unsigned char)c) || c == '_';
+}
+
+// Remove os espaços que não separam tokens; out precisa de strlen(text) + 1 bytes
+void normalize_expression(const char* text, char* out) {
+    int length = 0;
+    int pending_space = 0;
+    for (; *text; text++) {
+        if (isspace((unsigned char)*text)) {
+            pending_space = 1;
+            continue;
+        }
+        if (pending_space && length > 0 && is_word_char(out[length - 1]) && is_word_char(*text)) {
+            out[length++] = ' ';
+        }
+        pending_space = 0;
+        out[length++] = *text;
+    }
+    out[length] = '\0';
+}
+
+void cache_init(ExpressionCache* cache, size_t budget) {
+    cache->bucket_count = 64;
+    cache->buckets = calloc(cache->bucket_count, sizeof(CacheEntry*));
+    cache->count = 0;
+    cache->bytes = 0;
+    cache->budget = budget;
+    cache->newest = NULL;
+    cache->oldest = NULL;
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->evictions = 0;
+}
+
+static void lru_unlink(ExpressionCache* cache, CacheEntry* entry) {
+    if (entry->newer) entry->newer->older = entry->older; else cache->newest = entry->older;
+    if (entry->older) entry->older->newer = entry->newer; else cache->oldest = entry->newer;
+}
+
+static void lru_push_newest(ExpressionCache* cache, CacheEntry* entry) {
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if (cache->newest) cache->newest->newer = entry; else cache->oldest = entry;
+    cache->newest = entry;
+}
+
+static void free_entry(CacheEntry* entry) {
+    free_jit(entry->jit);
+    free_bytecode(entry->bc);
+    free_ast(entry->ast);
+    free(entry->key);
+    free(entry);
+}
+
+static void cache_remove(ExpressionCache* cache, CacheEntry* entry) {
+    CacheEntry** link = &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while (*link != entry) link = &(*link)->bucket_next;
+    *link = entry->bucket_next;
+    lru_unlink(cache, entry);
+    cache->count--;
+    cache->bytes -= entry->bytes;
+    free_entry(entry);
+}
+
+static void cache_grow(ExpressionCache* cache) {
+    int new_count = cache->bucket_count * 2;
+    CacheEntry** buckets = calloc(new_count, sizeof(CacheEntry*));
+    for (int b = 0; b < cache->bucket_count; b++) {
+        CacheEntry* entry = cache->buckets[b];
+        while (entry) {
+            CacheEntry* next = entry->bucket_next;
+            CacheEntry** bucket = &buckets[entry->hash & (new_count - 1)];
+            entry->bucket_next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = new_count;
+}
+
+/*
+ * Devolve a forma compilada da expressão, compilando-a em caso de falta.
+ * NULL se a expressão tiver erro de sintaxe (a mensagem vai para error).
+ * A entrada devolvida vale até a próxima chamada (pode ser descartada).
+ */
+const CacheEntry* cache_lookup(ExpressionCache* cache, const char* expression, char* error, size_t error_size) {
+    size_t text_length = strlen(expression);
+    char key_buffer[256];
+    char* key = text_length < sizeof(key_buffer) ? key_buffer : malloc(text_length + 1);
+    normalize_expression(expression, key);
+    unsigned int hash = hash_name(key);
+
+    for (CacheEntry* entry = cache->buckets[hash & (cache->bucket_count - 1)]; entry; entry = entry->bucket_next) {
+        if (entry->hash == hash && strcmp(entry->key, key) == 0) {
+            cache->hits++;
+            lru_unlink(cache, entry);
+            lru_push_newest(cache, entry);
+            if (key != key_buffer) free(key);
+            return entry;
+        }
+    }
+    cache->misses++;
+
+    Parser parser;
+    parser.input = key;
+    parser.position = 0;
+    parser.has_error = 0;
+    ASTNode* ast = parse(&parser);
+    if (parser.has_error) {
+        snprintf(error, error_size, "%s", parser.error_message);
+        free_ast(ast);
+        if (key != key_buffer) free(key);
+        return NULL;
+    }
+    resolve_variables(ast);
+
+    CacheEntry* entry = malloc(sizeof(CacheEntry));
+    entry->key = key != key_buffer ? key : strcpy(malloc(strlen(key) + 1), key);
+    entry->hash = hash;
+    entry->ast = ast;
+    entry->bc = compile_ast(ast);
+    entry->jit = jit_compile(entry->bc);
+    entry->bytes = sizeof(CacheEntry) + strlen(entry->key) + 1 +
+                   count_ast_nodes(ast) * sizeof(ASTNode) +
+                   sizeof(Bytecode) + entry->bc->capacity + entry->bc->constant_capacity * sizeof(double) +
+                   (entry->jit ? sizeof(JitCode) + entry->jit->size : 0);
+
+    if (2 * (cache->count + 1) > cache->bucket_count) cache_grow(cache);
+    CacheEntry** bucket = &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->bucket_next = *bucket;
+    *bucket = entry;
+    lru_push_newest(cache, entry);
+    cache->count++;
+    cache->bytes += entry->bytes;
+
+    // Respeita o orçamento descartando as menos usadas (nunca a que acabou de entrar)
+    while (cache->bytes > cache->budget && cache->oldest != entry) {
+        cache_remove(cache, cache->oldest);
+        cache->evictions++;
+    }
+    return entry;
+}
+
+// Avalia a expressão pelo cache; *ok = 0 em erro de sintaxe
+double evaluate_cached(ExpressionCache* cache, const char* expression, int* ok) {
+    char error[200];
+    const CacheEntry* entry = cache_lookup(cache, expression, error, sizeof(error));
+    *ok = entry != NULL;
+    return entry ? run_compiled(entry->bc, entry->jit) : 0.0;
+}
+
+void cache_print_stats(const ExpressionCache* cache) {
+    long lookups = cache->hits + cache->misses;
+    printf("Cache: %ld acertos, %ld faltas (%.1f%% de acerto), %ld descartes; "
+           "%d entradas, %.1f de %.1f KB\n",
+           cache->hits, cache->misses, lookups ? 100.0 * cache->hits / lookups : 0.0, cache->evictions,
+           cache->count, cache->bytes / 1024.0, cache->budget / 1024.0);
+}
+
+void cache_free(ExpressionCache* cache) {
+    while (cache->oldest) cache_remove(cache, cache->oldest);
+    free(cache->buckets);
+}
+
+// ==================== BENCHMARK ====================
+
+static double elapsed_seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/*
+ * Avalia cada fórmula 'iterations' vezes percorrendo a árvore e depois
+ * executando o bytecode, e mostra avaliações por segundo. A compilação
+ * acontece uma vez por fórmula, fora da medição.
+ */
+void run_benchmark(long iterations) {
+    static const char* const formulas[] = {
+        "x * y - z",
+        "2 + 3 * 4 - 1",
+        "((x + 1) * (y - 2) + z * 3) / (x + y + z)",
+        "x * x + 2 * x * y + y * y - (z + 1) / (x + 2) * 3 - y / 4 + (x - y) * (x + y) / (z * z + 1)",
+    };
+    int formula_count = sizeof(formulas) / sizeof(formulas[0]);
+
+    set_variable_value("x", 5.0);
+    set_variable_value("y", 3.0);
+    set_variable_value("z", 2.0);
+
+    printf("=== BENCHMARK: AVALIAÇÃO DE FÓRMULAS (%ld avaliações por fórmula) ===\n", iterations);
+    printf("Despacho da VM: %s\n",
+#ifdef VM_COMPUTED_GOTO
+           "computed goto"
+#else
+           "switch"
+#endif
+    );
+#ifdef JIT_AVAILABLE
+    printf("JIT: x86-64 SSE2\n\n");
+#else
+    printf("JIT: indisponível nesta arquitetura (coluna JIT usa o interpretador)\n\n");
+#endif
+    // Larguras em bytes: "ó", "á" ocupam dois bytes e uma coluna
+    printf("%-8s %7s | %18s | %18s | %13s | %13s | %8s\n", "fórmula", "nós",
+           "árvore por nome", "árvore com slots", "bytecode", "JIT", "ganho");
+
+    for (int f = 0; f < formula_count; f++) {
+        Parser parser;
+        parser.input = formulas[f];
+        parser.position = 0;
+        parser.has_error = 0;
+        ASTNode* ast = parse(&parser);
+        if (parser.has_error) {
+            printf("✗ ERRO SINTÁTICO em '%s': %s\n", formulas[f], parser.error_message);
+            continue;
+        }
+
+        // As somas impedem que o compilador descarte as avaliações
+        double named_sum = 0.0, tree_sum = 0.0, vm_sum = 0.0;
+        clock_t start = clock();
+        for (long i = 0; i < iterations; i++) named_sum += evaluate_ast(ast);
+        double named_seconds = elapsed_seconds(start);
+
+        resolve_variables(ast);
+        Bytecode* bc = compile_ast(ast);
+
+        start = clock();
+        for (long i = 0; i < iterations; i++) tree_sum += evaluate_ast(ast);
+        double tree_seconds = elapsed_seconds(start);
+
+        start = clock();
+        for (long i = 0; i < iterations; i++) vm_sum += run_bytecode(bc);
+        double vm_seconds = elapsed_seconds(start);
+
+        JitCode* jit = jit_compile(bc);
+        double jit_sum = 0.0;
+        start = clock();
+        for (long i = 0; i < iterations; i++) jit_sum += run_compiled(bc, jit);
+        double jit_seconds = elapsed_seconds(start);
+
+        int equal = named_sum == tree_sum && tree_sum == vm_sum && vm_sum == jit_sum;
+        printf("%-7d %6d | %17.0f | %17.0f | %13.0f | %13.0f | %7.2fx%s\n", f + 1, count_ast_nodes(ast),
+               iterations / named_seconds, iterations / tree_seconds, iterations / vm_seconds,
+               iterations / jit_seconds, named_seconds / jit_seconds,
+               equal ? "" : "  (RESULTADOS DIFERENTES)");
+        free_jit(jit);
+        free_bytecode(bc);
+        free_ast(ast);
+    }
+
+    printf("\nValores em avaliações/s; ganho = JIT sobre a árvore por nome.\n");
+    printf("\nFórmulas:\n");
+    for (int f = 0; f < formula_count; f++) printf("  %d: %s\n", f + 1, formulas[f]);
+}
+
+/*
+ * Avalia cada fórmula sobre 'rows' linhas de valores de x, y e z: linha a
+ * linha pela árvore (atribuindo as variáveis a cada linha), linha a linha
+ * pelo bytecode e em lote sobre as colunas.
+ */
+void run_batch_benchmark(long rows) {
+    static const char* const formulas[] = {
+        "x * y - z",
+        "((x + 1) * (y - 2) + z * 3) / (x + y + z)",
+        "x * x + 2 * x * y + y * y - (z + 1) / (x + 2) * 3 - y / 4 + (x - y) * (x + y) / (z * z + 1)",
+    };
+    int formula_count = sizeof(formulas) / sizeof(formulas[0]);
+
+    int slots[3] = {resolve_variable("x"), resolve_variable("y"), resolve_variable("z")};
+    const double** columns = calloc(var_count, sizeof(double*));
+    double* data[3];
+    unsigned int seed = 12345;
+    for (int c = 0; c < 3; c++) {
+        data[c] = malloc(rows * sizeof(double));
+        for (long i = 0; i < rows; i++) {
+            seed = seed * 1103515245u + 12345u;
+            data[c][i] = (double)((seed >> 16) % 1000) / 10.0 + 1.0;  // valores em [1, 100.9]
+        }
+        columns[slots[c]] = data[c];
+    }
+    double* expected = malloc(rows * sizeof(double));
+    double* out = malloc(rows * sizeof(double));
+
+    printf("=== BENCHMARK: AVALIAÇÃO EM LOTE (%ld linhas, blocos de %d) ===\n\n", rows, BATCH_BLOCK);
+    printf("%-8s | %21s | %20s | %15s | %8s\n", "fórmula",
+           "árvore por linha", "bytecode por linha", "lote", "ganho");
+
+    for (int f = 0; f < formula_count; f++) {
+        Parser parser;
+        parser.input = formulas[f];
+        parser.position = 0;
+        parser.has_error = 0;
+        ASTNode* ast = parse(&parser);
+        if (parser.has_error) {
+            printf("✗ ERRO SINTÁTICO em '%s': %s\n", formulas[f], parser.error_message);
+            continue;
+        }
+        resolve_variables(ast);
+        Bytecode* bc = compile_ast(ast);
+
+        clock_t start = clock();
+        for (long i = 0; i < rows; i++) {
+            for (int c = 0; c < 3; c++) variable_values[slots[c]] = data[c][i];
+            expected[i] = evaluate_ast(ast);
+        }
+        double tree_seconds = elapsed_seconds(start);
+
+        start = clock();
+        for (long i = 0; i < rows; i++) {
+            for (int c = 0; c < 3; c++) variable_values[slots[c]] = data[c][i];
+            out[i] = run_bytecode(bc);
+        }
+        double vm_seconds = elapsed_seconds(start);
+
+        start = clock();
+        evaluate_batch(bc, columns, var_count, rows, out);
+        double batch_seconds = elapsed_seconds(start);
+
+        int equal = memcmp(expected, out, rows * sizeof(double)) == 0;
+        printf("%-7d | %15.1f Ml/s | %15.1f Ml/s | %10.1f Ml/s | %7.2fx%s\n", f + 1,
+               rows / tree_seconds / 1e6, rows / vm_seconds / 1e6, rows / batch_seconds / 1e6,
+               tree_seconds / batch_seconds, equal ? "" : "  (RESULTADOS DIFERENTES)");
+        free_bytecode(bc);
+        free_ast(ast);
+    }
+
+    printf("\nMl/s = milhões de linhas por segundo; ganho = lote sobre a árvore por linha.\n");
+    printf("\nFórmulas:\n");
+    for (int f = 0; f < formula_count; f++) printf("  %d: %s\n", f + 1, formulas[f]);
+
+    for (int c = 0; c < 3; c++) free(data[c]);
+    free(columns);
+    free(expected);
+    free(out);
+}
+
+/*
+ * Simula o uso em produção: 'requests' avaliações escolhidas entre
+ * 'formula_count' fórmulas distintas (escritas com espaçamentos
+ * diferentes), sem cache (léxico + parser + árvore a cada pedido, como em
+ * test_expression) e com o cache, com orçamento folgado e apertado.
+ */
+void run_cache_benchmark(long requests) {
+    enum { FORMULA_COUNT = 300 };
+    static const char* const templates[] = {
+        "(x + %d) * y - z / (%d + x)",
+        "( x+%d )*y-z/( %d+x )",
+        "x * x + %d * y - (z + %d) / 2",
+        "x*x+%d*y-(z+%d)/2",
+    };
+    char (*formulas)[64] = malloc(FORMULA_COUNT * sizeof(*formulas));
+    for (int f = 0; f < FORMULA_COUNT; f++) {
+        // Pares de modelos (0,1) e (2,3) diferem só no espaçamento: mesma chave normalizada
+        snprintf(formulas[f], sizeof(*formulas), templates[f % 4], f / 2, f / 2 + 1);
+    }
+    set_variable_value("x", 5.0);
+    set_variable_value("y", 3.0);
+    set_variable_value("z", 2.0);
+
+    // Sequência de pedidos: a maioria concentrada em poucas fórmulas
+    int* sequence = malloc(requests * sizeof(int));
+    unsigned int seed = 2024;
+    for (long i = 0; i < requests; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int r = (seed >> 8) % 100;
+        seed = seed * 1103515245u + 12345u;
+        sequence[i] = r < 80 ? (int)((seed >> 8) % (FORMULA_COUNT / 10)) : (int)((seed >> 8) % FORMULA_COUNT);
+    }
+
+    printf("=== BENCHMARK: CACHE DE EXPRESSÕES (%ld pedidos, %d fórmulas) ===\n\n", requests, FORMULA_COUNT);
+
+    double plain_sum = 0.0;
+    clock_t start = clock();
+    for (long i = 0; i < requests; i++) {
+        Parser parser;
+        parser.input = formulas[sequence[i]];
+        parser.position = 0;
+        parser.has_error = 0;
+        ASTNode* ast = parse(&parser);
+        plain_sum += evaluate_ast(ast);
+        free_ast(ast);
+    }
+    double plain_seconds = elapsed_seconds(start);
+    printf("Sem cache:                 %10.0f pedidos/s\n", requests / plain_seconds);
+
+    static const size_t budgets[] = {4 * 1024 * 1024, 128 * 1024};
+    for (int b = 0; b < 2; b++) {
+        ExpressionCache cache;
+        cache_init(&cache, budgets[b]);
+        double cached_sum = 0.0;
+        int ok;
+        start = clock();
+        for (long i = 0; i < requests; i++) cached_sum += evaluate_cached(&cache, formulas[sequence[i]], &ok);
+        double cached_seconds = elapsed_seconds(start);
+
+        printf("Cache com %4zu KB:         %10.0f pedidos/s (%.1fx)%s\n  ", budgets[b] / 1024,
+               requests / cached_seconds, plain_seconds / cached_seconds,
+               cached_sum == plain_sum ? "" : "  (RESULTADOS DIFERENTES)");
+        cache_print_stats(&cache);
+        cache_free(&cache);
+    }
+
+    free(sequence);
+    free(formulas);
+}
+
 // ==================== DEMO ====================
 
 void test_expression(const char* expression) {
@@ -381,12 +1473,29 @@ void test_expression(const char* expression) {
     printf("✓ Análise sintática bem-sucedida!\n");
     printf("\nÁrvore Sintática Abstrata:\n");
     print_ast(ast, 0);
+
+    resolve_variables(ast);
     
     double result = evaluate_ast(ast);
     printf("\nResultado da avaliação: %.2f\n", result);
+
+    Bytecode* bc = compile_ast(ast);
+    printf("\nBytecode:\n");
+    print_bytecode(bc);
+    double vm_result = run_bytecode(bc);
+    printf("Resultado da máquina virtual: %.2f%s\n", vm_result,
+           vm_result == result ? "" : " (DIFERENTE da avaliação pela árvore!)");
+
+    JitCode* jit = jit_compile(bc);
+    if (jit) {
+        double jit_result = run_jit(jit);
+        printf("Resultado do JIT (%zu bytes de código e constantes): %.2f%s\n", jit->size, jit_result,
+               jit_result == result ? "" : " (DIFERENTE da avaliação pela árvore!)");
+        free_jit(jit);
+    }
+    free_bytecode(bc);
     
-    // Libera memória (simplificado)
-    // Em um programa real, implementaríamos free_ast(ast);
+    free_ast(ast);
 }
 
 void demonstrate_precedence() {
@@ -423,7 +1532,37 @@ void demonstrate_error_handling() {
     test_expression("+ 2 3");          // Operador no início
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        long iterations = argc > 2 ? atol(argv[2]) : 2000000;
+        if (iterations < 1) {
+            printf("Uso: %s --benchmark [N]\n", argv[0]);
+            return 1;
+        }
+        run_benchmark(iterations);
+        return 0;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "--cache") == 0) {
+        long requests = argc > 2 ? atol(argv[2]) : 1000000;
+        if (requests < 1) {
+            printf("Uso: %s --cache [PEDIDOS]\n", argv[0]);
+            return 1;
+        }
+        run_cache_benchmark(requests);
+        return 0;
+    }
+
+    if (argc > 1 && strcmp(argv[1], "--lote") == 0) {
+        long rows = argc > 2 ? atol(argv[2]) : 4000000;
+        if (rows < 1) {
+            printf("Uso: %s --lote [LINHAS]\n", argv[0]);
+            return 1;
+        }
+        run_batch_benchmark(rows);
+        return 0;
+    }
+
     printf("=== ANALISADOR SINTÁTICO PARA EXPRESSÕES ARITMÉTICAS ===\n");
     printf("Este programa demonstra um parser descendente recursivo que\n");
     printf("reconhece e avalia expressões aritméticas com precedência correta.\n");
@@ -454,7 +1593,9 @@ int main() {
     printf("• Precedência: * e / têm precedência maior que + e -\n");
     printf("• Associatividade: Operadores são associativos à esquerda\n");
     printf("• Parênteses: Suportados para alterar precedência\n");
-    printf("• Variáveis: Suportadas com tabela de símbolos simples\n");
+    printf("• Variáveis: resolvidas para slots antes da avaliação (sem limite de quantidade)\n");
+    printf("• Avaliação: pela árvore, por bytecode em uma máquina de pilha ou por JIT x86-64\n");
+    printf("• Cache: fórmulas repetidas reaproveitam a forma compilada (LRU com orçamento de memória)\n");
     printf("• Tratamento de erros: Detecção e relatório de erros sintáticos\n");
     
     printf("\n=== APLICAÇÕES ===\n");
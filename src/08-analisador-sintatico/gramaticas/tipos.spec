@@ -0,0 +1,45 @@
+# Regras de tipos dos operadores binários (ver semantico.c)
+#
+# tiposgen expande estas regras em uma tabela densa
+#
+#     tipo_resultado = type_rules[operador][esquerdo][direito]
+#
+# de modo que conferir uma operação é uma única leitura da tabela. Cada
+# célula diz também para qual tipo os dois operandos são convertidos antes
+# da operação; a análise semântica insere um nó CONVERT na AST onde o tipo
+# do operando é outro, e o gerador de código não precisa repetir a regra.
+#
+# Formato:
+#     tipos   nome...                       tipos de DataType (TYPE_<NOME>)
+#     grupo   nome = tipo...                conjunto de tipos
+#     operador... esquerdo direito -> operandos resultado
+#
+# 'esquerdo' e 'direito' são tipos ou grupos; 'operandos' é o tipo para o
+# qual os operandos são convertidos, ou '-' para mantê-los como estão. A
+# primeira regra que cobre uma combinação vale; combinações sem regra são
+# erros de tipo.
+
+tipos int float char
+
+grupo numerico = int float char
+grupo inteiro  = int char
+
+# Aritmética: char vira int; com um float, tudo vira float
++ - * /            float     numerico  -> float  float
++ - * /            numerico  float     -> float  float
++ - * /            numerico  numerico  -> int    int
+%                  inteiro   inteiro   -> int    int
+
+# Comparações: operandos no tipo comum, resultado int (0 ou 1)
+< > <= >= == !=    float     numerico  -> float  int
+< > <= >= == !=    numerico  float     -> float  int
+< > <= >= == !=    numerico  numerico  -> int    int
+
+# Operadores lógicos só testam se o operando é zero: nada a converter
+&& ||              numerico  numerico  -> -      int
+
+# Atribuição (e inicialização, retorno e passagem de argumento, que
+# convertem "como por atribuição"): o valor vai para o tipo do destino
+=                  int       numerico  -> int    int
+=                  float     numerico  -> float  float
+=                  char      numerico  -> char   char
@@ -0,0 +1,67 @@
+#ifndef GRAMATICA_H
+#define GRAMATICA_H
+
+#include "parser.h"
+
+/*
+ * Leitura de gramáticas e conjuntos FIRST/FOLLOW, compartilhados pelos
+ * geradores de tabelas (ll1gen e lalrgen).
+ *
+ * Formato do arquivo (ver gramaticas/):
+ *     nao_terminal -> alternativa {acao} | alternativa ;
+ *   - terminais são os nomes dos tokens (token_type_to_string): INT, PLUS...
+ *   - ε (ou "eps") denota a cadeia vazia
+ *   - {acao} opcional nomeia a ação semântica da alternativa (usada pelo
+ *     gerador LALR para montar a AST)
+ *   - '#' inicia um comentário até o fim da linha
+ *
+ * Símbolos são inteiros: terminais são valores de TokenType e o não
+ * terminal n é representado por GRAMMAR_TERMINALS + n.
+ */
+
+#define GRAMMAR_TERMINALS (TOKEN_ERROR + 1)
+#define GRAMMAR_MAX_NONTERMINALS 256
+#define GRAMMAR_MAX_NAME 64
+
+// Conjunto de terminais; o bit GRAMMAR_TERMINALS fica livre para uso dos geradores
+typedef uint64_t TerminalSet;
+
+typedef struct {
+    int lhs;      // índice do não terminal
+    int* rhs;
+    int length;
+    int line;
+    char action[GRAMMAR_MAX_NAME];  // vazio se a alternativa não tiver ação
+} Production;
+
+typedef struct {
+    char names[GRAMMAR_MAX_NONTERMINALS][GRAMMAR_MAX_NAME];
+    int defined[GRAMMAR_MAX_NONTERMINALS];   // linha da primeira regra (0 = só usado)
+    int first_use[GRAMMAR_MAX_NONTERMINALS];
+    int nonterminal_count;
+
+    Production* productions;
+    int production_count;
+    int production_capacity;
+
+    TerminalSet first[GRAMMAR_MAX_NONTERMINALS];
+    TerminalSet follow[GRAMMAR_MAX_NONTERMINALS];
+    int nullable[GRAMMAR_MAX_NONTERMINALS];
+} Grammar;
+
+Grammar* grammar_load(const char* filename);
+void grammar_free(Grammar* grammar);
+int grammar_nonterminal(Grammar* grammar, const char* name, int line);
+void grammar_add_production(Grammar* grammar, int lhs, const int* rhs, int length, int line,
+                            const char* action);
+
+void grammar_compute_first(Grammar* grammar);
+void grammar_compute_follow(Grammar* grammar);
+TerminalSet grammar_first_of(const Grammar* grammar, const int* symbols, int length, int* nullable);
+
+const char* grammar_symbol_name(const Grammar* grammar, int symbol);
+void grammar_print_production(const Grammar* grammar, int index, FILE* out);
+void grammar_print_set(TerminalSet set, FILE* out);
+void grammar_print_sets(const Grammar* grammar);
+
+#endif // GRAMATICA_H
@@ -0,0 +1,542 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stdint.h>
+
+/*
+ * Versão modular do analisador sintático de exemploCompleto.c.
+ *
+ * A gramática é a mesma do exemplo completo; as diferenças são de
+ * engenharia, para que o parser possa ser reutilizado por outras fases:
+ * - nós da AST alocados em uma arena (liberação em bloco, sem free por nó)
+ * - número ilimitado de filhos por nó e de tokens por arquivo
+ * - declarações locais e lista de parâmetros reconhecidas
+ * - recuperação de erros que sempre consome ao menos um token
+ */
+
+#define MAX_TOKEN_LENGTH 100
+
+// Tipos de tokens
+typedef enum {
+    // Literais
+    TOKEN_NUMBER,
+    TOKEN_IDENTIFIER,
+    TOKEN_STRING,
+
+    // Palavras-chave
+    TOKEN_INT,
+    TOKEN_FLOAT,
+    TOKEN_CHAR,
+    TOKEN_IF,
+    TOKEN_ELSE,
+    TOKEN_WHILE,
+    TOKEN_RETURN,
+
+    // Operadores
+    TOKEN_ASSIGN,       // =
+    TOKEN_PLUS,         // +
+    TOKEN_MINUS,        // -
+    TOKEN_MULTIPLY,     // *
+    TOKEN_DIVIDE,       // /
+    TOKEN_MODULO,       // %
+    TOKEN_EQ,           // ==
+    TOKEN_NE,           // !=
+    TOKEN_LT,           // <
+    TOKEN_LE,           // <=
+    TOKEN_GT,           // >
+    TOKEN_GE,           // >=
+    TOKEN_AND,          // &&
+    TOKEN_OR,           // ||
+    TOKEN_NOT,          // !
+
+    // Delimitadores
+    TOKEN_SEMICOLON,    // ;
+    TOKEN_COMMA,        // ,
+    TOKEN_LPAREN,       // (
+    TOKEN_RPAREN,       // )
+    TOKEN_LBRACE,       // {
+    TOKEN_RBRACE,       // }
+
+    TOKEN_EOF,
+    TOKEN_ERROR
+} TokenType;
+
+// Estrutura do token
+typedef struct {
+    TokenType type;
+    char lexeme[MAX_TOKEN_LENGTH];
+    int line;
+    int column;
+    int position;   // deslocamento em bytes do início do token na entrada
+    int length;     // tamanho do token em bytes
+} Token;
+
+// Tipos de nós da AST
+typedef enum {
+    NODE_PROGRAM,
+    NODE_VAR_DECL,
+    NODE_FUNC_DECL,
+    NODE_PARAM,
+    NODE_COMPOUND_STMT,
+    NODE_IF_STMT,
+    NODE_WHILE_STMT,
+    NODE_RETURN_STMT,
+    NODE_EXPRESSION_STMT,
+    NODE_BINARY_OP,
+    NODE_UNARY_OP,
+    NODE_ASSIGN,
+    NODE_FUNC_CALL,
+    NODE_IDENTIFIER,
+    NODE_NUMBER,
+    NODE_CONVERT        // conversão implícita inserida pela análise semântica
+} NodeType;
+
+// Tipos de dados da linguagem, anotados nos nós pela análise semântica
+typedef enum {
+    TYPE_UNKNOWN,   // nó sem tipo (comandos) ou ainda não analisado
+    TYPE_INT,
+    TYPE_FLOAT,
+    TYPE_CHAR,
+    TYPE_ERROR      // expressão com erro: não gera novas mensagens acima dela
+} DataType;
+
+// Estrutura de nó da AST
+typedef struct ASTNode {
+    NodeType type;
+    char* value;
+    struct ASTNode* left;
+    struct ASTNode* right;
+    struct ASTNode** children;  // Para nós com múltiplos filhos
+    int child_count;
+    int child_capacity;
+    int line;
+    int src_start;  // trecho do fonte [src_start, src_end) relativo a position_base
+    int src_end;    // (-1 em nós que não registram trecho)
+    DataType data_type; // anotações da análise semântica (semantico.c)
+    int symbol_id;      // símbolo declarado ou referenciado pelo nó, ou -1
+} ASTNode;
+
+// Bloco de memória da arena
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    size_t size;
+} ArenaBlock;
+
+// Arena: alocador em blocos, liberado de uma só vez
+typedef struct {
+    ArenaBlock* head;
+    size_t bytes_used;     // bytes entregues aos chamadores
+    size_t bytes_reserved; // bytes obtidos com malloc
+    size_t node_count;
+} Arena;
+
+// Estado do lexer
+typedef struct {
+    const char* input;
+    int position;
+    int line;
+    int column;
+    int length;        // fim da região analisada (pode ser menor que a entrada)
+    int unterminated;  // 1 se um comentário ou string chegou ao fim sem fechar
+} Lexer;
+
+/*
+ * Função de reaproveitamento usada pelo parsing incremental: recebe o tipo
+ * de nó esperado e a posição do token corrente e devolve uma subárvore já
+ * analisada que começa ali (ou NULL). Em *end_position devolve o fim do
+ * trecho da subárvore, no texto atual.
+ */
+typedef ASTNode* (*ReuseFn)(void* ctx, NodeType type, int position, int* end_position);
+
+// Tabela de hash-consing de expressões (ast_dag.c)
+typedef struct {
+    ASTNode* node;
+    uint32_t hash;
+    uint32_t generation;  // entradas de gerações anteriores contam como vazias
+} HashConsEntry;
+
+typedef struct {
+    HashConsEntry* entries;
+    int capacity;         // potência de 2
+    int count;
+    uint32_t generation;
+    int shared;           // nós reaproveitados em vez de criados
+} HashCons;
+
+// Estado do parser
+typedef struct {
+    Token* tokens;
+    int token_count;
+    int current_token;
+    ASTNode* ast_root;
+    int error_count;
+    Arena* arena;
+    int report_errors;  // 0 = não imprime erros (usado pelos workers)
+    int position_base;  // src_start/src_end são gravados relativos a esta posição
+    ReuseFn reuse;      // NULL fora do modo incremental
+    void* reuse_ctx;
+    int reused_nodes;
+    HashCons* hashcons; // não NULL: expressões idênticas viram um único nó (DAG)
+} Parser;
+
+// ==================== LEXER (lexer.c) ====================
+
+void init_lexer(Lexer* lexer, const char* input);
+Token get_next_token(Lexer* lexer);
+Token* tokenize(const char* input, int* token_count);
+const char* token_type_to_string(TokenType type);
+
+// ==================== AST (ast.c) ====================
+
+void arena_init(Arena* arena);
+void* arena_alloc(Arena* arena, size_t size);
+char* arena_strdup(Arena* arena, const char* s);
+void arena_merge(Arena* dest, Arena* src);
+void arena_free(Arena* arena);
+
+ASTNode* create_node(Arena* arena, NodeType type, const char* value);
+void add_child(Arena* arena, ASTNode* parent, ASTNode* child);
+void print_ast(ASTNode* node, int depth);
+void print_node_label(NodeType type, const char* value);
+int ast_equal(const ASTNode* a, const ASTNode* b);
+int count_nodes(const ASTNode* node);
+int shift_subtree(ASTNode* node, int offset_delta, int line_delta);
+
+// ==================== PARSER (parser.c) ====================
+
+void init_parser(Parser* parser, Token* tokens, int token_count, Arena* arena);
+ASTNode* parse_expression(Parser* parser);
+ASTNode* parse_statement(Parser* parser);
+ASTNode* parse_declaration(Parser* parser);
+ASTNode* parse_program(Parser* parser);
+
+// ==================== PARSING PARALELO (parser_paralelo.c) ====================
+
+// Intervalo de tokens [start, end) de uma declaração de nível superior
+typedef struct {
+    int start;
+    int end;
+    int terminated;  // 0 se o intervalo acabou sem ';' ou '}' de nível zero
+} DeclRange;
+
+typedef struct {
+    int declarations;   // declarações de nível superior encontradas
+    int threads_used;
+    int fallback;       // 1 se caiu no parser sequencial
+} ParallelStats;
+
+DeclRange* find_toplevel_declarations(const Token* tokens, int token_count, int* range_count);
+ASTNode* parse_program_parallel(Token* tokens, int token_count, int num_threads,
+                                Arena* arena, ParallelStats* stats);
+
+// ==================== PARSING INCREMENTAL (incremental.c) ====================
+
+/*
+ * Segmento: trecho do fonte com uma declaração de nível superior e o
+ * espaço/comentários que a precedem. Os segmentos cobrem o fonte inteiro.
+ */
+typedef struct {
+    int offset;
+    int length;
+    int start_line;
+    int start_column;
+    int newline_count;
+    ASTNode** nodes;   // normalmente 1 nó; mais de um apenas com erros
+    int node_total;
+    int subtree_nodes; // total de nós das subárvores do segmento
+    int error_count;
+} Segment;
+
+typedef struct {
+    char* source;
+    int length;
+    int capacity;
+    Segment* segments;
+    int segment_count;
+    int segment_capacity;
+    ASTNode* program;
+    Arena arena;
+    int error_count;
+} IncrementalDoc;
+
+typedef struct {
+    int tokens_relexed;
+    int segments_reparsed;
+    int nodes_created;
+    int nodes_reused;
+    int nodes_shifted;   // nós reaproveitados cuja linha precisou ser ajustada
+    int full_reparse;    // 1 se a arena foi compactada por uma análise completa
+} IncrementalStats;
+
+void incremental_init(IncrementalDoc* doc, const char* source);
+ASTNode* incremental_edit(IncrementalDoc* doc, int offset, int remove_length,
+                          const char* text, IncrementalStats* stats);
+void incremental_free(IncrementalDoc* doc);
+
+// ==================== DAG DE EXPRESSÕES (ast_dag.c) ====================
+
+void hashcons_init(HashCons* table);
+void hashcons_free(HashCons* table);
+void hashcons_clear(HashCons* table);
+ASTNode* hashcons_node(HashCons* table, Arena* arena, NodeType type, const char* value,
+                       int line, ASTNode* left, ASTNode* right);
+int count_distinct_nodes(const ASTNode* root);
+
+// ==================== PARSER LL(1) (ll1.c + ll1_gerador.c) ====================
+
+typedef struct {
+    long productions;       // produções aplicadas (derivação mais à esquerda)
+    int max_stack_depth;
+    size_t stack_bytes;     // memória reservada para a pilha
+    int tokens_consumed;
+} LL1Stats;
+
+int ll1_parse(const Token* tokens, int token_count, int report_errors, LL1Stats* stats);
+size_t ll1_table_bytes(void);
+
+// ==================== PARSER LALR(1) (lalr.c + lalr_gerador.c) ====================
+
+typedef struct {
+    long shifts;
+    long reductions;        // derivação mais à direita, em ordem inversa
+    int max_stack_depth;
+    size_t stack_bytes;     // memória reservada para as pilhas de estados e valores
+    int tokens_consumed;
+} LALRStats;
+
+ASTNode* lalr_parse(const Token* tokens, int token_count, Arena* arena, int report_errors, LALRStats* stats);
+size_t lalr_table_bytes(void);
+
+// ==================== ANÁLISE SEMÂNTICA (semantico.c) ====================
+
+typedef enum {
+    SYMBOL_VARIABLE,
+    SYMBOL_PARAMETER,
+    SYMBOL_FUNCTION
+} SymbolKind;
+
+// Entrada da tabela de símbolos; o índice no vetor é o ID anotado nos nós
+typedef struct {
+    const char* name;   // texto do nó de declaração (vive na arena da AST)
+    DataType type;      // tipo da variável ou tipo de retorno da função
+    SymbolKind kind;
+    int scope;          // profundidade do bloco da declaração (0 = global)
+    int line;
+    ASTNode* decl;      // VAR_DECL, PARAM ou FUNC_DECL (parâmetros = filhos)
+} Symbol;
+
+/*
+ * Tabela de símbolos com escopos aninhados, como a de
+ * 09-analisador-semantico: um hash aberto leva do nome ao símbolo visível
+ * e um log de desfazer restaura os nomes escondidos ao fechar cada escopo.
+ */
+typedef struct {
+    unsigned int hash;
+    int first_symbol;   // símbolo que guarda o texto do nome
+    int visible;        // símbolo visível agora, ou -1
+} NameEntry;
+
+typedef struct {
+    int name;           // índice em names
+    int previous;       // símbolo visível antes da declaração
+} UndoEntry;
+
+typedef struct {
+    Symbol* symbols;
+    int symbol_count;
+    int symbol_capacity;
+
+    NameEntry* names;
+    int name_count;
+    int name_capacity;
+
+    int* slots;         // índices em names; -1 = vazio
+    int slot_capacity;  // potência de 2
+
+    UndoEntry* undo;
+    int undo_count;
+    int undo_capacity;
+
+    int* scope_marks;   // tamanho do log na entrada de cada escopo
+    int scope_depth;
+    int scope_capacity;
+} SymbolTable;
+
+// Erro guardado para impressão posterior (análise paralela)
+typedef struct {
+    int declaration;    // índice da declaração de nível superior
+    int line;
+    char* message;
+} SemanticError;
+
+// Nome global lido por um corpo de função (com record_uses)
+typedef struct {
+    const char* name;   // texto do nó que usa o nome
+    int symbol;         // símbolo encontrado, ou -1
+} SemanticUse;
+
+typedef struct SemanticAnalyzer {
+    SymbolTable table;
+    int error_count;
+    int report_errors;      // 1 = imprime na hora; 0 = guarda em errors
+    SemanticError* errors;
+    int error_capacity;
+    int current_function;   // símbolo da função em análise, ou -1
+    int declaration;        // declaração de nível superior em análise
+    const struct SemanticAnalyzer* globals; // tabela global (workers), ou NULL
+    Arena* arena;           // nós CONVERT; NULL = só confere os tipos
+    ASTNode* spare_converts; // CONVERTs desfeitos nesta análise, para reúso
+    SemanticUse* uses;      // nomes globais lidos (análise incremental)
+    int use_count;
+    int use_capacity;
+    int record_uses;
+} SemanticAnalyzer;
+
+void semantic_init(SemanticAnalyzer* sema);
+void semantic_free(SemanticAnalyzer* sema);
+void semantic_clear_errors(SemanticAnalyzer* sema);
+int semantic_analyze(SemanticAnalyzer* sema, ASTNode* program);
+void semantic_check_declaration(SemanticAnalyzer* sema, ASTNode* node, int index);
+int semantic_declare_function(SemanticAnalyzer* sema, ASTNode* node);
+void semantic_check_function_body(SemanticAnalyzer* sema, ASTNode* node);
+void semantic_reserve_symbols(SemanticAnalyzer* sema, int count);
+void semantic_close_globals(SemanticAnalyzer* sema);
+int semantic_count_locals(const ASTNode* function);
+int semantic_lookup_global(const SemanticAnalyzer* sema, const char* name, int function);
+const char* data_type_to_string(DataType type);
+DataType type_from_name(const char* name);
+void print_annotated_ast(const SemanticAnalyzer* sema, const ASTNode* node, int depth);
+void print_symbols(const SemanticAnalyzer* sema);
+
+// ==================== ANÁLISE SEMÂNTICA PARALELA (semantico_paralelo.c) ====================
+
+typedef struct {
+    int functions;      // corpos analisados na fase paralela
+    int threads_used;
+    int steals;         // tarefas roubadas da fila de outro worker
+} SemanticParallelStats;
+
+int semantic_analyze_parallel(SemanticAnalyzer* sema, ASTNode* program, int num_threads,
+                              SemanticParallelStats* stats);
+
+// ==================== ANÁLISE SEMÂNTICA INCREMENTAL (semantico_incremental.c) ====================
+
+// Nome global lido por um corpo e o que ele designava na última análise
+typedef struct {
+    const char* name;   // texto de um nó do próprio corpo
+    int symbol;         // ID na última análise, ou -1 (nome não declarado)
+    uint8_t kind;       // SymbolKind e tipo do símbolo
+    uint8_t type;
+    const ASTNode* decl;  // declaração: a mesma = a mesma assinatura
+    int param_count;    // funções: parâmetros, com os tipos em param_types
+    int first_param;
+} SemanticDependency;
+
+// Resultado guardado da análise do corpo de uma função
+typedef struct {
+    const ASTNode* function;    // nó FUNC_DECL: o mesmo ponteiro = o mesmo texto
+    int line;
+    int symbol;                 // ID da função na última análise
+    int locals;                 // IDs reservados para o corpo
+    SemanticDependency* dependencies;
+    int dependency_count;
+    uint8_t* param_types;
+    SemanticError* errors;      // mensagens do corpo, na ordem
+    int error_count;
+} FunctionCache;
+
+typedef struct {
+    SemanticAnalyzer sema;      // resultado da última atualização (erros guardados)
+    FunctionCache* functions;
+    int function_count;
+} SemanticSession;
+
+typedef struct {
+    int functions;
+    int rechecked;      // corpos analisados de novo
+    int reused;         // corpos com anotações, símbolos e erros aproveitados
+    int remapped;       // aproveitados cujos IDs mudaram (uma visita ao corpo)
+    int dependencies;   // dependências conferidas nos corpos aproveitados
+} SemanticIncrementalStats;
+
+void semantic_session_init(SemanticSession* session, Arena* arena);
+int semantic_session_update(SemanticSession* session, ASTNode* program, int invalidate,
+                            SemanticIncrementalStats* stats);
+void semantic_session_free(SemanticSession* session);
+
+// ==================== AST BINÁRIA (ast_binario.c) ====================
+
+/*
+ * Formato binário da AST, pensado para ser mapeado com mmap e usado sem
+ * reconstruir os nós:
+ *
+ *   [cabeçalho][nós: ASTRecord x node_count][filhos: uint32 x child_total]
+ *   [strings: tabela de strings terminadas em '\0', sem repetição]
+ *
+ * Referências entre nós são índices no vetor de nós (-1 = ausente). Os
+ * números são gravados na ordem de bytes da máquina; byte_order permite
+ * rejeitar arquivos gerados em uma máquina com ordem diferente.
+ *
+ * Versão 2: cada nó leva também as anotações da análise semântica
+ * (data_type e symbol_id), de modo que uma AST analisada pode ser gravada
+ * e lida por uma etapa seguinte sem refazer a análise.
+ */
+#define AST_BINARY_MAGIC "ASTB"
+#define AST_BINARY_VERSION 2
+#define AST_BINARY_BYTE_ORDER 0x01020304u
+
+typedef struct {
+    char magic[4];
+    uint32_t byte_order;
+    uint32_t version;
+    uint32_t node_count;
+    uint32_t child_total;     // entradas da seção de filhos
+    uint32_t string_bytes;
+    uint32_t root;
+    uint32_t nodes_offset;    // deslocamentos das seções a partir do início
+    uint32_t children_offset;
+    uint32_t strings_offset;
+} ASTFileHeader;
+
+typedef struct {
+    uint32_t type;
+    int32_t value;        // deslocamento na tabela de strings (-1 = sem valor)
+    int32_t left;
+    int32_t right;
+    uint32_t first_child; // índice na seção de filhos
+    uint32_t child_count;
+    int32_t line;
+    int32_t src_start;
+    int32_t src_end;
+    int32_t data_type;    // DataType (TYPE_UNKNOWN em AST não analisada)
+    int32_t symbol_id;    // símbolo do nó, ou -1
+} ASTRecord;
+
+// Arquivo mapeado em memória: os ponteiros apontam para dentro do mapeamento
+typedef struct {
+    void* base;
+    size_t size;
+    const ASTFileHeader* header;
+    const ASTRecord* nodes;
+    const uint32_t* children;
+    const char* strings;
+} ASTView;
+
+int ast_write_binary(const char* filename, const ASTNode* root, size_t* bytes_written);
+int ast_view_open(ASTView* view, const char* filename);
+int ast_view_validate(const ASTView* view);
+void ast_view_close(ASTView* view);
+const ASTRecord* ast_view_node(const ASTView* view, int32_t index);
+const ASTRecord* ast_view_child(const ASTView* view, const ASTRecord* record, uint32_t i);
+const char* ast_view_value(const ASTView* view, const ASTRecord* record);
+int ast_view_annotated(const ASTView* view);
+void ast_view_print(const ASTView* view, const ASTRecord* record, int depth);
+int ast_view_equal(const ASTView* view, const ASTRecord* record, const ASTNode* node);
+ASTNode* ast_view_load(const ASTView* view, const ASTRecord* record, Arena* arena);
+
+#endif // PARSER_H
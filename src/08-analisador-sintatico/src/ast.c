@@ -0,0 +1,201 @@
+#include "../include/parser.h"
+
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGN 16
+
+// ==================== ARENA ====================
+
+void arena_init(Arena* arena) {
+    arena->head = NULL;
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+    arena->node_count = 0;
+}
+
+// Os dados de cada bloco começam logo após o cabeçalho, já alinhados
+static size_t block_header_size(void) {
+    return (sizeof(ArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    ArenaBlock* block = arena->head;
+    if (!block || block->used + size > block->size) {
+        size_t capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+        block = malloc(block_header_size() + capacity);
+        if (!block) {
+            fprintf(stderr, "Erro: falha ao alocar bloco da arena\n");
+            exit(1);
+        }
+        block->next = arena->head;
+        block->used = 0;
+        block->size = capacity;
+        arena->head = block;
+        arena->bytes_reserved += block_header_size() + capacity;
+    }
+
+    void* ptr = (char*)block + block_header_size() + block->used;
+    block->used += size;
+    arena->bytes_used += size;
+    return ptr;
+}
+
+char* arena_strdup(Arena* arena, const char* s) {
+    size_t len = strlen(s) + 1;
+    char* copy = arena_alloc(arena, len);
+    memcpy(copy, s, len);
+    return copy;
+}
+
+/*
+ * Transfere todos os blocos de 'src' para 'dest'. Usado para juntar as
+ * arenas dos workers na arena do programa: os nós continuam nos mesmos
+ * endereços e tudo é liberado junto por arena_free(dest).
+ */
+void arena_merge(Arena* dest, Arena* src) {
+    if (!src->head) return;
+
+    ArenaBlock* last = src->head;
+    while (last->next) last = last->next;
+
+    // Os blocos de src entram depois do bloco corrente de dest, para que
+    // dest continue alocando no seu próprio bloco parcialmente usado
+    if (dest->head) {
+        last->next = dest->head->next;
+        dest->head->next = src->head;
+    } else {
+        dest->head = src->head;
+    }
+
+    dest->bytes_used += src->bytes_used;
+    dest->bytes_reserved += src->bytes_reserved;
+    dest->node_count += src->node_count;
+    arena_init(src);
+}
+
+void arena_free(Arena* arena) {
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena_init(arena);
+}
+
+// ==================== AST ====================
+
+ASTNode* create_node(Arena* arena, NodeType type, const char* value) {
+    ASTNode* node = arena_alloc(arena, sizeof(ASTNode));
+    node->type = type;
+    node->value = value ? arena_strdup(arena, value) : NULL;
+    node->left = NULL;
+    node->right = NULL;
+    node->children = NULL;
+    node->child_count = 0;
+    node->child_capacity = 0;
+    node->line = 0;
+    node->src_start = -1;
+    node->src_end = -1;
+    node->data_type = TYPE_UNKNOWN;
+    node->symbol_id = -1;
+    arena->node_count++;
+    return node;
+}
+
+void add_child(Arena* arena, ASTNode* parent, ASTNode* child) {
+    if (parent->child_count == parent->child_capacity) {
+        // A arena não tem realloc: copia para um vetor com o dobro do tamanho
+        int capacity = parent->child_capacity ? parent->child_capacity * 2 : 4;
+        ASTNode** children = arena_alloc(arena, capacity * sizeof(ASTNode*));
+        if (parent->child_count > 0) {
+            memcpy(children, parent->children, parent->child_count * sizeof(ASTNode*));
+        }
+        parent->children = children;
+        parent->child_capacity = capacity;
+    }
+    parent->children[parent->child_count++] = child;
+}
+
+// Imprime o rótulo de um nó (sem indentação nem quebra de linha), como em print_ast
+void print_node_label(NodeType type, const char* value) {
+    switch (type) {
+        case NODE_PROGRAM: printf("PROGRAM"); break;
+        case NODE_VAR_DECL: printf("VAR_DECL: %s", value); break;
+        case NODE_FUNC_DECL: printf("FUNC_DECL: %s", value); break;
+        case NODE_PARAM: printf("PARAM: %s", value); break;
+        case NODE_BINARY_OP: printf("BINARY_OP: %s", value); break;
+        case NODE_UNARY_OP: printf("UNARY_OP: %s", value); break;
+        case NODE_ASSIGN: printf("ASSIGN"); break;
+        case NODE_FUNC_CALL: printf("CALL: %s", value); break;
+        case NODE_IDENTIFIER: printf("ID: %s", value); break;
+        case NODE_NUMBER: printf("NUM: %s", value); break;
+        case NODE_CONVERT: printf("CONVERT: %s", value); break;
+        case NODE_IF_STMT: printf("IF"); break;
+        case NODE_WHILE_STMT: printf("WHILE"); break;
+        case NODE_RETURN_STMT: printf("RETURN"); break;
+        case NODE_COMPOUND_STMT: printf("COMPOUND"); break;
+        case NODE_EXPRESSION_STMT: printf("EXPR_STMT"); break;
+        default: printf("NODE_%d", type); break;
+    }
+}
+
+void print_ast(ASTNode* node, int depth) {
+    if (!node) return;
+
+    for (int i = 0; i < depth; i++) printf("  ");
+    print_node_label(node->type, node->value);
+    printf("\n");
+
+    if (node->left) print_ast(node->left, depth + 1);
+    if (node->right) print_ast(node->right, depth + 1);
+    for (int i = 0; i < node->child_count; i++) {
+        print_ast(node->children[i], depth + 1);
+    }
+}
+
+// Igualdade estrutural: mesmo tipo, valor, linha e filhos na mesma ordem. Os
+// nós CONVERT da análise semântica não são sintaxe e ficam de fora
+int ast_equal(const ASTNode* a, const ASTNode* b) {
+    while (a && a->type == NODE_CONVERT) a = a->left;
+    while (b && b->type == NODE_CONVERT) b = b->left;
+    if (a == b) return 1;
+    if (!a || !b) return 0;
+    if (a->type != b->type || a->line != b->line || a->child_count != b->child_count) return 0;
+    if ((a->value == NULL) != (b->value == NULL)) return 0;
+    if (a->value && strcmp(a->value, b->value) != 0) return 0;
+    if (!ast_equal(a->left, b->left) || !ast_equal(a->right, b->right)) return 0;
+    for (int i = 0; i < a->child_count; i++) {
+        if (!ast_equal(a->children[i], b->children[i])) return 0;
+    }
+    return 1;
+}
+
+int count_nodes(const ASTNode* node) {
+    if (!node) return 0;
+    int total = 1 + count_nodes(node->left) + count_nodes(node->right);
+    for (int i = 0; i < node->child_count; i++) {
+        total += count_nodes(node->children[i]);
+    }
+    return total;
+}
+
+/*
+ * Desloca os trechos do fonte e as linhas de uma subárvore reaproveitada.
+ * Retorna o número de nós visitados.
+ */
+int shift_subtree(ASTNode* node, int offset_delta, int line_delta) {
+    if (!node) return 0;
+    node->line += line_delta;
+    if (node->src_start >= 0) {
+        node->src_start += offset_delta;
+        node->src_end += offset_delta;
+    }
+    int total = 1 + shift_subtree(node->left, offset_delta, line_delta)
+                  + shift_subtree(node->right, offset_delta, line_delta);
+    for (int i = 0; i < node->child_count; i++) {
+        total += shift_subtree(node->children[i], offset_delta, line_delta);
+    }
+    return total;
+}
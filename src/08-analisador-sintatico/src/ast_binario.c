@@ -0,0 +1,403 @@
+/*
+ * Serialização binária da AST
+ *
+ * print_ast só serve para leitura humana: para que a análise semântica e a
+ * geração de código possam rodar em processos separados (e reaproveitar
+ * unidades já analisadas), a AST é gravada em um formato binário compacto
+ * descrito em parser.h.
+ *
+ * A leitura não reconstrói os nós: o arquivo é mapeado com mmap e as fases
+ * seguintes percorrem diretamente o vetor de ASTRecord, seguindo índices.
+ * Abrir um arquivo custa O(1) — apenas o cabeçalho é conferido; quem recebe
+ * arquivos de origem desconhecida deve chamar ast_view_validate.
+ *
+ * Na gravação, os nós são numerados em pré-ordem e os filhos de cada nó
+ * ocupam posições contíguas na seção de filhos. Valores repetidos (o mesmo
+ * identificador usado muitas vezes) são gravados uma só vez na tabela de
+ * strings. As anotações da análise semântica (tipo e símbolo) vão junto;
+ * os nós CONVERT inseridos por ela são gravados como os demais.
+ *
+ * Quem só lê (impressão, comparação, geração de código) percorre o
+ * mapeamento. A análise semântica modifica a árvore (insere conversões),
+ * então ast_view_load reconstrói os nós em uma arena para ela.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/parser.h"
+
+// Seções começam em múltiplos de 8 bytes
+#define SECTION_ALIGN 8
+
+// Tabela de strings com eliminação de repetições (hash com endereçamento aberto)
+typedef struct {
+    char* data;
+    uint32_t size;
+    uint32_t capacity;
+    int32_t* slots;      // deslocamento da string em data, ou -1
+    uint32_t slot_count; // potência de 2
+    uint32_t used;
+} StringTable;
+
+typedef struct {
+    ASTRecord* nodes;
+    uint32_t node_count;
+    uint32_t* children;
+    uint32_t child_total;
+    StringTable strings;
+} Writer;
+
+// ==================== GRAVAÇÃO ====================
+
+static uint32_t hash_string(const char* s) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    while (*s) {
+        hash ^= (unsigned char)*s++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void string_table_init(StringTable* table) {
+    table->capacity = 1024;
+    table->data = malloc(table->capacity);
+    table->size = 0;
+    table->slot_count = 256;
+    table->slots = malloc(table->slot_count * sizeof(int32_t));
+    memset(table->slots, 0xff, table->slot_count * sizeof(int32_t));
+    table->used = 0;
+}
+
+static void string_table_free(StringTable* table) {
+    free(table->data);
+    free(table->slots);
+}
+
+static void string_table_grow_slots(StringTable* table) {
+    uint32_t old_count = table->slot_count;
+    int32_t* old_slots = table->slots;
+
+    table->slot_count *= 2;
+    table->slots = malloc(table->slot_count * sizeof(int32_t));
+    memset(table->slots, 0xff, table->slot_count * sizeof(int32_t));
+
+    for (uint32_t i = 0; i < old_count; i++) {
+        if (old_slots[i] < 0) continue;
+        uint32_t slot = hash_string(table->data + old_slots[i]) & (table->slot_count - 1);
+        while (table->slots[slot] >= 0) slot = (slot + 1) & (table->slot_count - 1);
+        table->slots[slot] = old_slots[i];
+    }
+    free(old_slots);
+}
+
+static int32_t string_table_add(StringTable* table, const char* s) {
+    if (!s) return -1;
+
+    uint32_t slot = hash_string(s) & (table->slot_count - 1);
+    while (table->slots[slot] >= 0) {
+        if (strcmp(table->data + table->slots[slot], s) == 0) return table->slots[slot];
+        slot = (slot + 1) & (table->slot_count - 1);
+    }
+
+    uint32_t length = strlen(s) + 1;
+    while (table->size + length > table->capacity) {
+        table->capacity *= 2;
+        table->data = realloc(table->data, table->capacity);
+    }
+    int32_t offset = table->size;
+    memcpy(table->data + offset, s, length);
+    table->size += length;
+
+    table->slots[slot] = offset;
+    if (++table->used * 2 > table->slot_count) string_table_grow_slots(table);
+    return offset;
+}
+
+// Numera os nós em pré-ordem e preenche os registros; retorna o índice do nó
+static int32_t write_node(Writer* writer, const ASTNode* node) {
+    if (!node) return -1;
+
+    uint32_t index = writer->node_count++;
+    uint32_t first_child = writer->child_total;
+    writer->child_total += node->child_count;
+
+    ASTRecord record;
+    record.type = node->type;
+    record.value = string_table_add(&writer->strings, node->value);
+    record.first_child = first_child;
+    record.child_count = node->child_count;
+    record.line = node->line;
+    record.src_start = node->src_start;
+    record.src_end = node->src_end;
+    record.data_type = node->data_type;
+    record.symbol_id = node->symbol_id;
+    record.left = write_node(writer, node->left);
+    record.right = write_node(writer, node->right);
+    for (int i = 0; i < node->child_count; i++) {
+        writer->children[first_child + i] = write_node(writer, node->children[i]);
+    }
+
+    writer->nodes[index] = record;
+    return index;
+}
+
+static uint32_t align_section(uint32_t offset) {
+    return (offset + SECTION_ALIGN - 1) & ~(uint32_t)(SECTION_ALIGN - 1);
+}
+
+static int count_children(const ASTNode* node) {
+    if (!node) return 0;
+    int total = node->child_count + count_children(node->left) + count_children(node->right);
+    for (int i = 0; i < node->child_count; i++) {
+        total += count_children(node->children[i]);
+    }
+    return total;
+}
+
+static int write_padding(FILE* file, uint32_t from, uint32_t to) {
+    static const char zeros[SECTION_ALIGN] = {0};
+    return to == from || fwrite(zeros, 1, to - from, file) == to - from;
+}
+
+/*
+ * Grava a AST em 'filename'. Retorna 0 em caso de sucesso e -1 em caso de
+ * erro (com mensagem em stderr).
+ */
+int ast_write_binary(const char* filename, const ASTNode* root, size_t* bytes_written) {
+    Writer writer;
+    uint32_t node_total = count_nodes(root);
+    writer.nodes = malloc((node_total ? node_total : 1) * sizeof(ASTRecord));
+    writer.children = malloc((count_children(root) + 1) * sizeof(uint32_t));
+    writer.node_count = 0;
+    writer.child_total = 0;
+    string_table_init(&writer.strings);
+
+    int32_t root_index = write_node(&writer, root);
+
+    ASTFileHeader header;
+    memcpy(header.magic, AST_BINARY_MAGIC, 4);
+    header.byte_order = AST_BINARY_BYTE_ORDER;
+    header.version = AST_BINARY_VERSION;
+    header.node_count = writer.node_count;
+    header.child_total = writer.child_total;
+    header.string_bytes = writer.strings.size;
+    header.root = root_index < 0 ? UINT32_MAX : (uint32_t)root_index;
+    header.nodes_offset = align_section(sizeof(ASTFileHeader));
+    header.children_offset = align_section(header.nodes_offset + writer.node_count * sizeof(ASTRecord));
+    header.strings_offset = align_section(header.children_offset + writer.child_total * sizeof(uint32_t));
+
+    int result = -1;
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        fprintf(stderr, "Erro: não foi possível criar o arquivo '%s'\n", filename);
+    } else {
+        uint32_t nodes_end = header.nodes_offset + writer.node_count * sizeof(ASTRecord);
+        uint32_t children_end = header.children_offset + writer.child_total * sizeof(uint32_t);
+        int ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 write_padding(file, sizeof(header), header.nodes_offset) &&
+                 fwrite(writer.nodes, sizeof(ASTRecord), writer.node_count, file) == writer.node_count &&
+                 write_padding(file, nodes_end, header.children_offset) &&
+                 fwrite(writer.children, sizeof(uint32_t), writer.child_total, file) == writer.child_total &&
+                 write_padding(file, children_end, header.strings_offset) &&
+                 fwrite(writer.strings.data, 1, writer.strings.size, file) == writer.strings.size;
+        if (fclose(file) != 0) ok = 0;
+
+        if (ok) {
+            result = 0;
+            if (bytes_written) *bytes_written = header.strings_offset + writer.strings.size;
+        } else {
+            fprintf(stderr, "Erro: falha ao gravar o arquivo '%s'\n", filename);
+        }
+    }
+
+    string_table_free(&writer.strings);
+    free(writer.children);
+    free(writer.nodes);
+    return result;
+}
+
+// ==================== LEITURA ====================
+
+/*
+ * Mapeia o arquivo e confere o cabeçalho e o tamanho das seções.
+ * Retorna 0 em caso de sucesso e -1 em caso de erro.
+ */
+int ast_view_open(ASTView* view, const char* filename) {
+    memset(view, 0, sizeof(*view));
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", filename);
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ASTFileHeader)) {
+        fprintf(stderr, "Erro: '%s' não é uma AST binária\n", filename);
+        close(fd);
+        return -1;
+    }
+
+    void* base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Erro: falha ao mapear o arquivo '%s'\n", filename);
+        return -1;
+    }
+
+    const ASTFileHeader* header = base;
+    const char* problem = NULL;
+    if (memcmp(header->magic, AST_BINARY_MAGIC, 4) != 0) {
+        problem = "não é uma AST binária";
+    } else if (header->byte_order != AST_BINARY_BYTE_ORDER) {
+        problem = "gerado em uma máquina com outra ordem de bytes";
+    } else if (header->version != AST_BINARY_VERSION) {
+        problem = "versão do formato não suportada";
+    } else if (header->nodes_offset % SECTION_ALIGN || header->children_offset % SECTION_ALIGN ||
+               (uint64_t)header->nodes_offset + (uint64_t)header->node_count * sizeof(ASTRecord)
+                   > header->children_offset ||
+               (uint64_t)header->children_offset + (uint64_t)header->child_total * sizeof(uint32_t)
+                   > header->strings_offset ||
+               (uint64_t)header->strings_offset + header->string_bytes > (uint64_t)st.st_size ||
+               (header->root != UINT32_MAX && header->root >= header->node_count)) {
+        problem = "arquivo truncado ou corrompido";
+    }
+
+    if (problem) {
+        fprintf(stderr, "Erro: '%s': %s\n", filename, problem);
+        munmap(base, st.st_size);
+        return -1;
+    }
+
+    view->base = base;
+    view->size = st.st_size;
+    view->header = header;
+    view->nodes = (const ASTRecord*)((const char*)base + header->nodes_offset);
+    view->children = (const uint32_t*)((const char*)base + header->children_offset);
+    view->strings = (const char*)base + header->strings_offset;
+    return 0;
+}
+
+/*
+ * Confere todas as referências (índices de nós, filhos e strings). Custa
+ * O(n); retorna 1 se o arquivo for consistente.
+ */
+int ast_view_validate(const ASTView* view) {
+    const ASTFileHeader* header = view->header;
+
+    // A tabela de strings precisa terminar em '\0' para que nenhuma leitura passe do fim
+    if (header->string_bytes > 0 && view->strings[header->string_bytes - 1] != '\0') return 0;
+
+    for (uint32_t i = 0; i < header->node_count; i++) {
+        const ASTRecord* record = &view->nodes[i];
+        if (record->value < -1 || (record->value >= 0 && (uint32_t)record->value >= header->string_bytes)) {
+            return 0;
+        }
+        // Pré-ordem: referências sempre apontam para nós posteriores (sem ciclos)
+        if (record->left != -1 && (record->left <= (int32_t)i || (uint32_t)record->left >= header->node_count)) {
+            return 0;
+        }
+        if (record->right != -1 && (record->right <= (int32_t)i || (uint32_t)record->right >= header->node_count)) {
+            return 0;
+        }
+        if (record->data_type < TYPE_UNKNOWN || record->data_type > TYPE_ERROR || record->symbol_id < -1) {
+            return 0;
+        }
+        if ((uint64_t)record->first_child + record->child_count > header->child_total) return 0;
+        for (uint32_t c = 0; c < record->child_count; c++) {
+            uint32_t child = view->children[record->first_child + c];
+            if (child <= i || child >= header->node_count) return 0;
+        }
+    }
+    return 1;
+}
+
+void ast_view_close(ASTView* view) {
+    if (view->base) munmap(view->base, view->size);
+    memset(view, 0, sizeof(*view));
+}
+
+// Nó pelo índice; -1 (referência ausente) devolve NULL
+const ASTRecord* ast_view_node(const ASTView* view, int32_t index) {
+    return index < 0 ? NULL : &view->nodes[index];
+}
+
+const ASTRecord* ast_view_child(const ASTView* view, const ASTRecord* record, uint32_t i) {
+    return &view->nodes[view->children[record->first_child + i]];
+}
+
+const char* ast_view_value(const ASTView* view, const ASTRecord* record) {
+    return record->value < 0 ? NULL : view->strings + record->value;
+}
+
+// 1 se algum nó tem anotação semântica (a AST foi gravada depois da análise)
+int ast_view_annotated(const ASTView* view) {
+    for (uint32_t i = 0; i < view->header->node_count; i++) {
+        if (view->nodes[i].data_type != TYPE_UNKNOWN || view->nodes[i].symbol_id >= 0) return 1;
+    }
+    return 0;
+}
+
+// Como print_ast; as anotações aparecem como em print_annotated_ast, sem a linha do símbolo
+void ast_view_print(const ASTView* view, const ASTRecord* record, int depth) {
+    if (!record) return;
+
+    for (int i = 0; i < depth; i++) printf("  ");
+    print_node_label(record->type, ast_view_value(view, record));
+    if (record->data_type != TYPE_UNKNOWN) printf("  : %s", data_type_to_string(record->data_type));
+    if (record->symbol_id >= 0) printf("  -> #%d", record->symbol_id);
+    printf("\n");
+
+    ast_view_print(view, ast_view_node(view, record->left), depth + 1);
+    ast_view_print(view, ast_view_node(view, record->right), depth + 1);
+    for (uint32_t i = 0; i < record->child_count; i++) {
+        ast_view_print(view, ast_view_child(view, record, i), depth + 1);
+    }
+}
+
+// Mesmo critério de ast_equal, comparando o arquivo com uma AST em memória
+int ast_view_equal(const ASTView* view, const ASTRecord* record, const ASTNode* node) {
+    if (!record || !node) return !record && !node;
+    if (record->type != (uint32_t)node->type || record->line != node->line ||
+        record->child_count != (uint32_t)node->child_count ||
+        record->data_type != (int32_t)node->data_type || record->symbol_id != node->symbol_id) {
+        return 0;
+    }
+
+    const char* value = ast_view_value(view, record);
+    if ((value == NULL) != (node->value == NULL)) return 0;
+    if (value && strcmp(value, node->value) != 0) return 0;
+
+    if (!ast_view_equal(view, ast_view_node(view, record->left), node->left) ||
+        !ast_view_equal(view, ast_view_node(view, record->right), node->right)) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < record->child_count; i++) {
+        if (!ast_view_equal(view, ast_view_child(view, record, i), node->children[i])) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Reconstrói a subárvore de 'record' em nós da arena, com trechos do fonte
+ * e anotações. Usada pelas etapas que modificam a árvore.
+ */
+ASTNode* ast_view_load(const ASTView* view, const ASTRecord* record, Arena* arena) {
+    if (!record) return NULL;
+
+    ASTNode* node = create_node(arena, (NodeType)record->type, ast_view_value(view, record));
+    node->line = record->line;
+    node->src_start = record->src_start;
+    node->src_end = record->src_end;
+    node->data_type = (DataType)record->data_type;
+    node->symbol_id = record->symbol_id;
+    node->left = ast_view_load(view, ast_view_node(view, record->left), arena);
+    node->right = ast_view_load(view, ast_view_node(view, record->right), arena);
+    for (uint32_t i = 0; i < record->child_count; i++) {
+        add_child(arena, node, ast_view_load(view, ast_view_child(view, record, i), arena));
+    }
+    return node;
+}
@@ -0,0 +1,174 @@
+/*
+ * Hash-consing de expressões: AST como DAG
+ *
+ * Sem hash-consing, cada ocorrência de "n - 1" vira três nós novos. Com a
+ * tabela ativa (parser->hashcons), antes de criar um nó de expressão o
+ * parser procura um nó já existente com o mesmo tipo, o mesmo valor
+ * (operador, identificador ou número) e os MESMOS filhos — comparados por
+ * endereço, já que os filhos também passaram pela tabela. Se existir, o nó
+ * é compartilhado e a árvore vira um grafo acíclico dirigido (DAG):
+ *
+ *     (n - 1) * (n - 1)          *
+ *                               / \
+ *                               \ /
+ *                                -
+ *                               / \
+ *                              n   1
+ *
+ * Um nó compartilhado representa o mesmo VALOR apenas enquanto nenhuma
+ * variável muda. Por isso a tabela é esvaziada (de forma conservadora) a
+ * cada atribuição, declaração e chamada de função, e no início de cada
+ * função — a mesma regra de "matar" expressões da construção clássica do
+ * DAG de um bloco básico. Assim, um gerador de código que visite cada nó
+ * uma única vez obtém a eliminação de subexpressões comuns de graça.
+ *
+ * Esvaziar a tabela custa O(1): cada entrada guarda a geração em que foi
+ * inserida, e entradas de gerações antigas contam como vazias.
+ *
+ * Os nós compartilhados mantêm a linha da primeira ocorrência. Funções que
+ * percorrem a AST como árvore (print_ast, ast_equal, count_nodes) continuam
+ * funcionando; as que alteram nós (shift_subtree, usada pelo parsing
+ * incremental) não devem receber um DAG.
+ */
+
+#include "../include/parser.h"
+
+#define HASHCONS_INITIAL_CAPACITY 1024
+
+static uint32_t hash_key(NodeType type, const char* value, const ASTNode* left, const ASTNode* right) {
+    uint32_t hash = 2166136261u ^ (uint32_t)type;  // FNV-1a
+    if (value) {
+        for (const char* c = value; *c; c++) {
+            hash = (hash ^ (unsigned char)*c) * 16777619u;
+        }
+    }
+    uint64_t l = (uintptr_t)left, r = (uintptr_t)right;
+    hash = (hash ^ (uint32_t)(l ^ (l >> 32))) * 16777619u;
+    hash = (hash ^ (uint32_t)(r ^ (r >> 32))) * 16777619u;
+    return hash;
+}
+
+static int same_key(const ASTNode* node, NodeType type, const char* value,
+                    const ASTNode* left, const ASTNode* right) {
+    if (node->type != type || node->left != left || node->right != right) return 0;
+    if ((node->value == NULL) != (value == NULL)) return 0;
+    return !value || strcmp(node->value, value) == 0;
+}
+
+void hashcons_init(HashCons* table) {
+    table->capacity = HASHCONS_INITIAL_CAPACITY;
+    table->entries = calloc(table->capacity, sizeof(HashConsEntry));
+    table->count = 0;
+    table->generation = 1;
+    table->shared = 0;
+}
+
+void hashcons_free(HashCons* table) {
+    free(table->entries);
+    table->entries = NULL;
+    table->capacity = 0;
+    table->count = 0;
+}
+
+// Esquece todas as expressões (uma variável pode ter mudado de valor)
+void hashcons_clear(HashCons* table) {
+    table->generation++;
+    table->count = 0;
+}
+
+static int is_live(const HashCons* table, const HashConsEntry* entry) {
+    return entry->generation == table->generation;
+}
+
+static void hashcons_grow(HashCons* table) {
+    int old_capacity = table->capacity;
+    HashConsEntry* old_entries = table->entries;
+
+    table->capacity *= 2;
+    table->entries = calloc(table->capacity, sizeof(HashConsEntry));
+
+    for (int i = 0; i < old_capacity; i++) {
+        if (!is_live(table, &old_entries[i])) continue;
+        int slot = old_entries[i].hash & (table->capacity - 1);
+        while (is_live(table, &table->entries[slot])) slot = (slot + 1) & (table->capacity - 1);
+        table->entries[slot] = old_entries[i];
+    }
+    free(old_entries);
+}
+
+/*
+ * Devolve o nó canônico para (type, value, left, right), criando-o na
+ * arena se ainda não existir na geração corrente.
+ */
+ASTNode* hashcons_node(HashCons* table, Arena* arena, NodeType type, const char* value,
+                       int line, ASTNode* left, ASTNode* right) {
+    uint32_t hash = hash_key(type, value, left, right);
+    int slot = hash & (table->capacity - 1);
+
+    while (is_live(table, &table->entries[slot])) {
+        HashConsEntry* entry = &table->entries[slot];
+        if (entry->hash == hash && same_key(entry->node, type, value, left, right)) {
+            table->shared++;
+            return entry->node;
+        }
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+
+    ASTNode* node = create_node(arena, type, value);
+    node->line = line;
+    node->left = left;
+    node->right = right;
+
+    table->entries[slot].node = node;
+    table->entries[slot].hash = hash;
+    table->entries[slot].generation = table->generation;
+    if (++table->count * 2 > table->capacity) hashcons_grow(table);
+
+    return node;
+}
+
+// ==================== CONTAGEM ====================
+
+typedef struct {
+    const ASTNode** slots;
+    int capacity;
+    int count;
+} PointerSet;
+
+static int pointer_set_add(PointerSet* set, const ASTNode* node) {
+    if ((set->count + 1) * 2 > set->capacity) {
+        PointerSet bigger = {calloc(set->capacity * 2, sizeof(ASTNode*)), set->capacity * 2, 0};
+        for (int i = 0; i < set->capacity; i++) {
+            if (set->slots[i]) pointer_set_add(&bigger, set->slots[i]);
+        }
+        free(set->slots);
+        *set = bigger;
+    }
+
+    uintptr_t p = (uintptr_t)node;
+    int slot = (int)((p >> 4) ^ (p >> 20)) & (set->capacity - 1);
+    while (set->slots[slot]) {
+        if (set->slots[slot] == node) return 0;
+        slot = (slot + 1) & (set->capacity - 1);
+    }
+    set->slots[slot] = node;
+    set->count++;
+    return 1;
+}
+
+static void collect_distinct(PointerSet* set, const ASTNode* node) {
+    if (!node || !pointer_set_add(set, node)) return;
+    collect_distinct(set, node->left);
+    collect_distinct(set, node->right);
+    for (int i = 0; i < node->child_count; i++) {
+        collect_distinct(set, node->children[i]);
+    }
+}
+
+// Número de nós distintos (count_nodes conta um nó compartilhado várias vezes)
+int count_distinct_nodes(const ASTNode* root) {
+    PointerSet set = {calloc(HASHCONS_INITIAL_CAPACITY, sizeof(ASTNode*)), HASHCONS_INITIAL_CAPACITY, 0};
+    collect_distinct(&set, root);
+    free(set.slots);
+    return set.count;
+}
@@ -0,0 +1,529 @@
+/*
+ * Benchmark dos parsers
+ *
+ * Compara, sobre os mesmos tokens, o parser descendente recursivo
+ * (parser.c, que monta a AST) com os parsers dirigidos por tabela: LL(1)
+ * (ll1.c, que apenas reconhece) e LALR(1) (lalr.c, que monta a mesma AST
+ * do descendente; as duas árvores são comparadas). A análise léxica é
+ * feita uma única vez e fica fora das medições.
+ *
+ *     benchmark [-n REPETICOES] arquivo...
+ *
+ * Com --gerar, mede o pipeline completo (tokenize + parse) sobre um programa
+ * sintético de forma e tamanho escolhidos, e reporta tokens/s, nós/s, bytes
+ * alocados por nó e o pico de memória residente do processo:
+ *
+ *     benchmark [-n REPETICOES] --gerar FORMA TAMANHO [--profundidade D]
+ *               [--parser rd|lalr] [--salvar arquivo.txt] [--semantico T]
+ *
+ *   funcoes      TAMANHO funções pequenas
+ *   aninhamento  TAMANHO funções, cada uma com D níveis de if/while aninhados
+ *   expressoes   TAMANHO comandos, cada um com uma expressão de D operandos
+ *
+ * Com --semantico T, mede também a análise semântica do programa gerado:
+ * sequencial e paralela com 1, 2, 4... até T threads, e a incremental
+ * depois de editar uma função do meio do programa.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include <stdarg.h>
+#include <sys/resource.h>
+#include "../include/parser.h"
+
+static char* read_file(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", filename);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* content = malloc(size + 1);
+    size_t read = fread(content, 1, size, file);
+    content[read] = '\0';
+    fclose(file);
+    return content;
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef struct {
+    double seconds;     // tempo por repetição
+    size_t memory;      // bytes usados pela estrutura do parser
+    int accepted;
+} ParserResult;
+
+static ParserResult bench_recursive_descent(Token* tokens, int token_count, int repetitions, int* nodes) {
+    ParserResult result = {0, 0, 1};
+    double start = now_seconds();
+    for (int r = 0; r < repetitions; r++) {
+        Arena arena;
+        arena_init(&arena);
+        Parser parser;
+        init_parser(&parser, tokens, token_count, &arena);
+        parser.report_errors = 0;
+        ASTNode* ast = parse_program(&parser);
+        if (r == 0) {
+            *nodes = count_nodes(ast);
+            result.memory = arena.bytes_reserved;
+            result.accepted = parser.error_count == 0;
+        }
+        arena_free(&arena);
+    }
+    result.seconds = (now_seconds() - start) / repetitions;
+    return result;
+}
+
+static ParserResult bench_ll1(Token* tokens, int token_count, int repetitions) {
+    ParserResult result = {0, 0, 1};
+    LL1Stats stats;
+    double start = now_seconds();
+    for (int r = 0; r < repetitions; r++) {
+        int accepted = ll1_parse(tokens, token_count, 0, &stats);
+        if (r == 0) result.accepted = accepted;
+    }
+    result.seconds = (now_seconds() - start) / repetitions;
+    result.memory = ll1_table_bytes() + stats.stack_bytes;
+    return result;
+}
+
+// Monta a AST com o LALR(1); *equal = 1 se ela for idêntica à do descendente
+static ParserResult bench_lalr(Token* tokens, int token_count, int repetitions, int* equal) {
+    ParserResult result = {0, 0, 1};
+    LALRStats stats;
+    double start = now_seconds();
+    for (int r = 0; r < repetitions; r++) {
+        Arena arena;
+        arena_init(&arena);
+        ASTNode* ast = lalr_parse(tokens, token_count, &arena, 0, &stats);
+        if (r == 0) {
+            result.accepted = ast != NULL;
+            result.memory = arena.bytes_reserved + lalr_table_bytes() + stats.stack_bytes;
+
+            Arena rd_arena;
+            arena_init(&rd_arena);
+            Parser parser;
+            init_parser(&parser, tokens, token_count, &rd_arena);
+            parser.report_errors = 0;
+            ASTNode* rd = parse_program(&parser);
+            *equal = !ast || ast_equal(ast, rd);
+            arena_free(&rd_arena);
+        }
+        arena_free(&arena);
+    }
+    result.seconds = (now_seconds() - start) / repetitions;
+    return result;
+}
+
+// ==================== PROGRAMAS SINTÉTICOS ====================
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} Buffer;
+
+static void buffer_printf(Buffer* buffer, const char* format, ...) {
+    va_list args;
+    while (1) {
+        va_start(args, format);
+        int written = vsnprintf(buffer->data + buffer->length, buffer->capacity - buffer->length, format, args);
+        va_end(args);
+        if (buffer->length + written < buffer->capacity) {
+            buffer->length += written;
+            return;
+        }
+        buffer->capacity = buffer->capacity * 2 + written;
+        buffer->data = realloc(buffer->data, buffer->capacity);
+    }
+}
+
+// Expressão com 'operands' operandos, misturando todos os níveis de precedência
+static void generate_expression(Buffer* out, int operands, int seed) {
+    static const char* const ops[] = {"+", "*", "-", "/", "<", "==", "&&", "%", "||", ">="};
+    int open = 0;
+    for (int i = 0; i < operands; i++) {
+        if (i > 0) buffer_printf(out, " %s ", ops[(seed + i) % 10]);
+        if (i % 7 == 3 && i + 2 < operands) {
+            buffer_printf(out, "(");
+            open++;
+        }
+        if (i % 5 == 4) {
+            buffer_printf(out, "-v%d", (seed + i) % 8);
+        } else if (i % 3 == 0) {
+            buffer_printf(out, "%d", (seed * 31 + i) % 1000);
+        } else {
+            buffer_printf(out, "v%d", (seed + i) % 8);
+        }
+        if (open > 0 && i % 7 == 5) {
+            buffer_printf(out, ")");
+            open--;
+        }
+    }
+    while (open-- > 0) buffer_printf(out, ")");
+}
+
+static void generate_function_header(Buffer* out, int index) {
+    buffer_printf(out, "int f%d(int v0, int v1) {\n", index);
+    buffer_printf(out, "    int v2 = v0 + %d;\n    int v3;\n    int v4;\n    int v5;\n    int v6;\n    int v7;\n",
+                  index % 97);
+}
+
+/*
+ * Gera um programa da forma pedida. Devolve NULL se a forma não existir.
+ * O texto é determinístico: o mesmo (forma, tamanho, profundidade) dá
+ * sempre o mesmo programa.
+ */
+static char* generate_program(const char* shape, int size, int depth) {
+    Buffer out = {malloc(4096), 0, 4096};
+    out.data[0] = '\0';
+
+    if (strcmp(shape, "funcoes") == 0) {
+        for (int f = 0; f < size; f++) {
+            generate_function_header(&out, f);
+            buffer_printf(&out, "    if (v2 > %d) {\n        v2 = v2 - v1 * 2;\n    } else {\n"
+                                "        v2 = f%d(v1, v2);\n    }\n", f % 13, f > 0 ? f - 1 : 0);
+            buffer_printf(&out, "    return v2;\n}\n\n");
+        }
+    } else if (strcmp(shape, "aninhamento") == 0) {
+        for (int f = 0; f < size; f++) {
+            generate_function_header(&out, f);
+            // Indentação limitada: em aninhamentos profundos o fonte seria quase só espaços
+            for (int d = 0; d < depth; d++) {
+                int indent = d < 16 ? 4 * (d + 1) : 64;
+                buffer_printf(&out, d % 2 ? "%*swhile (v%d < %d) {\n" : "%*sif (v%d > %d) {\n",
+                              indent, "", d % 8, d);
+                buffer_printf(&out, "%*sv%d = v%d + 1;\n", indent + 4, "", (d + 1) % 8, d % 8);
+            }
+            for (int d = depth - 1; d >= 0; d--) buffer_printf(&out, "%*s}\n", d < 16 ? 4 * (d + 1) : 64, "");
+            buffer_printf(&out, "    return v2;\n}\n\n");
+        }
+    } else if (strcmp(shape, "expressoes") == 0) {
+        generate_function_header(&out, 0);
+        for (int i = 0; i < size; i++) {
+            buffer_printf(&out, "    v%d = ", i % 8);
+            generate_expression(&out, depth, i);
+            buffer_printf(&out, ";\n");
+        }
+        buffer_printf(&out, "    return v2;\n}\n");
+    } else {
+        free(out.data);
+        return NULL;
+    }
+    return out.data;
+}
+
+// Pico de memória residente do processo, em KB (ru_maxrss no Linux)
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+/*
+ * Análise semântica sobre a AST do programa gerado: a sequencial e a
+ * paralela com 1, 2, 4... até max_threads threads (sempre incluindo
+ * max_threads). A varredura para quando sobram threads sem função para
+ * analisar. Os nós são reanotados a cada repetição.
+ */
+static void bench_semantic(ASTNode* ast, int repetitions, int max_threads) {
+    int errors = 0, symbols = 0;
+    double start = now_seconds();
+    for (int r = 0; r < repetitions; r++) {
+        SemanticAnalyzer sema;
+        semantic_init(&sema);
+        sema.report_errors = 0;
+        errors = semantic_analyze(&sema, ast);
+        symbols = sema.table.symbol_count;
+        semantic_free(&sema);
+    }
+    double sequential = (now_seconds() - start) / repetitions;
+    printf("  semântica:      sequencial %.3f ms (%d símbolos, %d erros)\n", sequential * 1e3, symbols, errors);
+
+    for (int threads = 1;; threads *= 2) {
+        if (threads > max_threads) threads = max_threads;
+        SemanticParallelStats stats = {0, 0, 0};
+        long steals = 0;
+        start = now_seconds();
+        for (int r = 0; r < repetitions; r++) {
+            SemanticAnalyzer sema;
+            semantic_init(&sema);
+            sema.report_errors = 0;
+            semantic_analyze_parallel(&sema, ast, threads, &stats);
+            steals += stats.steals;
+            semantic_free(&sema);
+        }
+        double parallel = (now_seconds() - start) / repetitions;
+        printf("                  paralela, %2d thread(s): %.3f ms (%.2fx), %.1f roubos por análise",
+               threads, parallel * 1e3, sequential / parallel, (double)steals / repetitions);
+        if (stats.threads_used < threads) {
+            printf(" (%d em uso: %d função(ões))", stats.threads_used, stats.functions);
+        }
+        printf("\n");
+        // Mais threads que funções não mudam nada: as linhas seguintes repetiriam esta
+        if (threads == max_threads || stats.threads_used < threads) break;
+    }
+}
+
+// Uma edição da função do meio e a edição que a desfaz
+typedef struct {
+    const char* name;
+    const char* anchor;     // texto procurado a partir do início da função
+    int skip;               // bytes do anchor antes da edição
+    int remove_length;
+    const char* text;
+} FunctionEdit;
+
+static double timed_update(IncrementalDoc* doc, SemanticSession* session, int offset, int remove_length,
+                           const char* text, SemanticIncrementalStats* stats) {
+    IncrementalStats parse_stats;
+    incremental_edit(doc, offset, remove_length, text, &parse_stats);
+    double start = now_seconds();
+    semantic_session_update(session, doc->program, parse_stats.full_reparse, stats);
+    return now_seconds() - start;
+}
+
+/*
+ * Análise semântica incremental: edita a função do meio do programa com o
+ * parser incremental e mede a atualização da sessão semântica contra uma
+ * análise completa da mesma árvore. Cada repetição aplica a edição e a
+ * desfaz; os tempos são a média das duas atualizações.
+ */
+static void bench_incremental_semantic(const char* input, int repetitions) {
+    static const FunctionEdit edits[] = {
+        {"corpo alterado", "return v2;", 7, 2, "v1"},
+        {"declaração a mais", "    int v2", 4, 0, "int v8 = v1; "},
+        {"assinatura alterada", "int f", 0, 3, "float"},
+    };
+
+    IncrementalDoc doc;
+    incremental_init(&doc, input);
+    int functions = 0;
+    for (int i = 0; i < doc.program->child_count; i++) {
+        functions += doc.program->children[i] && doc.program->children[i]->type == NODE_FUNC_DECL;
+    }
+    char header[32];
+    snprintf(header, sizeof(header), "int f%d(", functions / 2);
+    const char* function = strstr(doc.source, header);
+    if (!function) {
+        incremental_free(&doc);
+        return;
+    }
+    int function_offset = (int)(function - doc.source);
+
+    SemanticSession session;
+    semantic_session_init(&session, &doc.arena);
+    double start = now_seconds();
+    semantic_session_update(&session, doc.program, 0, NULL);
+    printf("  semântica incremental (edição de f%d, %d funções): análise inicial %.3f ms\n",
+           functions / 2, functions, (now_seconds() - start) * 1e3);
+
+    for (size_t e = 0; e < sizeof(edits) / sizeof(edits[0]); e++) {
+        const FunctionEdit* edit = &edits[e];
+        int offset = (int)(strstr(doc.source + function_offset, edit->anchor) - doc.source) + edit->skip;
+        char removed[16];
+        snprintf(removed, sizeof(removed), "%.*s", edit->remove_length, doc.source + offset);
+
+        SemanticIncrementalStats stats, undo_stats;
+        double seconds = 0;
+        for (int r = 0; r < repetitions; r++) {
+            seconds += timed_update(&doc, &session, offset, edit->remove_length, edit->text, &stats);
+            seconds += timed_update(&doc, &session, offset, strlen(edit->text), removed, &undo_stats);
+        }
+        seconds /= 2.0 * repetitions;
+
+        // Referência: análise completa da árvore com a edição aplicada
+        timed_update(&doc, &session, offset, edit->remove_length, edit->text, &stats);
+        SemanticAnalyzer full;
+        semantic_init(&full);
+        full.report_errors = 0;
+        full.arena = &doc.arena;
+        start = now_seconds();
+        semantic_analyze(&full, doc.program);
+        double full_seconds = now_seconds() - start;
+        int same = full.error_count == session.sema.error_count &&
+                   full.table.symbol_count == session.sema.table.symbol_count;
+        semantic_free(&full);
+        timed_update(&doc, &session, offset, strlen(edit->text), removed, &undo_stats);
+
+        printf("    %s: %.3f ms por atualização x completa %.3f ms (%.1fx): %d reanalisada(s), "
+               "%d aproveitada(s), %d renumerada(s)%s\n", edit->name, seconds * 1e3, full_seconds * 1e3,
+               full_seconds / seconds, stats.rechecked, stats.reused, stats.remapped,
+               same ? "" : " (DIFERE DA ANÁLISE COMPLETA)");
+    }
+
+    semantic_session_free(&session);
+    incremental_free(&doc);
+}
+
+/*
+ * Mede tokenize + parse sobre o programa gerado. Os números de memória
+ * vêm da primeira repetição: bytes da arena entregues à AST (nós, strings
+ * e vetores de filhos) divididos pelo número de nós.
+ */
+static int run_generated(const char* shape, int size, int depth, int use_lalr, const char* save_file,
+                         int repetitions, int semantic_threads) {
+    char* input = generate_program(shape, size, depth);
+    if (!input) {
+        fprintf(stderr, "Erro: forma '%s' desconhecida (use funcoes, aninhamento ou expressoes)\n", shape);
+        return 1;
+    }
+    size_t source_bytes = strlen(input);
+
+    if (save_file) {
+        FILE* file = fopen(save_file, "w");
+        if (!file || fputs(input, file) == EOF || fclose(file) != 0) {
+            fprintf(stderr, "Erro: não foi possível gravar '%s'\n", save_file);
+            free(input);
+            return 1;
+        }
+    }
+
+    int token_count = 0;
+    size_t nodes = 0, arena_used = 0, arena_reserved = 0;
+    int accepted = 1;
+    double start = now_seconds();
+    for (int r = 0; r < repetitions; r++) {
+        Token* tokens = tokenize(input, &token_count);
+        Arena arena;
+        arena_init(&arena);
+        if (use_lalr) {
+            accepted = lalr_parse(tokens, token_count, &arena, 0, NULL) != NULL;
+        } else {
+            Parser parser;
+            init_parser(&parser, tokens, token_count, &arena);
+            parser.report_errors = 0;
+            parse_program(&parser);
+            accepted = parser.error_count == 0;
+        }
+        if (r == 0) {
+            nodes = arena.node_count;
+            arena_used = arena.bytes_used;
+            arena_reserved = arena.bytes_reserved;
+        }
+        arena_free(&arena);
+        free(tokens);
+    }
+    double seconds = (now_seconds() - start) / repetitions;
+
+    printf("Programa gerado: %s, tamanho %d, profundidade %d (parser %s)\n",
+           shape, size, depth, use_lalr ? "LALR(1)" : "descendente recursivo");
+    printf("  fonte:          %.1f KB, %d tokens, %zu nós%s\n", source_bytes / 1024.0, token_count, nodes,
+           accepted ? "" : " (COM ERROS SINTÁTICOS)");
+    printf("  tokenize+parse: %.3f ms por repetição (%d repetições)\n", seconds * 1e3, repetitions);
+    printf("  vazão:          %.2f Mtokens/s, %.2f Mnós/s\n",
+           token_count / seconds / 1e6, nodes / seconds / 1e6);
+    printf("  memória:        %.1f bytes alocados por nó (arena: %.1f KB usados, %.1f KB reservados)\n",
+           nodes ? (double)arena_used / nodes : 0.0, arena_used / 1024.0, arena_reserved / 1024.0);
+    printf("                  vetor de tokens: %.1f KB (%zu bytes por token)\n",
+           (double)token_count * sizeof(Token) / 1024.0, sizeof(Token));
+    printf("  pico de RSS:    %.1f MB\n", peak_rss_kb() / 1024.0);
+
+    if (semantic_threads > 0) {
+        Token* tokens = tokenize(input, &token_count);
+        Arena arena;
+        arena_init(&arena);
+        Parser parser;
+        init_parser(&parser, tokens, token_count, &arena);
+        parser.report_errors = 0;
+        bench_semantic(parse_program(&parser), repetitions, semantic_threads);
+        arena_free(&arena);
+        free(tokens);
+        bench_incremental_semantic(input, repetitions);
+    }
+
+    free(input);
+    return accepted ? 0 : 1;
+}
+
+static void print_usage(const char* program) {
+    printf("Uso: %s [-n REPETICOES] arquivo...\n", program);
+    printf("     %s [-n REPETICOES] --gerar FORMA TAMANHO [--profundidade D]\n", program);
+    printf("        [--parser rd|lalr] [--salvar arquivo.txt] [--semantico THREADS]\n");
+    printf("FORMA: funcoes | aninhamento | expressoes\n");
+}
+
+int main(int argc, char* argv[]) {
+    int repetitions = 100;
+    int first_file = 1;
+
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        repetitions = atoi(argv[2]);
+        first_file = 3;
+    }
+
+    if (first_file < argc && strcmp(argv[first_file], "--gerar") == 0) {
+        const char* shape = NULL;
+        const char* save_file = NULL;
+        int size = 0, depth = 100, use_lalr = 0, semantic_threads = 0;
+        for (int i = first_file; i < argc; i++) {
+            if (strcmp(argv[i], "--gerar") == 0 && i + 2 < argc) {
+                shape = argv[++i];
+                size = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--profundidade") == 0 && i + 1 < argc) {
+                depth = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--parser") == 0 && i + 1 < argc) {
+                use_lalr = strcmp(argv[++i], "lalr") == 0;
+            } else if (strcmp(argv[i], "--salvar") == 0 && i + 1 < argc) {
+                save_file = argv[++i];
+            } else if (strcmp(argv[i], "--semantico") == 0 && i + 1 < argc) {
+                semantic_threads = atoi(argv[++i]);
+            } else {
+                shape = NULL;
+                break;
+            }
+        }
+        if (!shape || size < 1 || depth < 1 || repetitions < 1) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        return run_generated(shape, size, depth, use_lalr, save_file, repetitions, semantic_threads);
+    }
+
+    if (first_file >= argc || repetitions < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    printf("%-28s %9s | %-30s | %-30s | %-30s\n", "", "", "descendente recursivo (AST)",
+           "LL(1) por tabela", "LALR(1) por tabela (AST)");
+    printf("%-28s %9s | %14s %15s | %14s %15s | %14s %15s\n", "arquivo", "tokens",
+           "Mtokens/s", "memória (KB)", "Mtokens/s", "memória (KB)", "Mtokens/s", "memória (KB)");
+
+    int mismatches = 0;
+    for (int i = first_file; i < argc; i++) {
+        char* input = read_file(argv[i]);
+        if (!input) return 1;
+
+        int token_count;
+        Token* tokens = tokenize(input, &token_count);
+
+        int nodes = 0;
+        ParserResult rd = bench_recursive_descent(tokens, token_count, repetitions, &nodes);
+        ParserResult ll1 = bench_ll1(tokens, token_count, repetitions);
+        int equal = 1;
+        ParserResult lalr = bench_lalr(tokens, token_count, repetitions, &equal);
+
+        int diverge = rd.accepted != ll1.accepted || rd.accepted != lalr.accepted;
+        printf("%-28s %9d | %14.2f %15.1f | %14.2f %15.1f | %14.2f %15.1f%s%s\n", argv[i], token_count,
+               token_count / rd.seconds / 1e6, rd.memory / 1024.0,
+               token_count / ll1.seconds / 1e6, ll1.memory / 1024.0,
+               token_count / lalr.seconds / 1e6, lalr.memory / 1024.0,
+               diverge ? "  (DIVERGEM na aceitação)" : "", equal ? "" : "  (ASTs DIFERENTES)");
+        mismatches += diverge || !equal;
+
+        free(tokens);
+        free(input);
+    }
+
+    printf("\nMemória: descendente = arena da AST; LL(1) = tabelas geradas (%zu bytes) + pilha;\n",
+           ll1_table_bytes());
+    printf("LALR(1) = arena da AST + tabelas comprimidas (%zu bytes) + pilhas.\n", lalr_table_bytes());
+    return mismatches ? 1 : 0;
+}
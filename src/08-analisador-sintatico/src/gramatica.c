@@ -0,0 +1,313 @@
+/*
+ * Gramáticas para os geradores de tabelas: leitura do arquivo e cálculo
+ * dos conjuntos FIRST e FOLLOW.
+ */
+
+#include "../include/gramatica.h"
+
+// ==================== LEITURA ====================
+
+typedef struct {
+    const char* text;
+    int position;
+    int line;
+} Reader;
+
+static int terminal_by_name(const char* name) {
+    for (int t = 0; t < GRAMMAR_TERMINALS - 1; t++) {
+        if (strcmp(token_type_to_string((TokenType)t), name) == 0) return t;
+    }
+    return -1;
+}
+
+// Índice do não terminal, criado na primeira vez que o nome aparece
+int grammar_nonterminal(Grammar* grammar, const char* name, int line) {
+    for (int n = 0; n < grammar->nonterminal_count; n++) {
+        if (strcmp(grammar->names[n], name) == 0) return n;
+    }
+    if (grammar->nonterminal_count == GRAMMAR_MAX_NONTERMINALS) {
+        fprintf(stderr, "Erro: mais de %d não terminais\n", GRAMMAR_MAX_NONTERMINALS);
+        exit(1);
+    }
+    int n = grammar->nonterminal_count++;
+    snprintf(grammar->names[n], GRAMMAR_MAX_NAME, "%s", name);
+    grammar->defined[n] = 0;
+    grammar->first_use[n] = line;
+    return n;
+}
+
+void grammar_add_production(Grammar* grammar, int lhs, const int* rhs, int length, int line,
+                            const char* action) {
+    if (grammar->production_count == grammar->production_capacity) {
+        grammar->production_capacity = grammar->production_capacity ? grammar->production_capacity * 2 : 64;
+        grammar->productions = realloc(grammar->productions,
+                                       grammar->production_capacity * sizeof(Production));
+    }
+    Production* p = &grammar->productions[grammar->production_count++];
+    p->lhs = lhs;
+    p->length = length;
+    p->line = line;
+    p->rhs = malloc((length ? length : 1) * sizeof(int));
+    memcpy(p->rhs, rhs, length * sizeof(int));
+    snprintf(p->action, GRAMMAR_MAX_NAME, "%s", action ? action : "");
+}
+
+/*
+ * Próxima palavra da gramática: nome, "->", "|", ";" ou "{acao}". Devolve
+ * 0 no fim do arquivo.
+ */
+static int next_word(Reader* reader, char* word) {
+    const char* s = reader->text;
+    while (s[reader->position]) {
+        char c = s[reader->position];
+        if (c == '\n') {
+            reader->line++;
+            reader->position++;
+        } else if (isspace((unsigned char)c)) {
+            reader->position++;
+        } else if (c == '#') {
+            while (s[reader->position] && s[reader->position] != '\n') reader->position++;
+        } else {
+            break;
+        }
+    }
+    if (!s[reader->position]) return 0;
+
+    int length = 0;
+    char c = s[reader->position];
+    if (c == '|' || c == ';') {
+        word[length++] = c;
+        reader->position++;
+    } else if (c == '-' && s[reader->position + 1] == '>') {
+        word[length++] = '-';
+        word[length++] = '>';
+        reader->position += 2;
+    } else if (c == '{') {
+        while (s[reader->position] && s[reader->position] != '}' && s[reader->position] != '\n' &&
+               length < GRAMMAR_MAX_NAME - 2) {
+            word[length++] = s[reader->position++];
+        }
+        if (s[reader->position] == '}') word[length++] = s[reader->position++];
+    } else {
+        // Nome: qualquer sequência sem espaço nem pontuação da gramática (aceita "ε" em UTF-8)
+        while (s[reader->position] && !isspace((unsigned char)s[reader->position]) &&
+               !strchr("|;#{", s[reader->position]) && length < GRAMMAR_MAX_NAME - 1) {
+            word[length++] = s[reader->position++];
+        }
+    }
+    word[length] = '\0';
+    return 1;
+}
+
+static int parse_grammar(Grammar* grammar, const char* text, const char* filename) {
+    Reader reader = {text, 0, 1};
+    char word[GRAMMAR_MAX_NAME];
+    char action[GRAMMAR_MAX_NAME] = "";
+    int rhs[256];
+
+    while (next_word(&reader, word)) {
+        int rule_line = reader.line;
+        if (strchr("-|;{", word[0]) || terminal_by_name(word) >= 0) {
+            fprintf(stderr, "%s:%d: esperado nome de não terminal, encontrado '%s'\n",
+                    filename, rule_line, word);
+            return 0;
+        }
+
+        int lhs = grammar_nonterminal(grammar, word, rule_line);
+        if (!grammar->defined[lhs]) grammar->defined[lhs] = rule_line;
+
+        if (!next_word(&reader, word) || strcmp(word, "->") != 0) {
+            fprintf(stderr, "%s:%d: esperado '->' após '%s'\n", filename, rule_line, grammar->names[lhs]);
+            return 0;
+        }
+
+        // Alternativas até o ';'
+        int length = 0;
+        int closed = 0;
+        while (next_word(&reader, word)) {
+            if (strcmp(word, "|") == 0 || strcmp(word, ";") == 0) {
+                grammar_add_production(grammar, lhs, rhs, length, reader.line, action);
+                length = 0;
+                action[0] = '\0';
+                if (word[0] == ';') {
+                    closed = 1;
+                    break;
+                }
+            } else if (word[0] == '{') {
+                size_t size = strlen(word);
+                if (size < 3 || word[size - 1] != '}') {
+                    fprintf(stderr, "%s:%d: ação mal formada '%s'\n", filename, reader.line, word);
+                    return 0;
+                }
+                snprintf(action, sizeof(action), "%.*s", (int)size - 2, word + 1);
+            } else if (strcmp(word, "ε") == 0 || strcmp(word, "eps") == 0) {
+                // cadeia vazia: não acrescenta símbolo
+            } else if (strcmp(word, "->") == 0) {
+                fprintf(stderr, "%s:%d: ';' faltando antes de '->'\n", filename, reader.line);
+                return 0;
+            } else if (length == (int)(sizeof(rhs) / sizeof(rhs[0]))) {
+                fprintf(stderr, "%s:%d: alternativa longa demais\n", filename, reader.line);
+                return 0;
+            } else {
+                int terminal = terminal_by_name(word);
+                rhs[length++] = terminal >= 0 ? terminal
+                                              : GRAMMAR_TERMINALS + grammar_nonterminal(grammar, word, reader.line);
+            }
+        }
+        if (!closed) {
+            fprintf(stderr, "%s:%d: regra de '%s' sem ';' final\n", filename, rule_line, grammar->names[lhs]);
+            return 0;
+        }
+    }
+
+    int errors = 0;
+    for (int n = 0; n < grammar->nonterminal_count; n++) {
+        if (!grammar->defined[n]) {
+            fprintf(stderr, "%s:%d: '%s' não é token nem tem regra\n",
+                    filename, grammar->first_use[n], grammar->names[n]);
+            errors++;
+        }
+    }
+    if (grammar->production_count == 0) {
+        fprintf(stderr, "%s: gramática vazia\n", filename);
+        errors++;
+    }
+    return errors == 0;
+}
+
+// Lê e valida a gramática; NULL em caso de erro (com mensagens em stderr)
+Grammar* grammar_load(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", filename);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char* text = malloc(size + 1);
+    size_t read = fread(text, 1, size, file);
+    text[read] = '\0';
+    fclose(file);
+
+    Grammar* grammar = calloc(1, sizeof(Grammar));
+    int ok = parse_grammar(grammar, text, filename);
+    free(text);
+
+    if (!ok) {
+        grammar_free(grammar);
+        return NULL;
+    }
+    return grammar;
+}
+
+void grammar_free(Grammar* grammar) {
+    for (int i = 0; i < grammar->production_count; i++) free(grammar->productions[i].rhs);
+    free(grammar->productions);
+    free(grammar);
+}
+
+// ==================== FIRST E FOLLOW ====================
+
+// FIRST de uma sequência de símbolos; *nullable = 1 se a sequência deriva ε
+TerminalSet grammar_first_of(const Grammar* grammar, const int* symbols, int length, int* nullable) {
+    TerminalSet set = 0;
+    for (int i = 0; i < length; i++) {
+        if (symbols[i] < GRAMMAR_TERMINALS) {
+            *nullable = 0;
+            return set | ((TerminalSet)1 << symbols[i]);
+        }
+        int n = symbols[i] - GRAMMAR_TERMINALS;
+        set |= grammar->first[n];
+        if (!grammar->nullable[n]) {
+            *nullable = 0;
+            return set;
+        }
+    }
+    *nullable = 1;
+    return set;
+}
+
+// Iteração de ponto fixo: repete até nenhum conjunto mudar
+void grammar_compute_first(Grammar* grammar) {
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 0; i < grammar->production_count; i++) {
+            const Production* p = &grammar->productions[i];
+            int nullable;
+            TerminalSet set = grammar_first_of(grammar, p->rhs, p->length, &nullable);
+            if ((grammar->first[p->lhs] | set) != grammar->first[p->lhs]) {
+                grammar->first[p->lhs] |= set;
+                changed = 1;
+            }
+            if (nullable && !grammar->nullable[p->lhs]) {
+                grammar->nullable[p->lhs] = 1;
+                changed = 1;
+            }
+        }
+    }
+}
+
+void grammar_compute_follow(Grammar* grammar) {
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 0; i < grammar->production_count; i++) {
+            const Production* p = &grammar->productions[i];
+            for (int j = 0; j < p->length; j++) {
+                if (p->rhs[j] < GRAMMAR_TERMINALS) continue;
+                int n = p->rhs[j] - GRAMMAR_TERMINALS;
+
+                // FOLLOW(B) ⊇ FIRST(β) e, se β deriva ε, FOLLOW(B) ⊇ FOLLOW(A)
+                int nullable;
+                TerminalSet set = grammar_first_of(grammar, p->rhs + j + 1, p->length - j - 1, &nullable);
+                if (nullable) set |= grammar->follow[p->lhs];
+                if ((grammar->follow[n] | set) != grammar->follow[n]) {
+                    grammar->follow[n] |= set;
+                    changed = 1;
+                }
+            }
+        }
+    }
+}
+
+// ==================== IMPRESSÃO ====================
+
+const char* grammar_symbol_name(const Grammar* grammar, int symbol) {
+    return symbol < GRAMMAR_TERMINALS ? token_type_to_string((TokenType)symbol)
+                                      : grammar->names[symbol - GRAMMAR_TERMINALS];
+}
+
+void grammar_print_production(const Grammar* grammar, int index, FILE* out) {
+    const Production* p = &grammar->productions[index];
+    fprintf(out, "%s ->", grammar->names[p->lhs]);
+    if (p->length == 0) fprintf(out, " ε");
+    for (int i = 0; i < p->length; i++) {
+        fprintf(out, " %s", grammar_symbol_name(grammar, p->rhs[i]));
+    }
+}
+
+void grammar_print_set(TerminalSet set, FILE* out) {
+    fprintf(out, "{");
+    int first = 1;
+    for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+        if (set & ((TerminalSet)1 << t)) {
+            fprintf(out, "%s%s", first ? " " : ", ", token_type_to_string((TokenType)t));
+            first = 0;
+        }
+    }
+    fprintf(out, " }");
+}
+
+void grammar_print_sets(const Grammar* grammar) {
+    printf("=== CONJUNTOS FIRST E FOLLOW ===\n");
+    for (int n = 0; n < grammar->nonterminal_count; n++) {
+        printf("%-20s FIRST = ", grammar->names[n]);
+        grammar_print_set(grammar->first[n], stdout);
+        if (grammar->nullable[n]) printf(" + ε");
+        printf("\n%-20s FOLLOW = ", "");
+        grammar_print_set(grammar->follow[n], stdout);
+        printf("\n");
+    }
+}
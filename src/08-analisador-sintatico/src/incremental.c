@@ -0,0 +1,456 @@
+/*
+ * Parsing incremental com reaproveitamento de subárvores
+ *
+ * Em um editor, cada tecla digitada altera poucos bytes de um arquivo que
+ * pode ter milhares de funções. Reanalisar tudo a cada edição faz a
+ * latência crescer com o tamanho do arquivo; aqui ela cresce com o
+ * tamanho da edição.
+ *
+ * O documento é dividido em segmentos, um por declaração de nível
+ * superior (com o espaço e os comentários que a precedem). Uma edição:
+ *
+ *   1. localiza os segmentos tocados (busca binária pelos deslocamentos);
+ *   2. refaz a análise léxica só desses segmentos, ampliando a região
+ *      enquanto ela não terminar em ';' ou '}' de nível zero (ex.: a edição
+ *      abriu um '{' ou um comentário que engole a declaração seguinte);
+ *   3. reanalisa a região; dentro dela, nós NODE_FUNC_DECL e
+ *      NODE_COMPOUND_STMT antigos cujo trecho não foi tocado pela edição
+ *      são reaproveitados (o parser pula os tokens que eles cobrem);
+ *   4. desloca os segmentos seguintes, que continuam com suas subárvores.
+ *
+ * Os trechos gravados nos nós são relativos ao início do segmento, então
+ * segmentos depois da edição não precisam ser visitados. A exceção são as
+ * linhas: se a edição muda o número de linhas, as linhas dos nós seguintes
+ * são ajustadas (uma visita barata, sem análise léxica nem alocação).
+ *
+ * Todos os nós ficam na arena do documento. Nós substituídos viram lixo;
+ * quando o lixo passa do dobro dos nós vivos, o documento é reanalisado
+ * do zero para compactar a arena.
+ */
+
+#include "../include/parser.h"
+
+// Subárvore antiga que pode ser reaproveitada, com o trecho já no texto novo
+typedef struct {
+    ASTNode* node;
+    int start;
+    int end;
+} ReuseCandidate;
+
+typedef struct {
+    ReuseCandidate* items;
+    int count;
+    int capacity;
+} ReuseTable;
+
+// Resultado da análise léxica de uma região do documento
+typedef struct {
+    Token* tokens;
+    int count;
+    int end_line;     // linha/coluna ao final da região
+    int end_column;
+    int unterminated;
+} RegionTokens;
+
+// ==================== UTILITÁRIOS ====================
+
+static int count_newlines(const char* text, int length) {
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        if (text[i] == '\n') count++;
+    }
+    return count;
+}
+
+// Índice do segmento que contém a posição (o último, se for o fim do texto)
+static int find_segment(const IncrementalDoc* doc, int position) {
+    int lo = 0, hi = doc->segment_count - 1;
+    while (lo < hi) {
+        int mid = lo + (hi - lo + 1) / 2;
+        if (doc->segments[mid].offset <= position) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+static void lex_region(const IncrementalDoc* doc, int start, int end, int line, int column,
+                       RegionTokens* region) {
+    Lexer lexer;
+    init_lexer(&lexer, doc->source);
+    lexer.position = start;
+    lexer.line = line;
+    lexer.column = column;
+    lexer.length = end;
+
+    int capacity = 64;
+    region->tokens = malloc(capacity * sizeof(Token));
+    region->count = 0;
+
+    while (1) {
+        Token token = get_next_token(&lexer);
+        if (token.type == TOKEN_EOF) break;
+        if (token.type == TOKEN_ERROR) {
+            fprintf(stderr, "Erro léxico na linha %d, coluna %d: caractere inválido '%s'\n",
+                    token.line, token.column, token.lexeme);
+            continue;
+        }
+        if (region->count == capacity) {
+            capacity *= 2;
+            region->tokens = realloc(region->tokens, capacity * sizeof(Token));
+        }
+        region->tokens[region->count++] = token;
+    }
+
+    region->end_line = lexer.line;
+    region->end_column = lexer.column;
+    region->unterminated = lexer.unterminated;
+}
+
+// Linha e coluna logo após o token (strings podem conter quebras de linha)
+static void position_after(const IncrementalDoc* doc, const Token* token, int* line, int* column) {
+    *line = token->line;
+    *column = token->column;
+    for (int i = 0; i < token->length; i++) {
+        if (doc->source[token->position + i] == '\n') {
+            (*line)++;
+            *column = 1;
+        } else {
+            (*column)++;
+        }
+    }
+}
+
+// ==================== REAPROVEITAMENTO ====================
+
+static void collect_candidates(ASTNode* node, int base, int edit_start, int edit_end, int delta,
+                               ReuseTable* table) {
+    if (!node) return;
+
+    if ((node->type == NODE_FUNC_DECL || node->type == NODE_COMPOUND_STMT) && node->src_start >= 0) {
+        int start = base + node->src_start;
+        int end = base + node->src_end;
+
+        // Só vale se o trecho inteiro estiver antes ou depois da edição
+        if (end <= edit_start || start >= edit_end) {
+            if (table->count == table->capacity) {
+                table->capacity = table->capacity ? table->capacity * 2 : 16;
+                table->items = realloc(table->items, table->capacity * sizeof(ReuseCandidate));
+            }
+            int shift = start >= edit_end ? delta : 0;
+            table->items[table->count].node = node;
+            table->items[table->count].start = start + shift;
+            table->items[table->count].end = end + shift;
+            table->count++;
+            // Os filhos são candidatos apenas se o pai não for reaproveitado,
+            // o que acontece se o parser não chegar a pedir por ele; por isso
+            // continuam na tabela.
+        }
+    }
+
+    collect_candidates(node->left, base, edit_start, edit_end, delta, table);
+    collect_candidates(node->right, base, edit_start, edit_end, delta, table);
+    for (int i = 0; i < node->child_count; i++) {
+        collect_candidates(node->children[i], base, edit_start, edit_end, delta, table);
+    }
+}
+
+static int compare_candidates(const void* a, const void* b) {
+    const ReuseCandidate* x = a;
+    const ReuseCandidate* y = b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+static ASTNode* lookup_candidate(void* ctx, NodeType type, int position, int* end_position) {
+    ReuseTable* table = ctx;
+    int lo = 0, hi = table->count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        ReuseCandidate* c = &table->items[mid];
+        if (c->start == position) {
+            if (c->node->type != type) return NULL;
+            *end_position = c->end;
+            return c->node;
+        }
+        if (c->start < position) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return NULL;
+}
+
+// ==================== SEGMENTOS ====================
+
+/*
+ * Substitui os segmentos [first, first + old_count) pelos segmentos
+ * resultantes da análise de [start, end), já tokenizado em 'region'.
+ */
+static void replace_segments(IncrementalDoc* doc, int first, int old_count, int start, int end,
+                             int line, int column, RegionTokens* region, ReuseTable* reuse,
+                             IncrementalStats* stats) {
+    int range_count;
+    DeclRange* ranges = find_toplevel_declarations(region->tokens, region->count, &range_count);
+
+    // Espaço final sem declaração (fim do documento) vira um segmento vazio
+    int last_end = range_count > 0 ? region->tokens[ranges[range_count - 1].end - 1].position
+                                     + region->tokens[ranges[range_count - 1].end - 1].length
+                                   : start;
+    int trailing = last_end < end || range_count == 0;
+    int new_count = range_count + trailing;
+
+    // Abre espaço no vetor de segmentos
+    int total = doc->segment_count - old_count + new_count;
+    if (total > doc->segment_capacity) {
+        while (total > doc->segment_capacity) {
+            doc->segment_capacity = doc->segment_capacity ? doc->segment_capacity * 2 : 64;
+        }
+        doc->segments = realloc(doc->segments, doc->segment_capacity * sizeof(Segment));
+    }
+    memmove(&doc->segments[first + new_count], &doc->segments[first + old_count],
+            (doc->segment_count - first - old_count) * sizeof(Segment));
+    doc->segment_count = total;
+
+    int seg_start = start;
+    for (int r = 0; r < new_count; r++) {
+        Segment* seg = &doc->segments[first + r];
+        int seg_end = end;
+        if (r < range_count) {
+            const Token* last = &region->tokens[ranges[r].end - 1];
+            seg_end = last->position + last->length;
+        }
+
+        seg->offset = seg_start;
+        seg->length = seg_end - seg_start;
+        seg->start_line = line;
+        seg->start_column = column;
+        seg->newline_count = count_newlines(doc->source + seg_start, seg->length);
+        seg->nodes = NULL;
+        seg->node_total = 0;
+        seg->subtree_nodes = 0;
+        seg->error_count = 0;
+
+        if (r < range_count) {
+            int length = ranges[r].end - ranges[r].start;
+            Parser parser;
+            init_parser(&parser, region->tokens + ranges[r].start, length, &doc->arena);
+            parser.position_base = seg_start;
+            parser.reuse = reuse && reuse->count > 0 ? lookup_candidate : NULL;
+            parser.reuse_ctx = reuse;
+
+            // Como em parse_program: normalmente uma declaração por intervalo
+            int capacity = 1;
+            seg->nodes = arena_alloc(&doc->arena, capacity * sizeof(ASTNode*));
+            while (parser.current_token < length) {
+                int before = parser.current_token;
+                ASTNode* decl = parse_declaration(&parser);
+                if (decl) {
+                    if (seg->node_total == capacity) {
+                        ASTNode** nodes = arena_alloc(&doc->arena, capacity * 2 * sizeof(ASTNode*));
+                        memcpy(nodes, seg->nodes, capacity * sizeof(ASTNode*));
+                        seg->nodes = nodes;
+                        capacity *= 2;
+                    }
+                    seg->nodes[seg->node_total++] = decl;
+                    seg->subtree_nodes += count_nodes(decl);
+                }
+                if (parser.current_token == before) parser.current_token++;
+            }
+            seg->error_count = parser.error_count;
+
+            position_after(doc, &region->tokens[ranges[r].end - 1], &line, &column);
+        }
+
+        seg_start = seg_end;
+    }
+
+    if (stats) {
+        stats->tokens_relexed += region->count;
+        stats->segments_reparsed += range_count;
+    }
+    free(ranges);
+}
+
+// Refaz o vetor de filhos do NODE_PROGRAM a partir dos segmentos
+static void rebuild_program(IncrementalDoc* doc) {
+    int count = 0;
+    doc->error_count = 0;
+    for (int i = 0; i < doc->segment_count; i++) {
+        count += doc->segments[i].node_total;
+        doc->error_count += doc->segments[i].error_count;
+    }
+
+    ASTNode* program = doc->program;
+    if (count > program->child_capacity) {
+        program->child_capacity = count;
+        free(program->children);
+        program->children = malloc(count * sizeof(ASTNode*));
+    }
+
+    program->child_count = 0;
+    for (int i = 0; i < doc->segment_count; i++) {
+        for (int j = 0; j < doc->segments[i].node_total; j++) {
+            program->children[program->child_count++] = doc->segments[i].nodes[j];
+        }
+    }
+}
+
+static void full_parse(IncrementalDoc* doc, IncrementalStats* stats) {
+    if (doc->program) free(doc->program->children);
+    arena_free(&doc->arena);
+    doc->segment_count = 0;
+
+    doc->program = create_node(&doc->arena, NODE_PROGRAM, NULL);
+    doc->program->line = 1;
+
+    RegionTokens region;
+    lex_region(doc, 0, doc->length, 1, 1, &region);
+    replace_segments(doc, 0, 0, 0, doc->length, 1, 1, &region, NULL, stats);
+    free(region.tokens);
+
+    rebuild_program(doc);
+}
+
+// ==================== API ====================
+
+void incremental_init(IncrementalDoc* doc, const char* source) {
+    doc->length = strlen(source);
+    doc->capacity = doc->length + 1;
+    doc->source = malloc(doc->capacity);
+    memcpy(doc->source, source, doc->length + 1);
+    doc->segments = NULL;
+    doc->segment_count = 0;
+    doc->segment_capacity = 0;
+    doc->error_count = 0;
+    doc->program = NULL;
+    arena_init(&doc->arena);
+
+    full_parse(doc, NULL);
+}
+
+ASTNode* incremental_edit(IncrementalDoc* doc, int offset, int remove_length,
+                          const char* text, IncrementalStats* stats) {
+    IncrementalStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+
+    if (offset < 0) offset = 0;
+    if (offset > doc->length) offset = doc->length;
+    if (remove_length > doc->length - offset) remove_length = doc->length - offset;
+    if (remove_length < 0) remove_length = 0;
+
+    int insert_length = strlen(text);
+    int delta = insert_length - remove_length;
+    int line_delta = count_newlines(text, insert_length)
+                   - count_newlines(doc->source + offset, remove_length);
+    int edit_end = offset + remove_length;  // nas coordenadas antigas
+
+    // 1. Segmentos tocados (coordenadas antigas). O caractere antes da
+    //    edição entra na região para que tokens colados sejam refeitos.
+    int first = find_segment(doc, offset > 0 ? offset - 1 : 0);
+    int last = find_segment(doc, edit_end);
+
+    // 2. Aplica a edição ao texto
+    if (doc->length + delta + 1 > doc->capacity) {
+        doc->capacity = (doc->length + delta + 1) * 2;
+        doc->source = realloc(doc->source, doc->capacity);
+    }
+    memmove(doc->source + offset + insert_length, doc->source + edit_end, doc->length - edit_end + 1);
+    memcpy(doc->source + offset, text, insert_length);
+    doc->length += delta;
+
+    // 3. Análise léxica da região, ampliando-a até terminar em uma
+    //    declaração completa
+    Segment* seg_first = &doc->segments[first];
+    int region_start = seg_first->offset;
+    RegionTokens region;
+    while (1) {
+        Segment* seg_last = &doc->segments[last];
+        int region_end = seg_last->offset + seg_last->length + delta;
+        lex_region(doc, region_start, region_end, seg_first->start_line, seg_first->start_column,
+                   &region);
+
+        int at_document_end = (last == doc->segment_count - 1);
+        int complete = !region.unterminated;
+        if (complete && !at_document_end) {
+            int range_count;
+            DeclRange* ranges = find_toplevel_declarations(region.tokens, region.count, &range_count);
+            const Token* tail = region.count > 0 ? &region.tokens[region.count - 1] : NULL;
+            complete = range_count > 0 && ranges[range_count - 1].terminated &&
+                       tail->position + tail->length == region_end;
+            free(ranges);
+        }
+
+        if (complete || at_document_end) break;
+        free(region.tokens);
+        last++;
+    }
+    int old_count = last - first + 1;
+    int region_end = doc->segments[last].offset + doc->segments[last].length + delta;
+
+    // 4. Candidatos a reaproveitamento: subárvores dos segmentos tocados
+    ReuseTable reuse = {NULL, 0, 0};
+    for (int i = first; i <= last; i++) {
+        Segment* seg = &doc->segments[i];
+        for (int j = 0; j < seg->node_total; j++) {
+            if (seg->error_count == 0) {
+                collect_candidates(seg->nodes[j], seg->offset, offset, edit_end, delta, &reuse);
+            }
+        }
+    }
+    if (reuse.count > 1) qsort(reuse.items, reuse.count, sizeof(ReuseCandidate), compare_candidates);
+
+    // 5. Reanalisa a região
+    size_t nodes_before = doc->arena.node_count;
+    int untouched = doc->segment_count - old_count;
+    replace_segments(doc, first, old_count, region_start, region_end,
+                     seg_first->start_line, seg_first->start_column, &region, &reuse, stats);
+
+    // 6. Desloca os segmentos seguintes
+    int next = first + (doc->segment_count - untouched);
+    if (next < doc->segment_count) {
+        Segment* after = &doc->segments[next];
+        int column_delta = region.end_column - after->start_column;
+        int column_changes = 1;
+
+        for (int i = next; i < doc->segment_count; i++) {
+            Segment* seg = &doc->segments[i];
+            seg->offset += delta;
+            seg->start_line += line_delta;
+            if (column_changes) seg->start_column += column_delta;
+            column_changes = column_changes && seg->newline_count == 0;
+
+            if (line_delta != 0) {
+                for (int j = 0; j < seg->node_total; j++) {
+                    stats->nodes_shifted += shift_subtree(seg->nodes[j], 0, line_delta);
+                }
+            }
+        }
+    }
+    free(region.tokens);
+    free(reuse.items);
+
+    rebuild_program(doc);
+
+    // 7. Estatísticas e compactação da arena
+    int live_nodes = 1;
+    for (int i = 0; i < doc->segment_count; i++) {
+        live_nodes += doc->segments[i].subtree_nodes;
+    }
+    stats->nodes_created = (int)(doc->arena.node_count - nodes_before);
+    stats->nodes_reused = live_nodes - 1 - stats->nodes_created;
+
+    if (doc->arena.node_count > 2 * (size_t)live_nodes + 4096) {
+        full_parse(doc, NULL);
+        stats->full_reparse = 1;
+    }
+
+    return doc->program;
+}
+
+void incremental_free(IncrementalDoc* doc) {
+    free(doc->program->children);
+    arena_free(&doc->arena);
+    free(doc->segments);
+    free(doc->source);
+    doc->segments = NULL;
+    doc->source = NULL;
+    doc->program = NULL;
+}
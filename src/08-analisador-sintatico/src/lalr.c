@@ -0,0 +1,287 @@
+/*
+ * Parser LALR(1) dirigido por tabela
+ *
+ * Driver shift/reduce sobre as tabelas ACTION/GOTO comprimidas geradas por
+ * lalrgen a partir de gramaticas/linguagem.lalr:
+ *
+ *     empilha o estado 0
+ *     repita:
+ *         s = estado do topo, a = token corrente
+ *         ACTION[s, a] = shift t:  empilha t e avança
+ *         ACTION[s, a] = reduce A -> β:
+ *             desempilha |β| estados, executa a ação semântica da
+ *             produção e empilha GOTO[topo, A]
+ *         aceita ou erro
+ *
+ * Ao lado da pilha de estados fica a pilha de valores: cada posição guarda
+ * o nó montado para o símbolo e o índice do seu primeiro token. As ações
+ * semânticas montam exatamente a AST do parser descendente recursivo (mesmos
+ * tipos, valores, linhas e filhos), de modo que ast_equal compara os dois.
+ * Não há recuperação de erros: o primeiro erro interrompe a análise.
+ */
+
+#include "../include/parser.h"
+#include "tabela_lalr.h"
+
+#define LALR_INITIAL_STACK 256
+
+typedef struct {
+    ASTNode* node;
+    int first_token;    // primeiro token coberto pelo símbolo (para linhas)
+} LALRValue;
+
+// ACTION[state, token]: entradas explícitas ou a redução padrão do estado
+static inline int lalr_action(int state, int token) {
+    int index = lalr_action_base[state] + token;
+    if (lalr_action_check[index] == state) return lalr_action_value[index];
+    return -lalr_default_reduce[state];
+}
+
+static inline int lalr_goto(int state, int nonterminal) {
+    int index = lalr_goto_base[nonterminal] + state;
+    if (lalr_goto_check[index] == nonterminal) return lalr_goto_value[index];
+    return lalr_default_goto[nonterminal];
+}
+
+// Descreve os tokens com ação explícita no estado (no máximo alguns, para a mensagem)
+static void expected_tokens(int state, char* buffer, size_t size) {
+    int written = 0, shown = 0;
+    buffer[0] = '\0';
+    for (int t = 0; t < LALR_TERMINALS && written < (int)size; t++) {
+        if (lalr_action_check[lalr_action_base[state] + t] != state) continue;
+        if (shown == 4) {
+            snprintf(buffer + written, size - written, ", ...");
+            return;
+        }
+        written += snprintf(buffer + written, size - written, "%s%s", shown ? ", " : "",
+                            token_type_to_string((TokenType)t));
+        shown++;
+    }
+}
+
+static ASTNode* new_node(Arena* arena, NodeType type, const char* value, int line) {
+    ASTNode* node = create_node(arena, type, value);
+    node->line = line;
+    return node;
+}
+
+/*
+ * Executa a ação semântica da produção sobre os valores do lado direito
+ * (v[0] .. v[n - 1]) e devolve o nó do lado esquerdo. As listas são
+ * montadas em um nó provisório (lista_vazia/lista_inicio/lista_anexa) que
+ * a regra que as consome transforma no nó definitivo.
+ */
+static ASTNode* reduce_action(int action, const LALRValue* v, int length, const Token* tokens, Arena* arena) {
+    ASTNode* node;
+
+    switch (action) {
+        case LALR_ACAO_REPASSA:
+            return v[0].node;
+
+        case LALR_ACAO_PARENTESES:
+            return v[1].node;
+
+        case LALR_ACAO_LISTA_VAZIA:
+            return create_node(arena, NODE_PROGRAM, NULL);
+
+        case LALR_ACAO_LISTA_INICIO:
+            node = create_node(arena, NODE_PROGRAM, NULL);
+            add_child(arena, node, v[0].node);
+            return node;
+
+        case LALR_ACAO_LISTA_ANEXA:
+            add_child(arena, v[0].node, v[length - 1].node);
+            return v[0].node;
+
+        case LALR_ACAO_PROGRAMA:
+            node = v[0].node;
+            node->line = 1;
+            return node;
+
+        case LALR_ACAO_TIPO:
+            return new_node(arena, NODE_IDENTIFIER, tokens[v[0].first_token].lexeme,
+                            tokens[v[0].first_token].line);
+
+        case LALR_ACAO_FUNCAO:
+            // A lista de parâmetros vira a própria declaração
+            node = v[3].node;
+            node->type = NODE_FUNC_DECL;
+            node->value = arena_strdup(arena, tokens[v[1].first_token].lexeme);
+            node->line = v[0].node->line;
+            node->left = v[0].node;
+            node->right = v[5].node;
+            return node;
+
+        case LALR_ACAO_PARAMETRO:
+            node = new_node(arena, NODE_PARAM, tokens[v[1].first_token].lexeme, v[0].node->line);
+            node->left = v[0].node;
+            return node;
+
+        case LALR_ACAO_VARIAVEL:
+        case LALR_ACAO_VARIAVEL_INICIALIZADA:
+            node = new_node(arena, NODE_VAR_DECL, tokens[v[1].first_token].lexeme, v[0].node->line);
+            node->left = v[0].node;
+            if (action == LALR_ACAO_VARIAVEL_INICIALIZADA) node->right = v[3].node;
+            return node;
+
+        case LALR_ACAO_BLOCO:
+            node = v[1].node;
+            node->type = NODE_COMPOUND_STMT;
+            node->line = tokens[v[0].first_token].line;
+            return node;
+
+        case LALR_ACAO_SE:
+        case LALR_ACAO_SE_SENAO:
+        case LALR_ACAO_ENQUANTO:
+            node = new_node(arena, action == LALR_ACAO_ENQUANTO ? NODE_WHILE_STMT : NODE_IF_STMT, NULL,
+                            tokens[v[0].first_token].line);
+            add_child(arena, node, v[2].node);
+            add_child(arena, node, v[4].node);
+            if (action == LALR_ACAO_SE_SENAO) add_child(arena, node, v[6].node);
+            return node;
+
+        case LALR_ACAO_RETORNO_VAZIO:
+        case LALR_ACAO_RETORNO:
+            node = new_node(arena, NODE_RETURN_STMT, NULL, tokens[v[0].first_token].line);
+            if (action == LALR_ACAO_RETORNO) add_child(arena, node, v[1].node);
+            return node;
+
+        case LALR_ACAO_COMANDO_EXPRESSAO:
+            node = new_node(arena, NODE_EXPRESSION_STMT, NULL, tokens[v[0].first_token].line);
+            add_child(arena, node, v[0].node);
+            return node;
+
+        case LALR_ACAO_COMANDO_VAZIO:
+            return new_node(arena, NODE_EXPRESSION_STMT, NULL, tokens[v[0].first_token].line);
+
+        case LALR_ACAO_ATRIBUICAO:
+            node = new_node(arena, NODE_ASSIGN, "=", tokens[v[1].first_token].line);
+            node->left = v[0].node;
+            node->right = v[2].node;
+            return node;
+
+        case LALR_ACAO_BINARIO:
+            node = new_node(arena, NODE_BINARY_OP, tokens[v[1].first_token].lexeme,
+                            tokens[v[1].first_token].line);
+            node->left = v[0].node;
+            node->right = v[2].node;
+            return node;
+
+        case LALR_ACAO_UNARIO:
+            node = new_node(arena, NODE_UNARY_OP, tokens[v[0].first_token].lexeme,
+                            tokens[v[0].first_token].line);
+            node->left = v[1].node;
+            return node;
+
+        case LALR_ACAO_NUMERO:
+        case LALR_ACAO_IDENTIFICADOR:
+            return new_node(arena, action == LALR_ACAO_NUMERO ? NODE_NUMBER : NODE_IDENTIFIER,
+                            tokens[v[0].first_token].lexeme, tokens[v[0].first_token].line);
+
+        case LALR_ACAO_CHAMADA:
+            // A lista de argumentos vira a própria chamada
+            node = v[2].node;
+            node->type = NODE_FUNC_CALL;
+            node->value = arena_strdup(arena, tokens[v[0].first_token].lexeme);
+            node->line = tokens[v[0].first_token].line;
+            return node;
+
+        default:
+            return length > 0 ? v[0].node : NULL;
+    }
+}
+
+/*
+ * Analisa os tokens (terminados por TOKEN_EOF) e devolve a AST montada na
+ * arena, ou NULL no primeiro erro sintático. Em stats (opcional) ficam os
+ * números de shifts e reduções e a profundidade máxima da pilha.
+ */
+ASTNode* lalr_parse(const Token* tokens, int token_count, Arena* arena, int report_errors, LALRStats* stats) {
+    int capacity = LALR_INITIAL_STACK;
+    int16_t* states = malloc(capacity * sizeof(int16_t));
+    LALRValue* values = malloc(capacity * sizeof(LALRValue));
+    int top = 0, max_depth = 1;
+    long shifts = 0, reductions = 0;
+    int position = 0;
+    ASTNode* result = NULL;
+
+    states[0] = 0;
+    values[0] = (LALRValue){NULL, 0};
+
+    while (1) {
+        int type = position < token_count ? (int)tokens[position].type : TOKEN_EOF;
+        int action = lalr_action(states[top], type);
+
+        if (action > 0) {
+            if (top + 1 == capacity) {
+                capacity *= 2;
+                states = realloc(states, capacity * sizeof(int16_t));
+                values = realloc(values, capacity * sizeof(LALRValue));
+            }
+            top++;
+            states[top] = (int16_t)(action - 1);
+            values[top] = (LALRValue){NULL, position};
+            if (top + 1 > max_depth) max_depth = top + 1;
+            position++;
+            shifts++;
+            continue;
+        }
+
+        if (action == 0) {
+            if (report_errors) {
+                static const Token eof = {TOKEN_EOF, "EOF", 0, 0, 0, 0};
+                const Token* token = position < token_count ? &tokens[position] : &eof;
+                char expected[160];
+                expected_tokens(states[top], expected, sizeof(expected));
+                printf("Erro sintático na linha %d, coluna %d: Esperado %s (token: '%s')\n",
+                       token->line, token->column, expected[0] ? expected : "outro token", token->lexeme);
+            }
+            break;
+        }
+
+        int production = -action - 1;
+        if (production == LALR_ACCEPT) {
+            result = values[top].node;
+            break;
+        }
+
+        int length = lalr_rhs_length[production];
+        const LALRValue* rhs = &values[top - length + 1];
+        LALRValue value;
+        value.first_token = length > 0 ? rhs[0].first_token : position;
+        value.node = reduce_action(lalr_action_of[production], rhs, length, tokens, arena);
+        reductions++;
+
+        top -= length;
+        int target = lalr_goto(states[top], lalr_lhs[production]);
+        if (top + 1 == capacity) {
+            capacity *= 2;
+            states = realloc(states, capacity * sizeof(int16_t));
+            values = realloc(values, capacity * sizeof(LALRValue));
+        }
+        top++;
+        states[top] = (int16_t)target;
+        values[top] = value;
+        if (top + 1 > max_depth) max_depth = top + 1;
+    }
+
+    if (stats) {
+        stats->shifts = shifts;
+        stats->reductions = reductions;
+        stats->max_stack_depth = max_depth;
+        stats->stack_bytes = capacity * (sizeof(int16_t) + sizeof(LALRValue));
+        stats->tokens_consumed = position;
+    }
+
+    free(states);
+    free(values);
+    return result;
+}
+
+// Memória ocupada pelas tabelas geradas
+size_t lalr_table_bytes(void) {
+    return sizeof(lalr_action_base) + sizeof(lalr_action_value) + sizeof(lalr_action_check) +
+           sizeof(lalr_default_reduce) + sizeof(lalr_goto_base) + sizeof(lalr_goto_value) +
+           sizeof(lalr_goto_check) + sizeof(lalr_default_goto) + sizeof(lalr_lhs) +
+           sizeof(lalr_rhs_length) + sizeof(lalr_action_of);
+}
@@ -0,0 +1,686 @@
+/*
+ * Gerador de tabelas LALR(1)
+ *
+ * Lê uma gramática com ações semânticas (gramaticas/linguagem.lalr) e grava
+ * as tabelas ACTION e GOTO comprimidas como um cabeçalho C usado pelo
+ * driver de lalr.c:
+ *
+ *     lalrgen gramaticas/linguagem.lalr -o build/tabela_lalr.h
+ *
+ * Construção:
+ *   1. coleção canônica de conjuntos de itens LR(0) (só os núcleos são
+ *      guardados; o fechamento é recalculado quando necessário);
+ *   2. lookaheads LALR(1) pelo método de propagação (livro do dragão,
+ *      alg. 4.62): para cada item do núcleo, o fechamento LR(1) de
+ *      [item, #] diz quais lookaheads nascem espontaneamente em cada
+ *      estado sucessor e quais se propagam; depois, ponto fixo;
+ *   3. ACTION/GOTO. Conflitos shift/reduce ficam com o shift (else
+ *      pendente) e reduce/reduce com a produção escrita primeiro; todos
+ *      são reportados.
+ *
+ * Compressão (para que as tabelas caibam na cache L1/L2):
+ *   - redução padrão: em cada estado, a redução mais frequente sai da
+ *     linha e vira default_reduce[estado]; o erro é detectado antes do
+ *     próximo shift;
+ *   - GOTO por não terminal, com o estado destino mais frequente como
+ *     padrão;
+ *   - as linhas restantes, esparsas, são sobrepostas em um único vetor por
+ *     deslocamento de linhas (row displacement): a linha r começa em
+ *     base[r] e a posição base[r] + coluna só vale se check[...] == r.
+ */
+
+#include "../include/gramatica.h"
+
+#define END_MARKER_BIT ((TerminalSet)1 << 63)   // o '#' do método de propagação
+#define ITEM(prod, dot) (((prod) << 8) | (dot))
+#define ITEM_PROD(item) ((item) >> 8)
+#define ITEM_DOT(item) ((item) & 0xff)
+
+typedef struct {
+    int* kernel;        // itens do núcleo, ordenados
+    int kernel_count;
+    TerminalSet* lookahead;   // um conjunto por item do núcleo
+    uint32_t hash;
+} State;
+
+typedef struct {
+    Grammar* grammar;
+    int symbol_count;
+    int accept_production;    // S' -> inicial
+
+    State* states;
+    int state_count;
+    int state_capacity;
+    int* transitions;         // [estado][símbolo] -> estado (-1 = nenhum)
+} Automaton;
+
+// Ligação de propagação: lookaheads do item (from_state, from_item) fluem para (to_state, to_item)
+typedef struct {
+    int from_state, from_item;
+    int to_state, to_item;
+} Propagation;
+
+// Linha esparsa para a compressão
+typedef struct {
+    int* columns;
+    int* values;
+    int count;
+} SparseRow;
+
+typedef struct {
+    int* base;
+    int* value;
+    int* check;
+    int size;
+} PackedTable;
+
+// ==================== ITENS LR(0) ====================
+
+static int symbol_after_dot(const Grammar* grammar, int item) {
+    const Production* p = &grammar->productions[ITEM_PROD(item)];
+    return ITEM_DOT(item) < p->length ? p->rhs[ITEM_DOT(item)] : -1;
+}
+
+/*
+ * Fechamento LR(0): acrescenta ao núcleo os itens B -> .γ de todo não
+ * terminal B que aparece depois de um ponto. Devolve o número de itens.
+ */
+static int closure(const Grammar* grammar, const int* kernel, int kernel_count, int* items, char* added) {
+    int count = 0;
+    memset(added, 0, grammar->nonterminal_count);
+    for (int i = 0; i < kernel_count; i++) items[count++] = kernel[i];
+
+    for (int i = 0; i < count; i++) {
+        int symbol = symbol_after_dot(grammar, items[i]);
+        if (symbol < GRAMMAR_TERMINALS) continue;
+        int n = symbol - GRAMMAR_TERMINALS;
+        if (added[n]) continue;
+        added[n] = 1;
+        for (int p = 0; p < grammar->production_count; p++) {
+            if (grammar->productions[p].lhs == n) items[count++] = ITEM(p, 0);
+        }
+    }
+    return count;
+}
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t hash_kernel(const int* kernel, int count) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < count; i++) hash = (hash ^ (uint32_t)kernel[i]) * 16777619u;
+    return hash;
+}
+
+// Estado com o núcleo dado (ordenado), criado se ainda não existir
+static int find_or_add_state(Automaton* automaton, const int* kernel, int count) {
+    uint32_t hash = hash_kernel(kernel, count);
+    for (int s = 0; s < automaton->state_count; s++) {
+        const State* state = &automaton->states[s];
+        if (state->hash == hash && state->kernel_count == count &&
+            memcmp(state->kernel, kernel, count * sizeof(int)) == 0) {
+            return s;
+        }
+    }
+
+    if (automaton->state_count == automaton->state_capacity) {
+        automaton->state_capacity *= 2;
+        automaton->states = realloc(automaton->states, automaton->state_capacity * sizeof(State));
+        automaton->transitions = realloc(automaton->transitions,
+                                         automaton->state_capacity * automaton->symbol_count * sizeof(int));
+    }
+    int s = automaton->state_count++;
+    State* state = &automaton->states[s];
+    state->kernel = malloc(count * sizeof(int));
+    memcpy(state->kernel, kernel, count * sizeof(int));
+    state->kernel_count = count;
+    state->lookahead = calloc(count, sizeof(TerminalSet));
+    state->hash = hash;
+    for (int x = 0; x < automaton->symbol_count; x++) {
+        automaton->transitions[s * automaton->symbol_count + x] = -1;
+    }
+    return s;
+}
+
+static void build_lr0_states(Automaton* automaton) {
+    Grammar* grammar = automaton->grammar;
+    int max_items = grammar->production_count * 64 + 64;
+    int* items = malloc(max_items * sizeof(int));
+    int* next_kernel = malloc(max_items * sizeof(int));
+    char* added = malloc(grammar->nonterminal_count);
+
+    int start = ITEM(automaton->accept_production, 0);
+    find_or_add_state(automaton, &start, 1);
+
+    // Os estados novos entram no fim do vetor: a própria iteração é a fila
+    for (int s = 0; s < automaton->state_count; s++) {
+        int count = closure(grammar, automaton->states[s].kernel, automaton->states[s].kernel_count,
+                            items, added);
+
+        for (int x = 0; x < automaton->symbol_count; x++) {
+            int next_count = 0;
+            for (int i = 0; i < count; i++) {
+                if (symbol_after_dot(grammar, items[i]) == x) next_kernel[next_count++] = items[i] + 1;
+            }
+            if (next_count == 0) continue;
+            qsort(next_kernel, next_count, sizeof(int), compare_ints);
+            int target = find_or_add_state(automaton, next_kernel, next_count);
+            automaton->transitions[s * automaton->symbol_count + x] = target;
+        }
+    }
+
+    free(added);
+    free(next_kernel);
+    free(items);
+}
+
+static int kernel_index(const State* state, int item) {
+    const int* found = bsearch(&item, state->kernel, state->kernel_count, sizeof(int), compare_ints);
+    return found ? (int)(found - state->kernel) : -1;
+}
+
+// ==================== LOOKAHEADS LALR(1) ====================
+
+/*
+ * Fechamento LR(1) de itens do núcleo com lookaheads dados. Os itens
+ * não-núcleo têm ponto na posição 0 e são indexados pela produção:
+ * nonkernel[p] é o lookahead de B -> .γ (0 = item ausente).
+ */
+static void closure_lookaheads(const Grammar* grammar, const State* state, const TerminalSet* kernel_la,
+                               TerminalSet* nonkernel) {
+    memset(nonkernel, 0, grammar->production_count * sizeof(TerminalSet));
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        int total = state->kernel_count + grammar->production_count;
+        for (int i = 0; i < total; i++) {
+            int item;
+            TerminalSet la;
+            if (i < state->kernel_count) {
+                item = state->kernel[i];
+                la = kernel_la[i];
+            } else {
+                item = ITEM(i - state->kernel_count, 0);
+                la = nonkernel[i - state->kernel_count];
+            }
+            if (!la) continue;
+
+            int symbol = symbol_after_dot(grammar, item);
+            if (symbol < GRAMMAR_TERMINALS) continue;
+
+            // [A -> α.Bβ, L] gera [B -> .γ, FIRST(β L)]
+            const Production* p = &grammar->productions[ITEM_PROD(item)];
+            int nullable;
+            TerminalSet first = grammar_first_of(grammar, p->rhs + ITEM_DOT(item) + 1,
+                                                 p->length - ITEM_DOT(item) - 1, &nullable);
+            if (nullable) first |= la;
+
+            int n = symbol - GRAMMAR_TERMINALS;
+            for (int q = 0; q < grammar->production_count; q++) {
+                if (grammar->productions[q].lhs != n) continue;
+                if ((nonkernel[q] | first) != nonkernel[q]) {
+                    nonkernel[q] |= first;
+                    changed = 1;
+                }
+            }
+        }
+    }
+}
+
+static void compute_lookaheads(Automaton* automaton) {
+    Grammar* grammar = automaton->grammar;
+    TerminalSet* nonkernel = malloc(grammar->production_count * sizeof(TerminalSet));
+    int prop_capacity = 1024, prop_count = 0;
+    Propagation* props = malloc(prop_capacity * sizeof(Propagation));
+
+    automaton->states[0].lookahead[0] = (TerminalSet)1 << TOKEN_EOF;
+
+    for (int s = 0; s < automaton->state_count; s++) {
+        const State* state = &automaton->states[s];
+        TerminalSet* kernel_la = calloc(state->kernel_count, sizeof(TerminalSet));
+
+        for (int k = 0; k < state->kernel_count; k++) {
+            memset(kernel_la, 0, state->kernel_count * sizeof(TerminalSet));
+            kernel_la[k] = END_MARKER_BIT;
+            closure_lookaheads(grammar, state, kernel_la, nonkernel);
+
+            int total = state->kernel_count + grammar->production_count;
+            for (int i = 0; i < total; i++) {
+                int item;
+                TerminalSet la;
+                if (i < state->kernel_count) {
+                    item = state->kernel[i];
+                    la = kernel_la[i];
+                } else {
+                    item = ITEM(i - state->kernel_count, 0);
+                    la = nonkernel[i - state->kernel_count];
+                }
+                int symbol = symbol_after_dot(grammar, item);
+                if (!la || symbol < 0) continue;
+
+                int target = automaton->transitions[s * automaton->symbol_count + symbol];
+                int index = kernel_index(&automaton->states[target], item + 1);
+
+                automaton->states[target].lookahead[index] |= la & ~END_MARKER_BIT;
+                if (la & END_MARKER_BIT) {
+                    if (prop_count == prop_capacity) {
+                        prop_capacity *= 2;
+                        props = realloc(props, prop_capacity * sizeof(Propagation));
+                    }
+                    props[prop_count++] = (Propagation){s, k, target, index};
+                }
+            }
+        }
+        free(kernel_la);
+    }
+
+    int changed = 1;
+    while (changed) {
+        changed = 0;
+        for (int i = 0; i < prop_count; i++) {
+            TerminalSet from = automaton->states[props[i].from_state].lookahead[props[i].from_item];
+            TerminalSet* to = &automaton->states[props[i].to_state].lookahead[props[i].to_item];
+            if ((*to | from) != *to) {
+                *to |= from;
+                changed = 1;
+            }
+        }
+    }
+
+    free(props);
+    free(nonkernel);
+}
+
+// ==================== ACTION E GOTO ====================
+
+// Codificação das ações: 0 = erro, v > 0 = shift para v - 1, v < 0 = reduce -v - 1
+static int build_actions(Automaton* automaton, int* actions, const char* filename) {
+    Grammar* grammar = automaton->grammar;
+    TerminalSet* nonkernel = malloc(grammar->production_count * sizeof(TerminalSet));
+    int conflicts = 0;
+
+    for (int s = 0; s < automaton->state_count; s++) {
+        const State* state = &automaton->states[s];
+        int* row = &actions[s * GRAMMAR_TERMINALS];
+        for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+            int target = automaton->transitions[s * automaton->symbol_count + t];
+            row[t] = target >= 0 ? target + 1 : 0;
+        }
+
+        closure_lookaheads(grammar, state, state->lookahead, nonkernel);
+
+        int total = state->kernel_count + grammar->production_count;
+        for (int i = 0; i < total; i++) {
+            int item;
+            TerminalSet la;
+            if (i < state->kernel_count) {
+                item = state->kernel[i];
+                la = state->lookahead[i];
+            } else {
+                item = ITEM(i - state->kernel_count, 0);
+                la = nonkernel[i - state->kernel_count];
+            }
+            if (symbol_after_dot(grammar, item) >= 0) continue;
+
+            int production = ITEM_PROD(item);
+            for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+                if (!(la & ((TerminalSet)1 << t))) continue;
+                int* cell = &row[t];
+                if (*cell == 0) {
+                    *cell = -production - 1;
+                    continue;
+                }
+
+                conflicts++;
+                if (*cell > 0) {
+                    fprintf(stderr, "%s:%d: conflito shift/reduce no estado %d com %s, mantido o shift; descartado: ",
+                            filename, grammar->productions[production].line, s,
+                            token_type_to_string((TokenType)t));
+                    grammar_print_production(grammar, production, stderr);
+                    fprintf(stderr, "\n");
+                } else {
+                    int other = -*cell - 1;
+                    int keep = other < production ? other : production;
+                    int drop = other < production ? production : other;
+                    fprintf(stderr, "%s:%d: conflito reduce/reduce no estado %d com %s\n  mantida:    ",
+                            filename, grammar->productions[drop].line, s, token_type_to_string((TokenType)t));
+                    grammar_print_production(grammar, keep, stderr);
+                    fprintf(stderr, "\n  descartada: ");
+                    grammar_print_production(grammar, drop, stderr);
+                    fprintf(stderr, "\n");
+                    *cell = -keep - 1;
+                }
+            }
+        }
+    }
+
+    free(nonkernel);
+    return conflicts;
+}
+
+// ==================== COMPRESSÃO ====================
+
+static const SparseRow* row_order_rows;  // linhas vistas por compare_rows
+
+static int compare_rows(const void* a, const void* b) {
+    const SparseRow* x = &row_order_rows[*(const int*)a];
+    const SparseRow* y = &row_order_rows[*(const int*)b];
+    if (x->count != y->count) return y->count - x->count;  // mais cheias primeiro
+    return *(const int*)a - *(const int*)b;
+}
+
+/*
+ * Sobrepõe as linhas esparsas em um único vetor (row displacement). As
+ * linhas mais cheias são encaixadas primeiro; cada uma vai para o menor
+ * deslocamento em que todas as suas colunas caiam em posições livres. O
+ * vetor final tem 'columns' posições extras para que base + coluna nunca
+ * saia dos limites.
+ */
+static PackedTable pack_rows(const SparseRow* rows, int row_count, int columns) {
+    int capacity = 1024;
+    PackedTable table;
+    table.base = malloc(row_count * sizeof(int));
+    table.value = malloc(capacity * sizeof(int));
+    table.check = malloc(capacity * sizeof(int));
+    for (int i = 0; i < capacity; i++) table.check[i] = -1;
+    table.size = 0;
+
+    int* order = malloc(row_count * sizeof(int));
+    for (int r = 0; r < row_count; r++) order[r] = r;
+    row_order_rows = rows;
+    qsort(order, row_count, sizeof(int), compare_rows);
+
+    for (int o = 0; o < row_count; o++) {
+        const SparseRow* row = &rows[order[o]];
+        int base = 0;
+        while (1) {
+            int fits = 1;
+            for (int i = 0; i < row->count && fits; i++) {
+                int position = base + row->columns[i];
+                fits = position >= capacity || table.check[position] == -1;
+            }
+            if (fits) break;
+            base++;
+        }
+
+        while (base + columns > capacity) {
+            table.value = realloc(table.value, capacity * 2 * sizeof(int));
+            table.check = realloc(table.check, capacity * 2 * sizeof(int));
+            for (int i = capacity; i < capacity * 2; i++) table.check[i] = -1;
+            capacity *= 2;
+        }
+
+        table.base[order[o]] = base;
+        for (int i = 0; i < row->count; i++) {
+            table.value[base + row->columns[i]] = row->values[i];
+            table.check[base + row->columns[i]] = order[o];
+        }
+        if (base + columns > table.size) table.size = base + columns;
+    }
+
+    for (int i = 0; i < table.size; i++) {
+        if (table.check[i] == -1) table.value[i] = 0;
+    }
+    free(order);
+    return table;
+}
+
+static void free_rows(SparseRow* rows, int count) {
+    for (int r = 0; r < count; r++) {
+        free(rows[r].columns);
+        free(rows[r].values);
+    }
+    free(rows);
+}
+
+static void row_add(SparseRow* row, int column, int value) {
+    row->columns[row->count] = column;
+    row->values[row->count] = value;
+    row->count++;
+}
+
+// ==================== SAÍDA ====================
+
+static void write_array(FILE* out, const char* type, const char* name, const int* values, int count) {
+    fprintf(out, "static const %s %s[%d] = {", type, name, count);
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%s%s%d", i ? "," : "", i % 20 == 0 ? "\n    " : "", values[i]);
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+static void action_enum_name(const char* action, char* buffer) {
+    int i = 0;
+    for (; action[i] && i < GRAMMAR_MAX_NAME - 1; i++) buffer[i] = toupper((unsigned char)action[i]);
+    buffer[i] = '\0';
+}
+
+/*
+ * Numera as ações distintas na ordem da primeira ocorrência (0 = sem ação).
+ * names recebe os nomes; devolve quantas há.
+ */
+static int number_actions(const Grammar* grammar, int* ids, const char** names) {
+    int count = 0;
+    for (int p = 0; p < grammar->production_count; p++) {
+        const char* action = grammar->productions[p].action;
+        ids[p] = 0;
+        if (!action[0]) continue;
+        for (int a = 0; a < count && !ids[p]; a++) {
+            if (strcmp(names[a], action) == 0) ids[p] = a + 1;
+        }
+        if (!ids[p]) {
+            names[count++] = action;
+            ids[p] = count;
+        }
+    }
+    return count;
+}
+
+static int write_tables(const Automaton* automaton, const int* actions, const char* output,
+                        const char* source, size_t* compressed_bytes) {
+    const Grammar* grammar = automaton->grammar;
+    int states = automaton->state_count;
+    int nonterminals = grammar->nonterminal_count;
+
+    // ACTION: tira a redução mais frequente de cada linha
+    int* default_reduce = calloc(states, sizeof(int));
+    int* reduce_count = calloc(grammar->production_count, sizeof(int));
+    SparseRow* action_rows = calloc(states, sizeof(SparseRow));
+    for (int s = 0; s < states; s++) {
+        const int* row = &actions[s * GRAMMAR_TERMINALS];
+        memset(reduce_count, 0, grammar->production_count * sizeof(int));
+        int best = -1;
+        for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+            if (row[t] < 0 && -row[t] - 1 != automaton->accept_production) {
+                int p = -row[t] - 1;
+                if (++reduce_count[p] > (best >= 0 ? reduce_count[best] : 0)) best = p;
+            }
+        }
+        default_reduce[s] = best >= 0 ? best + 1 : 0;
+
+        action_rows[s].columns = malloc(GRAMMAR_TERMINALS * sizeof(int));
+        action_rows[s].values = malloc(GRAMMAR_TERMINALS * sizeof(int));
+        for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+            if (row[t] == 0 || (best >= 0 && row[t] == -best - 1)) continue;
+            row_add(&action_rows[s], t, row[t]);
+        }
+    }
+    PackedTable action_table = pack_rows(action_rows, states, GRAMMAR_TERMINALS);
+
+    // GOTO: linhas por não terminal, com o destino mais frequente como padrão
+    int* default_goto = calloc(nonterminals, sizeof(int));
+    int* target_count = calloc(states, sizeof(int));
+    SparseRow* goto_rows = calloc(nonterminals, sizeof(SparseRow));
+    for (int n = 0; n < nonterminals; n++) {
+        memset(target_count, 0, states * sizeof(int));
+        int best = 0;
+        for (int s = 0; s < states; s++) {
+            int target = automaton->transitions[s * automaton->symbol_count + GRAMMAR_TERMINALS + n];
+            if (target >= 0 && ++target_count[target] > target_count[best]) best = target;
+        }
+        default_goto[n] = best;
+
+        goto_rows[n].columns = malloc(states * sizeof(int));
+        goto_rows[n].values = malloc(states * sizeof(int));
+        for (int s = 0; s < states; s++) {
+            int target = automaton->transitions[s * automaton->symbol_count + GRAMMAR_TERMINALS + n];
+            if (target >= 0 && target != best) row_add(&goto_rows[n], s, target);
+        }
+    }
+    PackedTable goto_table = pack_rows(goto_rows, nonterminals, states);
+
+    *compressed_bytes = (states * 2 + action_table.size * 2) * sizeof(int16_t) +
+                        (nonterminals * 2 + goto_table.size * 2) * sizeof(int16_t);
+
+    FILE* out = fopen(output, "w");
+    int ok = out != NULL;
+    if (!out) {
+        fprintf(stderr, "Erro: não foi possível criar o arquivo '%s'\n", output);
+    } else {
+        fprintf(out, "/* Gerado por lalrgen a partir de %s. Não edite. */\n\n", source);
+        fprintf(out, "#define LALR_TERMINALS %d\n", GRAMMAR_TERMINALS);
+        fprintf(out, "#define LALR_NONTERMINALS %d\n", nonterminals);
+        fprintf(out, "#define LALR_STATES %d\n", states);
+        fprintf(out, "#define LALR_PRODUCTIONS %d\n", grammar->production_count);
+        fprintf(out, "#define LALR_ACCEPT %d\n\n", automaton->accept_production);
+
+        // Ações semânticas, na ordem da primeira ocorrência
+        int* action = malloc(grammar->production_count * sizeof(int));
+        const char** action_names = malloc(grammar->production_count * sizeof(char*));
+        int action_count = number_actions(grammar, action, action_names);
+        fprintf(out, "enum {\n    LALR_ACAO_NENHUMA");
+        for (int a = 0; a < action_count; a++) {
+            char name[GRAMMAR_MAX_NAME];
+            action_enum_name(action_names[a], name);
+            fprintf(out, ",\n    LALR_ACAO_%s", name);
+        }
+        fprintf(out, "\n};\n\n");
+        free(action_names);
+
+        int* lhs = malloc(grammar->production_count * sizeof(int));
+        int* length = malloc(grammar->production_count * sizeof(int));
+        for (int p = 0; p < grammar->production_count; p++) {
+            lhs[p] = grammar->productions[p].lhs;
+            length[p] = grammar->productions[p].length;
+        }
+        write_array(out, "uint8_t", "lalr_lhs", lhs, grammar->production_count);
+        write_array(out, "uint8_t", "lalr_rhs_length", length, grammar->production_count);
+        write_array(out, "uint8_t", "lalr_action_of", action, grammar->production_count);
+        free(lhs);
+        free(length);
+        free(action);
+
+        fprintf(out, "// ACTION: v > 0 = shift para v - 1, v < 0 = reduce -v - 1, 0 = erro\n");
+        fprintf(out, "// (posição lalr_action_base[s] + token, válida se lalr_action_check[...] == s)\n");
+        write_array(out, "int16_t", "lalr_action_base", action_table.base, states);
+        write_array(out, "int16_t", "lalr_action_value", action_table.value, action_table.size);
+        write_array(out, "int16_t", "lalr_action_check", action_table.check, action_table.size);
+        fprintf(out, "// Redução padrão de cada estado (produção + 1, 0 = nenhuma)\n");
+        write_array(out, "int16_t", "lalr_default_reduce", default_reduce, states);
+
+        fprintf(out, "// GOTO: posição lalr_goto_base[n] + estado, válida se lalr_goto_check[...] == n\n");
+        write_array(out, "int16_t", "lalr_goto_base", goto_table.base, nonterminals);
+        write_array(out, "int16_t", "lalr_goto_value", goto_table.value, goto_table.size);
+        write_array(out, "int16_t", "lalr_goto_check", goto_table.check, goto_table.size);
+        write_array(out, "int16_t", "lalr_default_goto", default_goto, nonterminals);
+
+        if (fclose(out) != 0) {
+            fprintf(stderr, "Erro: falha ao gravar o arquivo '%s'\n", output);
+            ok = 0;
+        }
+    }
+
+    free(action_table.base);
+    free(action_table.value);
+    free(action_table.check);
+    free(goto_table.base);
+    free(goto_table.value);
+    free(goto_table.check);
+    free_rows(action_rows, states);
+    free_rows(goto_rows, nonterminals);
+    free(default_reduce);
+    free(reduce_count);
+    free(default_goto);
+    free(target_count);
+    return ok;
+}
+
+// ==================== PROGRAMA ====================
+
+int main(int argc, char* argv[]) {
+    const char* grammar_file = NULL;
+    const char* output = NULL;
+    int strict = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--estrito") == 0) {
+            strict = 1;
+        } else if (argv[i][0] != '-' && !grammar_file) {
+            grammar_file = argv[i];
+        } else {
+            grammar_file = NULL;
+            break;
+        }
+    }
+
+    if (!grammar_file) {
+        printf("Uso: %s gramatica.lalr [-o tabela.h] [--estrito]\n", argv[0]);
+        return 1;
+    }
+
+    Grammar* grammar = grammar_load(grammar_file);
+    if (!grammar) return 1;
+
+    // Gramática aumentada: S' -> S, aceita com EOF
+    int start_symbol = GRAMMAR_TERMINALS + grammar->productions[0].lhs;
+    int augmented = grammar_nonterminal(grammar, "inicio'", 0);
+    grammar->defined[augmented] = 1;
+    grammar_add_production(grammar, augmented, &start_symbol, 1, 0, NULL);
+
+    grammar_compute_first(grammar);
+
+    Automaton automaton;
+    automaton.grammar = grammar;
+    automaton.symbol_count = GRAMMAR_TERMINALS + grammar->nonterminal_count;
+    automaton.accept_production = grammar->production_count - 1;
+    automaton.state_count = 0;
+    automaton.state_capacity = 256;
+    automaton.states = malloc(automaton.state_capacity * sizeof(State));
+    automaton.transitions = malloc(automaton.state_capacity * automaton.symbol_count * sizeof(int));
+
+    build_lr0_states(&automaton);
+    compute_lookaheads(&automaton);
+
+    int* actions = malloc(automaton.state_count * GRAMMAR_TERMINALS * sizeof(int));
+    int conflicts = build_actions(&automaton, actions, grammar_file);
+
+    size_t dense_bytes = (size_t)automaton.state_count * automaton.symbol_count * sizeof(int16_t);
+    size_t compressed_bytes = 0;
+    int ok = !(strict && conflicts > 0);
+    if (ok && output) {
+        ok = write_tables(&automaton, actions, output, grammar_file, &compressed_bytes);
+    }
+
+    printf("%s: %d não terminais, %d produções, %d estados LALR(1), %d conflito(s)\n",
+           grammar_file, grammar->nonterminal_count - 1, grammar->production_count - 1,
+           automaton.state_count, conflicts);
+    if (compressed_bytes) {
+        printf("Tabelas ACTION/GOTO: %zu bytes densas, %zu bytes comprimidas\n",
+               dense_bytes, compressed_bytes);
+    }
+
+    for (int s = 0; s < automaton.state_count; s++) {
+        free(automaton.states[s].kernel);
+        free(automaton.states[s].lookahead);
+    }
+    free(automaton.states);
+    free(automaton.transitions);
+    free(actions);
+    grammar_free(grammar);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+#include "../include/parser.h"
+
+// Tabela de palavras-chave
+static const char* keywords[] = {"int", "float", "char", "if", "else", "while", "return"};
+static const TokenType keyword_tokens[] = {TOKEN_INT, TOKEN_FLOAT, TOKEN_CHAR, TOKEN_IF,
+                                           TOKEN_ELSE, TOKEN_WHILE, TOKEN_RETURN};
+static const int num_keywords = sizeof(keywords) / sizeof(keywords[0]);
+
+void init_lexer(Lexer* lexer, const char* input) {
+    lexer->input = input;
+    lexer->position = 0;
+    lexer->line = 1;
+    lexer->column = 1;
+    lexer->length = strlen(input);
+    lexer->unterminated = 0;
+}
+
+static char peek_char(Lexer* lexer) {
+    if (lexer->position >= lexer->length) return '\0';
+    return lexer->input[lexer->position];
+}
+
+static char peek_next(Lexer* lexer) {
+    if (lexer->position + 1 >= lexer->length) return '\0';
+    return lexer->input[lexer->position + 1];
+}
+
+static char advance_char(Lexer* lexer) {
+    if (lexer->position >= lexer->length) return '\0';
+    char ch = lexer->input[lexer->position++];
+    if (ch == '\n') {
+        lexer->line++;
+        lexer->column = 1;
+    } else {
+        lexer->column++;
+    }
+    return ch;
+}
+
+static void skip_whitespace(Lexer* lexer) {
+    while (isspace((unsigned char)peek_char(lexer))) {
+        advance_char(lexer);
+    }
+}
+
+static void skip_comment(Lexer* lexer) {
+    if (peek_next(lexer) == '/') {
+        // Comentário de linha
+        while (peek_char(lexer) != '\n' && peek_char(lexer) != '\0') {
+            advance_char(lexer);
+        }
+    } else {
+        // Comentário de bloco
+        advance_char(lexer); // /
+        advance_char(lexer); // *
+        while (1) {
+            if (peek_char(lexer) == '\0') {
+                lexer->unterminated = 1;
+                break;
+            }
+            char ch = advance_char(lexer);
+            if (ch == '*' && peek_char(lexer) == '/') {
+                advance_char(lexer);
+                break;
+            }
+        }
+    }
+}
+
+static TokenType get_keyword_token(const char* word) {
+    for (int i = 0; i < num_keywords; i++) {
+        if (strcmp(word, keywords[i]) == 0) {
+            return keyword_tokens[i];
+        }
+    }
+    return TOKEN_IDENTIFIER;
+}
+
+// Token de um ou dois caracteres: consome 'length' caracteres da entrada
+static Token make_operator(Lexer* lexer, Token token, TokenType type, int length) {
+    token.type = type;
+    for (int i = 0; i < length; i++) {
+        token.lexeme[i] = advance_char(lexer);
+    }
+    token.lexeme[length] = '\0';
+    return token;
+}
+
+static Token scan_token(Lexer* lexer, Token token) {
+    char ch = peek_char(lexer);
+
+    // Fim do arquivo
+    if (ch == '\0') {
+        token.type = TOKEN_EOF;
+        strcpy(token.lexeme, "EOF");
+        return token;
+    }
+
+    // Identificadores e palavras-chave
+    if (isalpha((unsigned char)ch) || ch == '_') {
+        int i = 0;
+        while (isalnum((unsigned char)peek_char(lexer)) || peek_char(lexer) == '_') {
+            char c = advance_char(lexer);
+            if (i < MAX_TOKEN_LENGTH - 1) token.lexeme[i++] = c;
+        }
+        token.lexeme[i] = '\0';
+        token.type = get_keyword_token(token.lexeme);
+        return token;
+    }
+
+    // Números
+    if (isdigit((unsigned char)ch)) {
+        int i = 0;
+        while (isdigit((unsigned char)peek_char(lexer))) {
+            char c = advance_char(lexer);
+            if (i < MAX_TOKEN_LENGTH - 1) token.lexeme[i++] = c;
+        }
+        token.lexeme[i] = '\0';
+        token.type = TOKEN_NUMBER;
+        return token;
+    }
+
+    // Strings
+    if (ch == '"') {
+        int i = 0;
+        token.lexeme[i++] = advance_char(lexer); // aspas de abertura
+        while (peek_char(lexer) != '"' && peek_char(lexer) != '\0') {
+            char c = advance_char(lexer);
+            if (i < MAX_TOKEN_LENGTH - 3) token.lexeme[i++] = c;
+            if (c == '\\' && peek_char(lexer) != '\0') {
+                c = advance_char(lexer);
+                if (i < MAX_TOKEN_LENGTH - 3) token.lexeme[i++] = c;
+            }
+        }
+        if (peek_char(lexer) == '"') {
+            token.lexeme[i++] = advance_char(lexer); // aspas de fechamento
+        } else {
+            lexer->unterminated = 1;
+        }
+        token.lexeme[i] = '\0';
+        token.type = TOKEN_STRING;
+        return token;
+    }
+
+    // Operadores e delimitadores
+    char next = peek_next(lexer);
+
+    switch (ch) {
+        case '=': return next == '=' ? make_operator(lexer, token, TOKEN_EQ, 2)
+                                     : make_operator(lexer, token, TOKEN_ASSIGN, 1);
+        case '!': return next == '=' ? make_operator(lexer, token, TOKEN_NE, 2)
+                                     : make_operator(lexer, token, TOKEN_NOT, 1);
+        case '<': return next == '=' ? make_operator(lexer, token, TOKEN_LE, 2)
+                                     : make_operator(lexer, token, TOKEN_LT, 1);
+        case '>': return next == '=' ? make_operator(lexer, token, TOKEN_GE, 2)
+                                     : make_operator(lexer, token, TOKEN_GT, 1);
+        case '&': return next == '&' ? make_operator(lexer, token, TOKEN_AND, 2)
+                                     : make_operator(lexer, token, TOKEN_ERROR, 1);
+        case '|': return next == '|' ? make_operator(lexer, token, TOKEN_OR, 2)
+                                     : make_operator(lexer, token, TOKEN_ERROR, 1);
+        case '+': return make_operator(lexer, token, TOKEN_PLUS, 1);
+        case '-': return make_operator(lexer, token, TOKEN_MINUS, 1);
+        case '*': return make_operator(lexer, token, TOKEN_MULTIPLY, 1);
+        case '/': return make_operator(lexer, token, TOKEN_DIVIDE, 1);
+        case '%': return make_operator(lexer, token, TOKEN_MODULO, 1);
+        case ';': return make_operator(lexer, token, TOKEN_SEMICOLON, 1);
+        case ',': return make_operator(lexer, token, TOKEN_COMMA, 1);
+        case '(': return make_operator(lexer, token, TOKEN_LPAREN, 1);
+        case ')': return make_operator(lexer, token, TOKEN_RPAREN, 1);
+        case '{': return make_operator(lexer, token, TOKEN_LBRACE, 1);
+        case '}': return make_operator(lexer, token, TOKEN_RBRACE, 1);
+        default:
+            // Caractere inválido: consome para não travar o lexer
+            return make_operator(lexer, token, TOKEN_ERROR, 1);
+    }
+}
+
+Token get_next_token(Lexer* lexer) {
+    Token token;
+
+    // Pula espaços e comentários
+    while (1) {
+        skip_whitespace(lexer);
+        if (peek_char(lexer) == '/' && (peek_next(lexer) == '/' || peek_next(lexer) == '*')) {
+            skip_comment(lexer);
+        } else {
+            break;
+        }
+    }
+
+    token.line = lexer->line;
+    token.column = lexer->column;
+    token.position = lexer->position;
+
+    token = scan_token(lexer, token);
+    token.length = lexer->position - token.position;
+    return token;
+}
+
+/*
+ * Converte a entrada inteira em um vetor de tokens terminado por TOKEN_EOF.
+ * O vetor cresce por duplicação, sem limite fixo de tokens.
+ */
+Token* tokenize(const char* input, int* token_count) {
+    Lexer lexer;
+    init_lexer(&lexer, input);
+
+    int capacity = 256;
+    Token* tokens = malloc(capacity * sizeof(Token));
+    *token_count = 0;
+
+    Token token;
+    do {
+        token = get_next_token(&lexer);
+        if (token.type == TOKEN_ERROR) {
+            fprintf(stderr, "Erro léxico na linha %d, coluna %d: caractere inválido '%s'\n",
+                    token.line, token.column, token.lexeme);
+            continue;
+        }
+        if (*token_count == capacity) {
+            capacity *= 2;
+            tokens = realloc(tokens, capacity * sizeof(Token));
+        }
+        tokens[(*token_count)++] = token;
+    } while (token.type != TOKEN_EOF);
+
+    return tokens;
+}
+
+const char* token_type_to_string(TokenType type) {
+    switch (type) {
+        case TOKEN_NUMBER: return "NUMBER";
+        case TOKEN_IDENTIFIER: return "IDENTIFIER";
+        case TOKEN_STRING: return "STRING";
+        case TOKEN_INT: return "INT";
+        case TOKEN_FLOAT: return "FLOAT";
+        case TOKEN_CHAR: return "CHAR";
+        case TOKEN_IF: return "IF";
+        case TOKEN_ELSE: return "ELSE";
+        case TOKEN_WHILE: return "WHILE";
+        case TOKEN_RETURN: return "RETURN";
+        case TOKEN_ASSIGN: return "ASSIGN";
+        case TOKEN_PLUS: return "PLUS";
+        case TOKEN_MINUS: return "MINUS";
+        case TOKEN_MULTIPLY: return "MULTIPLY";
+        case TOKEN_DIVIDE: return "DIVIDE";
+        case TOKEN_MODULO: return "MODULO";
+        case TOKEN_EQ: return "EQ";
+        case TOKEN_NE: return "NE";
+        case TOKEN_LT: return "LT";
+        case TOKEN_LE: return "LE";
+        case TOKEN_GT: return "GT";
+        case TOKEN_GE: return "GE";
+        case TOKEN_AND: return "AND";
+        case TOKEN_OR: return "OR";
+        case TOKEN_NOT: return "NOT";
+        case TOKEN_SEMICOLON: return "SEMICOLON";
+        case TOKEN_COMMA: return "COMMA";
+        case TOKEN_LPAREN: return "LPAREN";
+        case TOKEN_RPAREN: return "RPAREN";
+        case TOKEN_LBRACE: return "LBRACE";
+        case TOKEN_RBRACE: return "RBRACE";
+        case TOKEN_EOF: return "EOF";
+        default: return "ERROR";
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ * Parser LL(1) dirigido por tabela
+ *
+ * Em vez de uma função por não terminal (parser.c), uma pilha explícita e a
+ * tabela M[A, a] gerada por ll1gen a partir de gramaticas/linguagem.ll1:
+ *
+ *     empilha o símbolo inicial
+ *     enquanto a pilha não estiver vazia:
+ *         X = desempilha, a = token corrente
+ *         X terminal:      X == a ? avança : erro
+ *         X não terminal:  empilha o lado direito de M[X, a], de trás
+ *                          para frente (ou erro se a célula estiver vazia)
+ *
+ * A sequência de produções aplicadas é a derivação mais à esquerda do
+ * programa. O driver reconhece a linguagem e conta as produções; não monta
+ * a AST nem se recupera de erros (para no primeiro).
+ */
+
+#include "../include/parser.h"
+#include "tabela_ll1.h"
+
+#define LL1_INITIAL_STACK 256
+
+// Descreve os tokens aceitos em M[n, *] (no máximo alguns, para a mensagem)
+static void expected_tokens(int nonterminal, char* buffer, size_t size) {
+    int written = 0, shown = 0;
+    buffer[0] = '\0';
+    for (int t = 0; t < LL1_TERMINALS && written < (int)size; t++) {
+        if (ll1_table[nonterminal][t] < 0) continue;
+        if (shown == 4) {
+            snprintf(buffer + written, size - written, ", ...");
+            return;
+        }
+        written += snprintf(buffer + written, size - written, "%s%s", shown ? ", " : "",
+                            token_type_to_string((TokenType)t));
+        shown++;
+    }
+}
+
+static void report_error(const Token* token, const char* message) {
+    printf("Erro sintático na linha %d, coluna %d: %s (token: '%s')\n",
+           token->line, token->column, message, token->lexeme);
+}
+
+/*
+ * Analisa os tokens (terminados por TOKEN_EOF). Retorna 1 se o programa for
+ * aceito. Em stats (opcional) ficam o número de produções aplicadas e a
+ * profundidade máxima da pilha.
+ */
+int ll1_parse(const Token* tokens, int token_count, int report_errors, LL1Stats* stats) {
+    static const Token eof = {TOKEN_EOF, "EOF", 0, 0, 0, 0};
+
+    int capacity = LL1_INITIAL_STACK;
+    LL1Symbol* stack = malloc(capacity * sizeof(LL1Symbol));
+    int depth = 0, max_depth = 1;
+    long productions = 0;
+    int position = 0;
+    int accepted = 1;
+
+    stack[depth++] = LL1_START;
+
+    while (depth > 0) {
+        int symbol = stack[--depth];
+        const Token* token = position < token_count ? &tokens[position] : &eof;
+
+        if (symbol < LL1_TERMINALS) {
+            if (symbol != (int)token->type) {
+                if (report_errors) {
+                    char message[64];
+                    snprintf(message, sizeof(message), "Esperado %s",
+                             token_type_to_string((TokenType)symbol));
+                    report_error(token, message);
+                }
+                accepted = 0;
+                break;
+            }
+            position++;
+            continue;
+        }
+
+        int nonterminal = symbol - LL1_TERMINALS;
+        int production = ll1_table[nonterminal][token->type];
+        if (production < 0) {
+            if (report_errors) {
+                char expected[160], message[256];
+                expected_tokens(nonterminal, expected, sizeof(expected));
+                snprintf(message, sizeof(message), "Esperado %s em %s", expected, ll1_names[nonterminal]);
+                report_error(token, message);
+            }
+            accepted = 0;
+            break;
+        }
+        productions++;
+
+        int start = ll1_rhs_start[production];
+        int length = ll1_rhs_start[production + 1] - start;
+        if (depth + length > capacity) {
+            while (depth + length > capacity) capacity *= 2;
+            stack = realloc(stack, capacity * sizeof(LL1Symbol));
+        }
+        for (int i = length - 1; i >= 0; i--) {
+            stack[depth++] = ll1_rhs[start + i];
+        }
+        if (depth > max_depth) max_depth = depth;
+    }
+
+    if (stats) {
+        stats->productions = productions;
+        stats->max_stack_depth = max_depth;
+        stats->stack_bytes = capacity * sizeof(LL1Symbol);
+        stats->tokens_consumed = position;
+    }
+
+    free(stack);
+    return accepted;
+}
+
+// Memória ocupada pelas tabelas geradas
+size_t ll1_table_bytes(void) {
+    return sizeof(ll1_table) + sizeof(ll1_rhs) + sizeof(ll1_rhs_start);
+}
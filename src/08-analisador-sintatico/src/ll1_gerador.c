@@ -0,0 +1,171 @@
+/*
+ * Gerador de tabelas LL(1)
+ *
+ * Lê uma gramática (formato descrito em gramaticas/linguagem.ll1), calcula
+ * os conjuntos FIRST e FOLLOW, monta a tabela preditiva M[A, a] e a grava
+ * como um cabeçalho C usado pelo driver de ll1.c:
+ *
+ *     ll1gen gramaticas/linguagem.ll1 -o build/tabela_ll1.h
+ *
+ * Regras de construção da tabela, para cada produção A -> α:
+ *   - para cada terminal a em FIRST(α), M[A, a] = A -> α
+ *   - se α deriva ε, para cada terminal b em FOLLOW(A), M[A, b] = A -> α
+ *
+ * Se uma célula recebe duas produções a gramática não é LL(1): o conflito é
+ * reportado e fica valendo a produção escrita primeiro no arquivo (é assim
+ * que o "else pendente" é resolvido). Com --estrito, conflitos são erros.
+ *
+ * A leitura da gramática e os conjuntos FIRST/FOLLOW ficam em gramatica.c.
+ */
+
+#include "../include/gramatica.h"
+
+// ==================== TABELA ====================
+
+// Preenche table[n][t] com o índice da produção (-1 = erro); devolve o número de conflitos
+static int build_table(const Grammar* grammar, int* table, const char* filename) {
+    int conflicts = 0;
+    for (int i = 0; i < grammar->nonterminal_count * GRAMMAR_TERMINALS; i++) table[i] = -1;
+
+    for (int i = 0; i < grammar->production_count; i++) {
+        const Production* p = &grammar->productions[i];
+        int nullable;
+        TerminalSet set = grammar_first_of(grammar, p->rhs, p->length, &nullable);
+        if (nullable) set |= grammar->follow[p->lhs];
+
+        for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+            if (!(set & ((TerminalSet)1 << t))) continue;
+            int* cell = &table[p->lhs * GRAMMAR_TERMINALS + t];
+            if (*cell == -1) {
+                *cell = i;
+            } else if (*cell != i) {
+                conflicts++;
+                fprintf(stderr, "%s:%d: conflito LL(1) em M[%s, %s]:\n  mantida:    ",
+                        filename, p->line, grammar->names[p->lhs], token_type_to_string((TokenType)t));
+                grammar_print_production(grammar, *cell, stderr);
+                fprintf(stderr, "\n  descartada: ");
+                grammar_print_production(grammar, i, stderr);
+                fprintf(stderr, "\n");
+            }
+        }
+    }
+    return conflicts;
+}
+
+static int write_table(const Grammar* grammar, const int* table, const char* output, const char* source) {
+    FILE* out = fopen(output, "w");
+    if (!out) {
+        fprintf(stderr, "Erro: não foi possível criar o arquivo '%s'\n", output);
+        return 0;
+    }
+
+    int symbol_count = GRAMMAR_TERMINALS + grammar->nonterminal_count;
+    int rhs_total = 0;
+    for (int i = 0; i < grammar->production_count; i++) rhs_total += grammar->productions[i].length;
+
+    // Tipos mais estreitos que comportam os valores: a tabela cabe em poucos KB
+    const char* entry_type = grammar->production_count < 128 ? "int8_t" : "int16_t";
+    const char* symbol_type = symbol_count <= 256 ? "uint8_t" : "uint16_t";
+
+    fprintf(out, "/* Gerado por ll1gen a partir de %s. Não edite. */\n\n", source);
+    fprintf(out, "#define LL1_TERMINALS %d\n", GRAMMAR_TERMINALS);
+    fprintf(out, "#define LL1_NONTERMINALS %d\n", grammar->nonterminal_count);
+    fprintf(out, "#define LL1_PRODUCTIONS %d\n", grammar->production_count);
+    fprintf(out, "#define LL1_START %d\n\n", GRAMMAR_TERMINALS + grammar->productions[0].lhs);
+    fprintf(out, "typedef %s LL1Entry;\n", entry_type);
+    fprintf(out, "typedef %s LL1Symbol;\n\n", symbol_type);
+
+    fprintf(out, "// M[não terminal][token]: produção a aplicar (-1 = erro)\n");
+    fprintf(out, "static const LL1Entry ll1_table[LL1_NONTERMINALS][LL1_TERMINALS] = {\n");
+    for (int n = 0; n < grammar->nonterminal_count; n++) {
+        fprintf(out, "    /* %-20s */ {", grammar->names[n]);
+        for (int t = 0; t < GRAMMAR_TERMINALS; t++) {
+            fprintf(out, "%s%d", t ? "," : "", table[n * GRAMMAR_TERMINALS + t]);
+        }
+        fprintf(out, "},\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Lados direitos concatenados; a produção i ocupa [ll1_rhs_start[i], ll1_rhs_start[i + 1])\n");
+    fprintf(out, "static const LL1Symbol ll1_rhs[%d] = {", rhs_total ? rhs_total : 1);
+    int column = 0;
+    for (int i = 0; i < grammar->production_count; i++) {
+        const Production* p = &grammar->productions[i];
+        for (int j = 0; j < p->length; j++) {
+            fprintf(out, "%s%s%d", column ? "," : "", column % 20 == 0 ? "\n    " : "", p->rhs[j]);
+            column++;
+        }
+    }
+    if (!rhs_total) fprintf(out, "0");
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const uint16_t ll1_rhs_start[LL1_PRODUCTIONS + 1] = {");
+    int start = 0;
+    for (int i = 0; i <= grammar->production_count; i++) {
+        fprintf(out, "%s%s%d", i ? "," : "", i % 20 == 0 ? "\n    " : "", start);
+        if (i < grammar->production_count) start += grammar->productions[i].length;
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "static const char* const ll1_names[LL1_NONTERMINALS] = {");
+    for (int n = 0; n < grammar->nonterminal_count; n++) {
+        fprintf(out, "%s\n    \"%s\"", n ? "," : "", grammar->names[n]);
+    }
+    fprintf(out, "\n};\n");
+
+    int ok = fclose(out) == 0;
+    if (!ok) fprintf(stderr, "Erro: falha ao gravar o arquivo '%s'\n", output);
+    return ok;
+}
+
+// ==================== PROGRAMA ====================
+
+int main(int argc, char* argv[]) {
+    const char* grammar_file = NULL;
+    const char* output = NULL;
+    int show_sets = 0;
+    int strict = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (strcmp(argv[i], "--conjuntos") == 0) {
+            show_sets = 1;
+        } else if (strcmp(argv[i], "--estrito") == 0) {
+            strict = 1;
+        } else if (argv[i][0] != '-' && !grammar_file) {
+            grammar_file = argv[i];
+        } else {
+            grammar_file = NULL;
+            break;
+        }
+    }
+
+    if (!grammar_file) {
+        printf("Uso: %s gramatica.ll1 [-o tabela.h] [--conjuntos] [--estrito]\n", argv[0]);
+        return 1;
+    }
+
+    Grammar* grammar = grammar_load(grammar_file);
+    if (!grammar) return 1;
+
+    grammar_compute_first(grammar);
+    grammar_compute_follow(grammar);
+    if (show_sets) grammar_print_sets(grammar);
+
+    int* table = malloc(grammar->nonterminal_count * GRAMMAR_TERMINALS * sizeof(int));
+    int conflicts = build_table(grammar, table, grammar_file);
+
+    int filled = 0;
+    for (int i = 0; i < grammar->nonterminal_count * GRAMMAR_TERMINALS; i++) filled += table[i] >= 0;
+    printf("%s: %d não terminais, %d produções, %d de %d células preenchidas, %d conflito(s)\n",
+           grammar_file, grammar->nonterminal_count, grammar->production_count,
+           filled, grammar->nonterminal_count * GRAMMAR_TERMINALS, conflicts);
+
+    int ok = !(strict && conflicts > 0);
+    if (ok && output) ok = write_table(grammar, table, output, grammar_file);
+
+    grammar_free(grammar);
+    free(table);
+    return ok ? 0 : 1;
+}
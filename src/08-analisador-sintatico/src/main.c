@@ -0,0 +1,612 @@
+#define _POSIX_C_SOURCE 200809L
+#include <time.h>
+#include "../include/parser.h"
+
+static const char* sample_code =
+    "int factorial(int n) {\n"
+    "    if (n <= 1) {\n"
+    "        return 1;\n"
+    "    } else {\n"
+    "        return n * factorial(n - 1);\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "int main() {\n"
+    "    int result;\n"
+    "    result = factorial(5);\n"
+    "    return 0;\n"
+    "}\n";
+
+// Lê arquivo completo para string
+static char* read_file(const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", filename);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* content = malloc(size + 1);
+    if (!content) {
+        fprintf(stderr, "Erro: não foi possível alocar memória\n");
+        fclose(file);
+        return NULL;
+    }
+
+    size_t read = fread(content, 1, size, file);
+    content[read] = '\0';
+
+    fclose(file);
+    return content;
+}
+
+static double elapsed_ms(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static void print_usage(const char* program) {
+    printf("Uso: %s [opções] [arquivo]\n", program);
+    printf("Sem arquivo, analisa o programa de exemplo (fatorial).\n\n");
+    printf("Opções:\n");
+    printf("  --tokens        imprime os tokens reconhecidos\n");
+    printf("  --paralelo N    analisa as declarações de nível superior com N threads\n");
+    printf("  --comparar      executa os parsers sequencial e paralelo, verifica se as\n");
+    printf("                  ASTs são idênticas e mostra os tempos\n");
+    printf("  --editar P R T  aplica uma edição (remove R bytes na posição P e insere T)\n");
+    printf("                  com o parser incremental e compara com uma análise completa;\n");
+    printf("                  pode ser repetida; com --semantico, refaz também a análise\n");
+    printf("                  semântica só das funções afetadas e a confere\n");
+    printf("  --ll1           usa o parser LL(1) dirigido por tabela (só reconhece)\n");
+    printf("  --lalr          usa o parser LALR(1) dirigido por tabela e compara a AST\n");
+    printf("                  com a do parser descendente recursivo\n");
+    printf("  --dag           compartilha subexpressões idênticas (hash-consing)\n");
+    printf("  --semantico     analisa tipos e escopos sobre a AST e imprime a AST anotada\n");
+    printf("                  e a tabela de símbolos; com --paralelo N, os corpos das\n");
+    printf("                  funções são analisados por N threads; com --comparar,\n");
+    printf("                  confere a análise paralela contra a sequencial\n");
+    printf("  --salvar-ast A  grava a AST no formato binário em A (e confere a gravação);\n");
+    printf("                  com --semantico, grava a AST anotada\n");
+    printf("  --carregar-ast A  mapeia a AST binária A e a imprime, sem analisar fonte;\n");
+    printf("                  com --semantico, faz a análise semântica sobre a AST\n");
+    printf("                  carregada (e, com --salvar-ast, grava o resultado)\n");
+    printf("  --sem-ast       não imprime a AST\n");
+}
+
+// Grava a AST e a relê com mmap para conferir se o arquivo é fiel à árvore
+static int save_ast(const char* filename, ASTNode* ast) {
+    struct timespec t0, t1;
+    size_t bytes;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (ast_write_binary(filename, ast, &bytes) != 0) return 0;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double write_ms = elapsed_ms(t0, t1);
+
+    ASTView view;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (ast_view_open(&view, filename) != 0) return 0;
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double open_ms = elapsed_ms(t0, t1);
+
+    int equal = ast_view_validate(&view) &&
+                ast_view_equal(&view, ast_view_node(&view, view.header->root), ast);
+    printf("\nAST binária '%s': %u nós, %zu bytes (%.1f bytes/nó), %u bytes de strings\n",
+           filename, view.header->node_count, bytes,
+           view.header->node_count ? (double)bytes / view.header->node_count : 0.0,
+           view.header->string_bytes);
+    printf("Gravação: %.3f ms, abertura (mmap): %.3f ms, conferência: %s\n",
+           write_ms, open_ms, equal ? "ok" : "DIFERENTE");
+
+    ast_view_close(&view);
+    return equal;
+}
+
+// Anotações dos nós em pré-ordem, para comparar duas análises da mesma AST
+static void collect_annotations(const ASTNode* node, int** out, int* count, int* capacity) {
+    if (!node) return;
+    if (*count + 2 > *capacity) {
+        *capacity = *capacity ? *capacity * 2 : 256;
+        *out = realloc(*out, *capacity * sizeof(int));
+    }
+    (*out)[(*count)++] = node->data_type;
+    (*out)[(*count)++] = node->symbol_id;
+    collect_annotations(node->left, out, count, capacity);
+    collect_annotations(node->right, out, count, capacity);
+    for (int i = 0; i < node->child_count; i++) {
+        collect_annotations(node->children[i], out, count, capacity);
+    }
+}
+
+static int same_semantics(const SemanticAnalyzer* a, const SemanticAnalyzer* b) {
+    if (a->table.symbol_count != b->table.symbol_count || a->error_count != b->error_count) return 0;
+    for (int i = 0; i < a->table.symbol_count; i++) {
+        const Symbol* x = &a->table.symbols[i];
+        const Symbol* y = &b->table.symbols[i];
+        if (strcmp(x->name, y->name) != 0 || x->type != y->type || x->kind != y->kind ||
+            x->scope != y->scope || x->line != y->line || x->decl != y->decl) return 0;
+    }
+    for (int i = 0; i < a->error_count; i++) {
+        if (a->errors[i].line != b->errors[i].line ||
+            strcmp(a->errors[i].message, b->errors[i].message) != 0) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Análise semântica sobre a AST já montada: anota tipos e símbolos nos nós
+ * e insere as conversões implícitas (nós da arena da AST). Com threads > 0
+ * usa a análise paralela por função; com compare, refaz a análise no outro
+ * modo e confere se símbolos, erros e anotações coincidem.
+ */
+static int run_semantic(ASTNode* ast, Arena* arena, int show_ast, int threads, int compare) {
+    struct timespec t0, t1;
+    SemanticAnalyzer sema;
+    semantic_init(&sema);
+    sema.arena = arena;
+
+    SemanticParallelStats stats;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int errors = threads > 0 ? semantic_analyze_parallel(&sema, ast, threads, &stats)
+                             : semantic_analyze(&sema, ast);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double first_ms = elapsed_ms(t0, t1);
+
+    if (threads > 0) {
+        printf("Análise semântica paralela: %d funções, %d thread(s), %d tarefa(s) roubada(s)\n",
+               stats.functions, stats.threads_used, stats.steals);
+    }
+    if (errors == 0) {
+        printf("✓ Análise semântica completada com sucesso! (%d símbolos, %.3f ms)\n",
+               sema.table.symbol_count, first_ms);
+    } else {
+        printf("✗ Análise semântica encontrou %d erro(s).\n", errors);
+    }
+    if (show_ast) {
+        printf("\n=== AST ANOTADA (tipo -> símbolo) ===\n");
+        print_annotated_ast(&sema, ast, 0);
+        print_symbols(&sema);
+    }
+
+    int ok = errors == 0;
+    if (compare) {
+        int compare_threads = threads > 0 ? threads : 4;
+        int* expected = NULL;
+        int* actual = NULL;
+        int expected_count = 0, actual_count = 0, capacity = 0;
+
+        // Sequencial e paralela, sem imprimir: os erros ficam guardados para a comparação
+        SemanticAnalyzer seq, par;
+        semantic_init(&seq);
+        semantic_init(&par);
+        seq.report_errors = par.report_errors = 0;
+        seq.arena = par.arena = arena;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        semantic_analyze(&seq, ast);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double seq_ms = elapsed_ms(t0, t1);
+        collect_annotations(ast, &expected, &expected_count, &capacity);
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        semantic_analyze_parallel(&par, ast, compare_threads, &stats);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double par_ms = elapsed_ms(t0, t1);
+        capacity = 0;
+        collect_annotations(ast, &actual, &actual_count, &capacity);
+
+        int equal = same_semantics(&seq, &par) && expected_count == actual_count &&
+                    memcmp(expected, actual, expected_count * sizeof(int)) == 0;
+        printf("\n=== SEMÂNTICA SEQUENCIAL x PARALELA (%d threads) ===\n", stats.threads_used);
+        printf("Sequencial: %.3f ms\n", seq_ms);
+        printf("Paralela:   %.3f ms (%d funções, %d tarefa(s) roubada(s))\n", par_ms,
+               stats.functions, stats.steals);
+        printf("Símbolos, erros e anotações idênticos: %s\n", equal ? "sim" : "NÃO");
+        ok &= equal;
+
+        free(expected);
+        free(actual);
+        semantic_free(&seq);
+        semantic_free(&par);
+    }
+
+    semantic_free(&sema);
+    return ok;
+}
+
+/*
+ * Etapa semântica a partir de uma AST binária: reconstrói os nós, analisa
+ * e, com save_file, grava a AST anotada. Se o arquivo já vinha anotado,
+ * confere se a nova análise chega às mesmas anotações e conversões.
+ */
+static int run_semantic_stage(const ASTView* view, int show_ast, int threads, int compare,
+                              const char* save_file) {
+    Arena arena;
+    arena_init(&arena);
+    ASTNode* ast = ast_view_load(view, ast_view_node(view, view->header->root), &arena);
+
+    int ok = run_semantic(ast, &arena, show_ast, threads, compare);
+    if (ast_view_annotated(view)) {
+        int same = ast_view_equal(view, ast_view_node(view, view->header->root), ast);
+        printf("Anotações gravadas x nova análise: %s\n", same ? "iguais" : "DIFERENTES");
+        ok &= same;
+    }
+    if (ok && save_file && !save_ast(save_file, ast)) ok = 0;
+
+    arena_free(&arena);
+    return ok;
+}
+
+static int load_ast(const char* filename, int show_ast, int use_semantic, int threads, int compare,
+                    const char* save_file) {
+    ASTView view;
+    if (ast_view_open(&view, filename) != 0) return 1;
+
+    if (!ast_view_validate(&view)) {
+        fprintf(stderr, "Erro: '%s': referências inválidas na AST binária\n", filename);
+        ast_view_close(&view);
+        return 1;
+    }
+
+    int annotated = ast_view_annotated(&view);
+    printf("✓ AST binária carregada: %u nós, %zu bytes%s\n", view.header->node_count, view.size,
+           annotated ? " (anotada)" : "");
+    int ok = 1;
+    if (use_semantic) {
+        ok = run_semantic_stage(&view, show_ast, threads, compare, save_file);
+    } else if (show_ast) {
+        printf("\n=== ÁRVORE SINTÁTICA ABSTRATA%s ===\n", annotated ? " (tipo -> símbolo)" : "");
+        ast_view_print(&view, ast_view_node(&view, view.header->root), 0);
+    }
+
+    ast_view_close(&view);
+    return ok ? 0 : 1;
+}
+
+/*
+ * Atualiza a sessão semântica depois de uma edição e confere o resultado
+ * contra uma análise completa da mesma árvore (que reanota os nós com os
+ * mesmos valores, se a sessão estiver certa).
+ */
+static int update_semantic_session(SemanticSession* session, IncrementalDoc* doc, int invalidate) {
+    struct timespec t0, t1;
+    SemanticIncrementalStats stats;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    int errors = semantic_session_update(session, doc->program, invalidate, &stats);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double incremental_ms = elapsed_ms(t0, t1);
+
+    int* expected = NULL;
+    int* actual = NULL;
+    int expected_count = 0, actual_count = 0, capacity = 0;
+    collect_annotations(doc->program, &actual, &actual_count, &capacity);
+
+    SemanticAnalyzer full;
+    semantic_init(&full);
+    full.report_errors = 0;
+    full.arena = &doc->arena;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    semantic_analyze(&full, doc->program);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    double full_ms = elapsed_ms(t0, t1);
+    capacity = 0;
+    collect_annotations(doc->program, &expected, &expected_count, &capacity);
+
+    int equal = same_semantics(&session->sema, &full) && expected_count == actual_count &&
+                memcmp(expected, actual, expected_count * sizeof(int)) == 0;
+    printf("  semântica: %d corpo(s) reanalisado(s), %d aproveitado(s) (%d renumerado(s)), "
+           "%d erro(s)%s\n", stats.rechecked, stats.reused, stats.remapped, errors,
+           invalidate ? " (cache descartado)" : "");
+    printf("  semântica incremental: %.3f ms, completa: %.3f ms\n", incremental_ms, full_ms);
+    printf("  símbolos, erros e anotações idênticos: %s\n", equal ? "sim" : "NÃO");
+
+    free(expected);
+    free(actual);
+    semantic_free(&full);
+    return equal;
+}
+
+typedef struct {
+    int offset;
+    int remove_length;
+    const char* text;
+} Edit;
+
+// Aplica as edições com o parser incremental, conferindo cada uma contra uma
+// análise completa do texto resultante; com semantic, também a análise
+// semântica incremental
+static int run_edits(const char* input, const Edit* edits, int edit_count, int semantic) {
+    struct timespec t0, t1;
+    IncrementalDoc doc;
+    SemanticSession session;
+    int all_equal = 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    incremental_init(&doc, input);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    printf("\n=== PARSING INCREMENTAL ===\n");
+    printf("Análise inicial: %d segmentos, %.3f ms\n", doc.segment_count, elapsed_ms(t0, t1));
+    if (semantic) {
+        semantic_session_init(&session, &doc.arena);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int errors = semantic_session_update(&session, doc.program, 0, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        printf("Análise semântica inicial: %d função(ões), %d erro(s), %.3f ms\n",
+               session.function_count, errors, elapsed_ms(t0, t1));
+    }
+
+    for (int e = 0; e < edit_count; e++) {
+        IncrementalStats stats;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        ASTNode* ast = incremental_edit(&doc, edits[e].offset, edits[e].remove_length,
+                                        edits[e].text, &stats);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double incremental_ms = elapsed_ms(t0, t1);
+
+        // Referência: tokenização e análise do texto inteiro
+        Arena arena;
+        arena_init(&arena);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int token_count;
+        Token* tokens = tokenize(doc.source, &token_count);
+        Parser parser;
+        init_parser(&parser, tokens, token_count, &arena);
+        parser.report_errors = 0;
+        ASTNode* full = parse_program(&parser);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double full_ms = elapsed_ms(t0, t1);
+
+        int equal = ast_equal(ast, full);
+        all_equal &= equal;
+
+        printf("\nEdição %d: posição %d, remove %d, insere %d byte(s)\n", e + 1,
+               edits[e].offset, edits[e].remove_length, (int)strlen(edits[e].text));
+        printf("  tokens reanalisados: %d de %d\n", stats.tokens_relexed, token_count - 1);
+        printf("  segmentos reanalisados: %d de %d\n", stats.segments_reparsed, doc.segment_count);
+        printf("  nós criados: %d, reaproveitados: %d, linhas ajustadas: %d%s\n",
+               stats.nodes_created, stats.nodes_reused, stats.nodes_shifted,
+               stats.full_reparse ? " (arena compactada)" : "");
+        printf("  erros: %d (análise completa: %d)\n", doc.error_count, parser.error_count);
+        printf("  incremental: %.3f ms, completa: %.3f ms\n", incremental_ms, full_ms);
+        printf("  ASTs idênticas: %s\n", equal ? "sim" : "NÃO");
+        if (semantic) all_equal &= update_semantic_session(&session, &doc, stats.full_reparse);
+
+        arena_free(&arena);
+        free(tokens);
+    }
+
+    if (semantic) semantic_session_free(&session);
+    incremental_free(&doc);
+    return all_equal;
+}
+
+// Analisa com o parser LALR(1) e confere a AST com a do parser descendente
+static int run_lalr(Token* tokens, int token_count, int show_ast) {
+    struct timespec t0, t1;
+    Arena arena, rd_arena;
+    arena_init(&arena);
+    arena_init(&rd_arena);
+
+    LALRStats stats;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    ASTNode* ast = lalr_parse(tokens, token_count, &arena, 1, &stats);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    int ok = ast != NULL;
+    if (ok) {
+        printf("✓ Programa aceito pelo parser LALR(1) (%d tokens, %ld shifts, %ld reduções, "
+               "pilha máxima %d, %.3f ms)\n",
+               token_count, stats.shifts, stats.reductions, stats.max_stack_depth, elapsed_ms(t0, t1));
+
+        Parser parser;
+        init_parser(&parser, tokens, token_count, &rd_arena);
+        parser.report_errors = 0;
+        ASTNode* rd = parse_program(&parser);
+        int equal = parser.error_count == 0 && ast_equal(ast, rd);
+        printf("AST idêntica à do parser descendente: %s\n", equal ? "sim" : "NÃO");
+        ok = equal;
+
+        if (show_ast) {
+            printf("\n=== ÁRVORE SINTÁTICA ABSTRATA (LALR) ===\n");
+            print_ast(ast, 0);
+        }
+    } else {
+        printf("✗ Programa rejeitado pelo parser LALR(1).\n");
+    }
+
+    arena_free(&arena);
+    arena_free(&rd_arena);
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    const char* filename = NULL;
+    int show_tokens = 0;
+    int show_ast = 1;
+    int threads = 0;
+    int compare = 0;
+    int use_dag = 0;
+    int use_ll1 = 0;
+    int use_lalr = 0;
+    int use_semantic = 0;
+    const char* save_file = NULL;
+    const char* load_file = NULL;
+    Edit* edits = malloc(argc * sizeof(Edit));
+    int edit_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tokens") == 0) {
+            show_tokens = 1;
+        } else if (strcmp(argv[i], "--paralelo") == 0 && i + 1 < argc) {
+            threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--comparar") == 0) {
+            compare = 1;
+        } else if (strcmp(argv[i], "--editar") == 0 && i + 3 < argc) {
+            edits[edit_count].offset = atoi(argv[++i]);
+            edits[edit_count].remove_length = atoi(argv[++i]);
+            edits[edit_count].text = argv[++i];
+            edit_count++;
+        } else if (strcmp(argv[i], "--ll1") == 0) {
+            use_ll1 = 1;
+        } else if (strcmp(argv[i], "--lalr") == 0) {
+            use_lalr = 1;
+        } else if (strcmp(argv[i], "--dag") == 0) {
+            use_dag = 1;
+        } else if (strcmp(argv[i], "--semantico") == 0) {
+            use_semantic = 1;
+        } else if (strcmp(argv[i], "--salvar-ast") == 0 && i + 1 < argc) {
+            save_file = argv[++i];
+        } else if (strcmp(argv[i], "--carregar-ast") == 0 && i + 1 < argc) {
+            load_file = argv[++i];
+        } else if (strcmp(argv[i], "--sem-ast") == 0) {
+            show_ast = 0;
+        } else if (argv[i][0] == '-') {
+            print_usage(argv[0]);
+            return 1;
+        } else {
+            filename = argv[i];
+        }
+    }
+
+    if (load_file) {
+        free(edits);
+        return load_ast(load_file, show_ast, use_semantic, threads, compare, save_file);
+    }
+
+    char* input = filename ? read_file(filename) : strdup(sample_code);
+    if (!input) {
+        return 1;
+    }
+
+    // Tokenização
+    int token_count;
+    Token* tokens = tokenize(input, &token_count);
+
+    if (show_tokens) {
+        printf("=== TOKENS (%d) ===\n", token_count);
+        for (int i = 0; i < token_count; i++) {
+            printf("  %4d: %-12s '%s'\n", i + 1, token_type_to_string(tokens[i].type),
+                   tokens[i].lexeme);
+        }
+    }
+
+    struct timespec t0, t1;
+    if (use_ll1) {
+        LL1Stats stats;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int accepted = ll1_parse(tokens, token_count, 1, &stats);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (accepted) {
+            printf("✓ Programa aceito pelo parser LL(1) (%d tokens, %ld produções, pilha máxima %d, %.3f ms)\n",
+                   token_count, stats.productions, stats.max_stack_depth, elapsed_ms(t0, t1));
+        } else {
+            printf("✗ Programa rejeitado pelo parser LL(1).\n");
+        }
+        free(edits);
+        free(tokens);
+        free(input);
+        return accepted ? 0 : 1;
+    }
+
+    if (use_lalr) {
+        free(edits);
+        int accepted = run_lalr(tokens, token_count, show_ast);
+        free(tokens);
+        free(input);
+        return accepted ? 0 : 1;
+    }
+
+    // Análise sintática
+    Arena arena;
+    arena_init(&arena);
+    ASTNode* ast;
+    int ok;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    if (threads > 0) {
+        ParallelStats stats;
+        ast = parse_program_parallel(tokens, token_count, threads, &arena, &stats);
+        ok = !stats.fallback;
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        printf("Parsing paralelo: %d declarações, %d thread(s)%s\n",
+               stats.declarations, stats.threads_used,
+               stats.fallback ? " (erro: refeito sequencialmente)" : "");
+    } else {
+        HashCons hashcons;
+        Parser parser;
+        init_parser(&parser, tokens, token_count, &arena);
+        if (use_dag) {
+            hashcons_init(&hashcons);
+            parser.hashcons = &hashcons;
+        }
+        ast = parse_program(&parser);
+        ok = parser.error_count == 0;
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        if (!ok) {
+            printf("✗ Análise sintática falhou com %d erro(s).\n", parser.error_count);
+        }
+        if (use_dag) {
+            printf("DAG: %d nós como árvore, %d nós distintos (%d subexpressões compartilhadas)\n",
+                   count_nodes(ast), count_distinct_nodes(ast), hashcons.shared);
+            hashcons_free(&hashcons);
+        }
+    }
+
+    if (ok) {
+        printf("✓ Análise sintática completada com sucesso! (%d tokens, %d nós, %.3f ms)\n",
+               token_count, count_nodes(ast), elapsed_ms(t0, t1));
+        if (show_ast && !use_semantic) {
+            printf("\n=== ÁRVORE SINTÁTICA ABSTRATA ===\n");
+            print_ast(ast, 0);
+        }
+    }
+
+    if (ok && use_semantic && !run_semantic(ast, &arena, show_ast, threads, compare)) {
+        ok = 0;
+    }
+
+    if (ok && save_file && !save_ast(save_file, ast)) {
+        ok = 0;
+    }
+
+    if (compare) {
+        int compare_threads = threads > 0 ? threads : 4;
+        Arena seq_arena, par_arena;
+        arena_init(&seq_arena);
+        arena_init(&par_arena);
+
+        Parser parser;
+        init_parser(&parser, tokens, token_count, &seq_arena);
+        parser.report_errors = 0;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        ASTNode* seq = parse_program(&parser);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double seq_ms = elapsed_ms(t0, t1);
+
+        ParallelStats stats;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        ASTNode* par = parse_program_parallel(tokens, token_count, compare_threads, &par_arena, &stats);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double par_ms = elapsed_ms(t0, t1);
+
+        printf("\n=== SEQUENCIAL x PARALELO (%d threads) ===\n", stats.threads_used);
+        printf("Sequencial: %.3f ms\n", seq_ms);
+        printf("Paralelo:   %.3f ms%s\n", par_ms, stats.fallback ? " (refeito sequencialmente)" : "");
+        printf("ASTs idênticas: %s\n", ast_equal(seq, par) ? "sim" : "NÃO");
+
+        arena_free(&seq_arena);
+        arena_free(&par_arena);
+    }
+
+    if (edit_count > 0 && !run_edits(input, edits, edit_count, use_semantic)) {
+        ok = 0;
+    }
+
+    arena_free(&arena);
+    free(edits);
+    free(tokens);
+    free(input);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,482 @@
+#include "../include/parser.h"
+
+void init_parser(Parser* parser, Token* tokens, int token_count, Arena* arena) {
+    parser->tokens = tokens;
+    parser->token_count = token_count;
+    parser->current_token = 0;
+    parser->ast_root = NULL;
+    parser->error_count = 0;
+    parser->arena = arena;
+    parser->report_errors = 1;
+    parser->position_base = 0;
+    parser->reuse = NULL;
+    parser->reuse_ctx = NULL;
+    parser->reused_nodes = 0;
+    parser->hashcons = NULL;
+}
+
+static Token current_token(Parser* parser) {
+    if (parser->current_token < parser->token_count) {
+        return parser->tokens[parser->current_token];
+    }
+    Token eof = {TOKEN_EOF, "EOF", 0, 0, 0, 0};
+    if (parser->token_count > 0) {
+        // Fim de um intervalo: posição logo após o último token
+        const Token* last = &parser->tokens[parser->token_count - 1];
+        eof.position = last->position + last->length;
+    }
+    return eof;
+}
+
+static TokenType current_type(Parser* parser) {
+    if (parser->current_token < parser->token_count) {
+        return parser->tokens[parser->current_token].type;
+    }
+    return TOKEN_EOF;
+}
+
+static void advance_token(Parser* parser) {
+    if (parser->current_token < parser->token_count) {
+        parser->current_token++;
+    }
+}
+
+static void error(Parser* parser, const char* message) {
+    parser->error_count++;
+    if (!parser->report_errors) return;
+
+    Token token = current_token(parser);
+    printf("Erro sintático na linha %d, coluna %d: %s (token: '%s')\n",
+           token.line, token.column, message, token.lexeme);
+}
+
+static int match(Parser* parser, TokenType type) {
+    return current_type(parser) == type;
+}
+
+static int is_type_token(Parser* parser) {
+    return match(parser, TOKEN_INT) || match(parser, TOKEN_FLOAT) || match(parser, TOKEN_CHAR);
+}
+
+static void consume(Parser* parser, TokenType type, const char* error_msg) {
+    if (match(parser, type)) {
+        advance_token(parser);
+    } else {
+        error(parser, error_msg);
+    }
+}
+
+// Cria um nó na arena do parser, anotado com a linha do token dado
+static ASTNode* new_node(Parser* parser, NodeType type, const char* value, int line) {
+    ASTNode* node = create_node(parser->arena, type, value);
+    node->line = line;
+    return node;
+}
+
+// Nó de expressão sem efeitos colaterais: compartilhado se o hash-consing estiver ativo
+static ASTNode* expression_node(Parser* parser, NodeType type, const char* value, int line,
+                                ASTNode* left, ASTNode* right) {
+    if (parser->hashcons) {
+        return hashcons_node(parser->hashcons, parser->arena, type, value, line, left, right);
+    }
+    ASTNode* node = new_node(parser, type, value, line);
+    node->left = left;
+    node->right = right;
+    return node;
+}
+
+// Atribuições, declarações e chamadas podem mudar variáveis: nenhuma
+// expressão anterior pode mais ser compartilhada
+static void kill_expressions(Parser* parser) {
+    if (parser->hashcons) hashcons_clear(parser->hashcons);
+}
+
+// Grava em 'node' o trecho [start.position, fim do token anterior)
+static void set_source_range(Parser* parser, ASTNode* node, Token start) {
+    int end = start.position;
+    if (parser->current_token > 0) {
+        const Token* last = &parser->tokens[parser->current_token - 1];
+        end = last->position + last->length;
+    }
+    node->src_start = start.position - parser->position_base;
+    node->src_end = end - parser->position_base;
+}
+
+/*
+ * Parsing incremental: pergunta se já existe uma subárvore do tipo 'type'
+ * começando no token corrente. Se existir, ajusta seus trechos e linhas
+ * ao texto atual e pula os tokens que ela cobre.
+ */
+static ASTNode* try_reuse(Parser* parser, NodeType type) {
+    if (!parser->reuse || parser->current_token >= parser->token_count) return NULL;
+
+    Token token = parser->tokens[parser->current_token];
+    int end_position;
+    ASTNode* node = parser->reuse(parser->reuse_ctx, type, token.position, &end_position);
+    if (!node) return NULL;
+
+    int offset_delta = (token.position - parser->position_base) - node->src_start;
+    parser->reused_nodes += shift_subtree(node, offset_delta, token.line - node->line);
+
+    // Busca binária do primeiro token depois do trecho reaproveitado
+    int lo = parser->current_token, hi = parser->token_count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (parser->tokens[mid].position < end_position) lo = mid + 1;
+        else hi = mid;
+    }
+    parser->current_token = lo;
+    return node;
+}
+
+// ==================== EXPRESSÕES ====================
+
+static ASTNode* parse_primary(Parser* parser) {
+    Token token = current_token(parser);
+
+    if (match(parser, TOKEN_NUMBER)) {
+        advance_token(parser);
+        return expression_node(parser, NODE_NUMBER, token.lexeme, token.line, NULL, NULL);
+    }
+
+    if (match(parser, TOKEN_IDENTIFIER)) {
+        advance_token(parser);
+
+        // Verifica se é uma chamada de função
+        if (match(parser, TOKEN_LPAREN)) {
+            ASTNode* func_call = new_node(parser, NODE_FUNC_CALL, token.lexeme, token.line);
+            advance_token(parser); // (
+
+            // Lista de argumentos
+            if (!match(parser, TOKEN_RPAREN)) {
+                add_child(parser->arena, func_call, parse_expression(parser));
+                while (match(parser, TOKEN_COMMA)) {
+                    advance_token(parser);
+                    add_child(parser->arena, func_call, parse_expression(parser));
+                }
+            }
+
+            consume(parser, TOKEN_RPAREN, "Esperado ')'");
+            kill_expressions(parser);
+            return func_call;
+        }
+
+        return expression_node(parser, NODE_IDENTIFIER, token.lexeme, token.line, NULL, NULL);
+    }
+
+    if (match(parser, TOKEN_LPAREN)) {
+        advance_token(parser);
+        ASTNode* expr = parse_expression(parser);
+        consume(parser, TOKEN_RPAREN, "Esperado ')'");
+        return expr;
+    }
+
+    error(parser, "Esperado número, identificador ou '('");
+    return NULL;
+}
+
+static ASTNode* parse_unary(Parser* parser) {
+    if (match(parser, TOKEN_PLUS) || match(parser, TOKEN_MINUS) || match(parser, TOKEN_NOT)) {
+        Token op = current_token(parser);
+        advance_token(parser);
+        ASTNode* operand = parse_unary(parser);
+        return expression_node(parser, NODE_UNARY_OP, op.lexeme, op.line, operand, NULL);
+    }
+
+    return parse_primary(parser);
+}
+
+/*
+ * Todos os níveis binários seguem o mesmo padrão
+ *     nivel ::= proximo (op proximo)*
+ * então são gerados a partir de uma tabela de operadores por nível.
+ */
+typedef ASTNode* (*ParseFn)(Parser*);
+
+static ASTNode* parse_binary_level(Parser* parser, ParseFn next, const TokenType* ops, int op_count) {
+    ASTNode* left = next(parser);
+
+    while (1) {
+        int found = 0;
+        for (int i = 0; i < op_count && !found; i++) {
+            found = match(parser, ops[i]);
+        }
+        if (!found) break;
+
+        Token op = current_token(parser);
+        advance_token(parser);
+        ASTNode* right = next(parser);
+        left = expression_node(parser, NODE_BINARY_OP, op.lexeme, op.line, left, right);
+    }
+
+    return left;
+}
+
+static ASTNode* parse_multiplicative(Parser* parser) {
+    static const TokenType ops[] = {TOKEN_MULTIPLY, TOKEN_DIVIDE, TOKEN_MODULO};
+    return parse_binary_level(parser, parse_unary, ops, 3);
+}
+
+static ASTNode* parse_additive(Parser* parser) {
+    static const TokenType ops[] = {TOKEN_PLUS, TOKEN_MINUS};
+    return parse_binary_level(parser, parse_multiplicative, ops, 2);
+}
+
+static ASTNode* parse_relational(Parser* parser) {
+    static const TokenType ops[] = {TOKEN_LT, TOKEN_LE, TOKEN_GT, TOKEN_GE};
+    return parse_binary_level(parser, parse_additive, ops, 4);
+}
+
+static ASTNode* parse_equality(Parser* parser) {
+    static const TokenType ops[] = {TOKEN_EQ, TOKEN_NE};
+    return parse_binary_level(parser, parse_relational, ops, 2);
+}
+
+static ASTNode* parse_logical_and(Parser* parser) {
+    static const TokenType ops[] = {TOKEN_AND};
+    return parse_binary_level(parser, parse_equality, ops, 1);
+}
+
+static ASTNode* parse_logical_or(Parser* parser) {
+    static const TokenType ops[] = {TOKEN_OR};
+    return parse_binary_level(parser, parse_logical_and, ops, 1);
+}
+
+static ASTNode* parse_assignment(Parser* parser) {
+    ASTNode* left = parse_logical_or(parser);
+
+    if (match(parser, TOKEN_ASSIGN)) {
+        Token op = current_token(parser);
+        advance_token(parser);
+        ASTNode* node = new_node(parser, NODE_ASSIGN, "=", op.line);
+        node->left = left;
+        node->right = parse_assignment(parser);
+        kill_expressions(parser);
+        return node;
+    }
+
+    return left;
+}
+
+ASTNode* parse_expression(Parser* parser) {
+    return parse_assignment(parser);
+}
+
+// ==================== COMANDOS ====================
+
+static ASTNode* parse_variable_declaration(Parser* parser);
+
+static ASTNode* parse_compound_statement(Parser* parser) {
+    ASTNode* reused = try_reuse(parser, NODE_COMPOUND_STMT);
+    if (reused) return reused;
+
+    Token start = current_token(parser);
+    ASTNode* compound = new_node(parser, NODE_COMPOUND_STMT, NULL, start.line);
+
+    consume(parser, TOKEN_LBRACE, "Esperado '{'");
+
+    while (!match(parser, TOKEN_RBRACE) && !match(parser, TOKEN_EOF)) {
+        int before = parser->current_token;
+        ASTNode* stmt = parse_statement(parser);
+        if (stmt) add_child(parser->arena, compound, stmt);
+
+        // Modo pânico: garante progresso mesmo após um erro
+        if (parser->current_token == before) advance_token(parser);
+    }
+
+    consume(parser, TOKEN_RBRACE, "Esperado '}'");
+    set_source_range(parser, compound, start);
+
+    // Fora do bloco, um mesmo nome pode voltar a designar outra variável
+    kill_expressions(parser);
+
+    return compound;
+}
+
+static ASTNode* parse_if_statement(Parser* parser) {
+    ASTNode* if_stmt = new_node(parser, NODE_IF_STMT, NULL, current_token(parser).line);
+
+    advance_token(parser); // if
+    consume(parser, TOKEN_LPAREN, "Esperado '(' após 'if'");
+    add_child(parser->arena, if_stmt, parse_expression(parser));
+    consume(parser, TOKEN_RPAREN, "Esperado ')' após condição");
+    add_child(parser->arena, if_stmt, parse_statement(parser));
+
+    if (match(parser, TOKEN_ELSE)) {
+        advance_token(parser);
+        add_child(parser->arena, if_stmt, parse_statement(parser));
+    }
+
+    return if_stmt;
+}
+
+static ASTNode* parse_while_statement(Parser* parser) {
+    ASTNode* while_stmt = new_node(parser, NODE_WHILE_STMT, NULL, current_token(parser).line);
+
+    advance_token(parser); // while
+    consume(parser, TOKEN_LPAREN, "Esperado '(' após 'while'");
+    add_child(parser->arena, while_stmt, parse_expression(parser));
+    consume(parser, TOKEN_RPAREN, "Esperado ')' após condição");
+    add_child(parser->arena, while_stmt, parse_statement(parser));
+
+    return while_stmt;
+}
+
+static ASTNode* parse_return_statement(Parser* parser) {
+    ASTNode* return_stmt = new_node(parser, NODE_RETURN_STMT, NULL, current_token(parser).line);
+
+    advance_token(parser); // return
+
+    if (!match(parser, TOKEN_SEMICOLON)) {
+        add_child(parser->arena, return_stmt, parse_expression(parser));
+    }
+
+    consume(parser, TOKEN_SEMICOLON, "Esperado ';' após return");
+
+    return return_stmt;
+}
+
+static ASTNode* parse_expression_statement(Parser* parser) {
+    ASTNode* expr_stmt = new_node(parser, NODE_EXPRESSION_STMT, NULL, current_token(parser).line);
+
+    if (!match(parser, TOKEN_SEMICOLON)) {
+        add_child(parser->arena, expr_stmt, parse_expression(parser));
+    }
+
+    consume(parser, TOKEN_SEMICOLON, "Esperado ';'");
+
+    return expr_stmt;
+}
+
+ASTNode* parse_statement(Parser* parser) {
+    if (match(parser, TOKEN_LBRACE)) {
+        return parse_compound_statement(parser);
+    }
+
+    if (match(parser, TOKEN_IF)) {
+        return parse_if_statement(parser);
+    }
+
+    if (match(parser, TOKEN_WHILE)) {
+        return parse_while_statement(parser);
+    }
+
+    if (match(parser, TOKEN_RETURN)) {
+        return parse_return_statement(parser);
+    }
+
+    // Declaração local (ex.: "int result;" dentro de uma função)
+    if (is_type_token(parser)) {
+        return parse_variable_declaration(parser);
+    }
+
+    return parse_expression_statement(parser);
+}
+
+// ==================== DECLARAÇÕES ====================
+
+static ASTNode* parse_variable_declaration(Parser* parser) {
+    // Pula o tipo (int, float, char)
+    Token type_token = current_token(parser);
+    advance_token(parser);
+
+    Token name_token = current_token(parser);
+    consume(parser, TOKEN_IDENTIFIER, "Esperado nome da variável");
+
+    ASTNode* var_decl = new_node(parser, NODE_VAR_DECL, name_token.lexeme, type_token.line);
+    var_decl->left = new_node(parser, NODE_IDENTIFIER, type_token.lexeme, type_token.line);
+
+    if (match(parser, TOKEN_ASSIGN)) {
+        advance_token(parser);
+        var_decl->right = parse_expression(parser);
+    }
+    kill_expressions(parser);
+
+    consume(parser, TOKEN_SEMICOLON, "Esperado ';' após declaração");
+
+    return var_decl;
+}
+
+// parameter ::= type IDENTIFIER
+static ASTNode* parse_parameter(Parser* parser) {
+    Token type_token = current_token(parser);
+    if (!is_type_token(parser)) {
+        error(parser, "Esperado tipo do parâmetro");
+        return NULL;
+    }
+    advance_token(parser);
+
+    Token name_token = current_token(parser);
+    consume(parser, TOKEN_IDENTIFIER, "Esperado nome do parâmetro");
+
+    ASTNode* param = new_node(parser, NODE_PARAM, name_token.lexeme, type_token.line);
+    param->left = new_node(parser, NODE_IDENTIFIER, type_token.lexeme, type_token.line);
+    return param;
+}
+
+static ASTNode* parse_function_declaration(Parser* parser) {
+    kill_expressions(parser);
+
+    // Tipo de retorno
+    Token return_type = current_token(parser);
+    advance_token(parser);
+
+    Token name_token = current_token(parser);
+    consume(parser, TOKEN_IDENTIFIER, "Esperado nome da função");
+
+    ASTNode* func_decl = new_node(parser, NODE_FUNC_DECL, name_token.lexeme, return_type.line);
+    func_decl->left = new_node(parser, NODE_IDENTIFIER, return_type.lexeme, return_type.line);
+
+    consume(parser, TOKEN_LPAREN, "Esperado '(' após nome da função");
+
+    // param_list ::= (parameter (',' parameter)*)?
+    if (!match(parser, TOKEN_RPAREN)) {
+        ASTNode* param = parse_parameter(parser);
+        if (param) add_child(parser->arena, func_decl, param);
+        while (param && match(parser, TOKEN_COMMA)) {
+            advance_token(parser);
+            param = parse_parameter(parser);
+            if (param) add_child(parser->arena, func_decl, param);
+        }
+    }
+
+    consume(parser, TOKEN_RPAREN, "Esperado ')'");
+    func_decl->right = parse_compound_statement(parser);
+    set_source_range(parser, func_decl, return_type);
+
+    return func_decl;
+}
+
+ASTNode* parse_declaration(Parser* parser) {
+    if (is_type_token(parser)) {
+        // Lookahead de dois tokens para decidir se é função ou variável
+        int saved_pos = parser->current_token;
+        advance_token(parser); // tipo
+        advance_token(parser); // nome
+        int is_function = match(parser, TOKEN_LPAREN);
+        parser->current_token = saved_pos;
+
+        if (is_function) {
+            ASTNode* reused = try_reuse(parser, NODE_FUNC_DECL);
+            return reused ? reused : parse_function_declaration(parser);
+        }
+        return parse_variable_declaration(parser);
+    }
+
+    return parse_statement(parser);
+}
+
+ASTNode* parse_program(Parser* parser) {
+    ASTNode* program = new_node(parser, NODE_PROGRAM, NULL, 1);
+
+    while (!match(parser, TOKEN_EOF)) {
+        int before = parser->current_token;
+        ASTNode* decl = parse_declaration(parser);
+        if (decl) add_child(parser->arena, program, decl);
+
+        if (parser->current_token == before) advance_token(parser);
+    }
+
+    parser->ast_root = program;
+    return program;
+}
@@ -0,0 +1,201 @@
+/*
+ * Parsing paralelo de declarações de nível superior
+ *
+ * Em C (e na linguagem simplificada deste módulo) o corpo de uma função
+ * não depende sintaticamente das outras funções. Assim, depois da análise
+ * léxica, basta uma varredura linear que acompanha a profundidade de
+ * chaves para descobrir onde cada declaração de nível superior começa e
+ * termina:
+ *
+ *     int f(int n) { ... }   int x = 1;   int g() { ... }
+ *     [--------------------] [----------] [-------------]
+ *
+ * Cada intervalo é analisado por um parser independente, em uma thread
+ * própria e com sua própria arena (sem disputa pelo malloc). No final as
+ * subárvores são costuradas em um único NODE_PROGRAM, na ordem do fonte.
+ *
+ * Se algum intervalo tiver erro sintático, ou não for consumido por
+ * inteiro, o resultado paralelo é descartado e o arquivo é analisado de
+ * novo pelo parser sequencial, que produz as mensagens de erro usuais.
+ * Assim a AST final é sempre idêntica à de parse_program.
+ */
+
+#include <pthread.h>
+#include "../include/parser.h"
+
+// Trabalho de um worker: intervalos [first, last) do vetor de declarações
+typedef struct {
+    Token* tokens;
+    const DeclRange* ranges;
+    int first;
+    int last;
+    ASTNode** results;
+    Arena arena;
+    int failed;
+} ParseWorker;
+
+/*
+ * Pré-varredura: encontra os limites das declarações de nível superior.
+ *
+ * Uma declaração termina em ';' ou em '}' que fecha a última chave aberta,
+ * sempre com profundidade zero de chaves e parênteses. A exceção é um
+ * 'if' de nível superior: se o próximo token for 'else', o comando continua.
+ */
+DeclRange* find_toplevel_declarations(const Token* tokens, int token_count, int* range_count) {
+    int capacity = 64;
+    DeclRange* ranges = malloc(capacity * sizeof(DeclRange));
+    *range_count = 0;
+
+    int brace_depth = 0;
+    int paren_depth = 0;
+    int start = 0;
+
+    for (int i = 0; i < token_count && tokens[i].type != TOKEN_EOF; i++) {
+        TokenType type = tokens[i].type;
+        int ends_here = 0;
+
+        switch (type) {
+            case TOKEN_LBRACE: brace_depth++; break;
+            case TOKEN_RBRACE:
+                brace_depth--;
+                ends_here = (brace_depth == 0 && paren_depth == 0);
+                break;
+            case TOKEN_LPAREN: paren_depth++; break;
+            case TOKEN_RPAREN: if (paren_depth > 0) paren_depth--; break;
+            case TOKEN_SEMICOLON:
+                ends_here = (brace_depth == 0 && paren_depth == 0);
+                break;
+            default: break;
+        }
+
+        // Chave desbalanceada: deixa o parser sequencial reportar o erro
+        if (brace_depth < 0) brace_depth = 0;
+
+        if (ends_here && i + 1 < token_count && tokens[i + 1].type == TOKEN_ELSE) {
+            ends_here = 0;
+        }
+
+        if (ends_here) {
+            if (*range_count == capacity) {
+                capacity *= 2;
+                ranges = realloc(ranges, capacity * sizeof(DeclRange));
+            }
+            ranges[*range_count].start = start;
+            ranges[*range_count].end = i + 1;
+            ranges[*range_count].terminated = 1;
+            (*range_count)++;
+            start = i + 1;
+        }
+    }
+
+    // Resto sem terminador: vira um último intervalo (que terá erro)
+    int last = token_count;
+    while (last > start && tokens[last - 1].type == TOKEN_EOF) last--;
+    if (last > start) {
+        if (*range_count == capacity) {
+            capacity++;
+            ranges = realloc(ranges, capacity * sizeof(DeclRange));
+        }
+        ranges[*range_count].start = start;
+        ranges[*range_count].end = last;
+        ranges[*range_count].terminated = 0;
+        (*range_count)++;
+    }
+
+    return ranges;
+}
+
+static void* parse_worker(void* arg) {
+    ParseWorker* worker = arg;
+
+    for (int r = worker->first; r < worker->last && !worker->failed; r++) {
+        const DeclRange* range = &worker->ranges[r];
+        int length = range->end - range->start;
+
+        // O parser enxerga apenas o intervalo; fora dele, current_token é EOF
+        Parser parser;
+        init_parser(&parser, worker->tokens + range->start, length, &worker->arena);
+        parser.report_errors = 0;
+
+        worker->results[r] = parse_declaration(&parser);
+
+        if (parser.error_count > 0 || parser.current_token != length) {
+            worker->failed = 1;
+        }
+    }
+
+    return NULL;
+}
+
+ASTNode* parse_program_parallel(Token* tokens, int token_count, int num_threads,
+                                Arena* arena, ParallelStats* stats) {
+    int range_count;
+    DeclRange* ranges = find_toplevel_declarations(tokens, token_count, &range_count);
+
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > range_count) num_threads = range_count > 0 ? range_count : 1;
+
+    ASTNode** results = calloc(range_count > 0 ? range_count : 1, sizeof(ASTNode*));
+    ParseWorker* workers = calloc(num_threads, sizeof(ParseWorker));
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+
+    // Divide os intervalos em blocos contíguos com número parecido de tokens
+    long total_tokens = range_count > 0 ? ranges[range_count - 1].end - ranges[0].start : 0;
+    int next_range = 0;
+    for (int t = 0; t < num_threads; t++) {
+        long target = total_tokens * (t + 1) / num_threads;
+        workers[t].tokens = tokens;
+        workers[t].ranges = ranges;
+        workers[t].results = results;
+        workers[t].first = next_range;
+        while (next_range < range_count &&
+               (t == num_threads - 1 || ranges[next_range].end - ranges[0].start <= target)) {
+            next_range++;
+        }
+        workers[t].last = next_range;
+        arena_init(&workers[t].arena);
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        pthread_create(&threads[t], NULL, parse_worker, &workers[t]);
+    }
+
+    int failed = 0;
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+        failed |= workers[t].failed;
+    }
+
+    ASTNode* program;
+    if (failed) {
+        // Erro em algum intervalo: refaz tudo sequencialmente
+        for (int t = 0; t < num_threads; t++) {
+            arena_free(&workers[t].arena);
+        }
+        Parser parser;
+        init_parser(&parser, tokens, token_count, arena);
+        program = parse_program(&parser);
+    } else {
+        // Costura: as subárvores entram no programa na ordem do fonte
+        program = create_node(arena, NODE_PROGRAM, NULL);
+        program->line = 1;
+        for (int r = 0; r < range_count; r++) {
+            add_child(arena, program, results[r]);
+        }
+        for (int t = 0; t < num_threads; t++) {
+            arena_merge(arena, &workers[t].arena);
+        }
+    }
+
+    if (stats) {
+        stats->declarations = range_count;
+        stats->threads_used = num_threads;
+        stats->fallback = failed;
+    }
+
+    free(threads);
+    free(workers);
+    free(results);
+    free(ranges);
+    return program;
+}
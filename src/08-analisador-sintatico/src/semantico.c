@@ -0,0 +1,719 @@
+/*
+ * Análise semântica sobre a AST
+ *
+ * Percorre a árvore montada pelo parser (descendente, paralelo, incremental
+ * ou LALR) e anota cada nó no próprio lugar:
+ *
+ *     data_type  tipo resolvido da expressão ou da declaração
+ *     symbol_id  índice na tabela de símbolos do nome declarado/usado
+ *
+ * Não há uma segunda análise léxica: nomes, operadores e linhas vêm dos
+ * nós. As fases seguintes (geração de código) leem os tipos das anotações
+ * em vez de recalculá-los.
+ *
+ * Regras (as de C para esta linguagem):
+ * - nomes são declarados antes do uso; um escopo não redeclara um nome;
+ * - parâmetros e as declarações do corpo da função dividem o mesmo escopo;
+ * - int, float e char se convertem implicitamente entre si; aritmética
+ *   promove char para int e int para float; comparações e operadores
+ *   lógicos produzem int; '%' exige operandos inteiros. Essas regras não
+ *   estão no código: vêm da tabela gerada de gramaticas/tipos.spec, e cada
+ *   operação binária é uma leitura type_rules[operador][esquerdo][direito];
+ * - onde a regra converte um operando (e na atribuição, inicialização,
+ *   retorno e argumentos, que convertem para o tipo do destino) a análise
+ *   insere um nó CONVERT acima dele, alocado em sema->arena;
+ * - chamadas conferem o número de argumentos; funções não são valores;
+ * - 'return' sem valor não é permitido (toda função tem tipo de retorno).
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include <stdarg.h>
+#include "../include/parser.h"
+#include "tabela_tipos.h"
+
+// ==================== TABELA DE SÍMBOLOS ====================
+
+static void* grow_array(void* array, int* capacity, size_t element_size) {
+    *capacity = *capacity ? *capacity * 2 : 16;
+    void* grown = realloc(array, *capacity * element_size);
+    if (!grown) {
+        fprintf(stderr, "Erro: memória insuficiente para a tabela de símbolos\n");
+        exit(1);
+    }
+    return grown;
+}
+
+static unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;   // FNV-1a
+    while (*name) {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void init_symbol_table(SymbolTable* table) {
+    memset(table, 0, sizeof(*table));
+    table->slot_capacity = 64;
+    table->slots = malloc(table->slot_capacity * sizeof(int));
+    for (int i = 0; i < table->slot_capacity; i++) table->slots[i] = -1;
+}
+
+static void free_symbol_table(SymbolTable* table) {
+    free(table->symbols);
+    free(table->names);
+    free(table->slots);
+    free(table->undo);
+    free(table->scope_marks);
+}
+
+// Registro do nome na tabela hash; com create, cria um se não existir
+static int lookup_name(SymbolTable* table, const char* name, int create) {
+    unsigned int hash = hash_name(name);
+    unsigned int mask = table->slot_capacity - 1;
+    unsigned int i = hash & mask;
+
+    while (table->slots[i] != -1) {
+        NameEntry* entry = &table->names[table->slots[i]];
+        if (entry->hash == hash && strcmp(table->symbols[entry->first_symbol].name, name) == 0) {
+            return table->slots[i];
+        }
+        i = (i + 1) & mask;
+    }
+    if (!create) return -1;
+
+    // Novo nome; o texto fica no símbolo que está sendo declarado
+    if (table->name_count == table->name_capacity) {
+        table->names = grow_array(table->names, &table->name_capacity, sizeof(NameEntry));
+    }
+    int index = table->name_count++;
+    table->names[index].hash = hash;
+    table->names[index].first_symbol = table->symbol_count;
+    table->names[index].visible = -1;
+    table->slots[i] = index;
+
+    // Carga máxima de 1/2: dobra e redistribui os registros
+    if (table->name_count * 2 > table->slot_capacity) {
+        free(table->slots);
+        table->slot_capacity *= 2;
+        table->slots = malloc(table->slot_capacity * sizeof(int));
+        for (int k = 0; k < table->slot_capacity; k++) table->slots[k] = -1;
+        mask = table->slot_capacity - 1;
+        for (int n = 0; n < table->name_count; n++) {
+            unsigned int k = table->names[n].hash & mask;
+            while (table->slots[k] != -1) k = (k + 1) & mask;
+            table->slots[k] = n;
+        }
+    }
+    return index;
+}
+
+static void enter_scope(SymbolTable* table) {
+    if (table->scope_depth == table->scope_capacity) {
+        table->scope_marks = grow_array(table->scope_marks, &table->scope_capacity, sizeof(int));
+    }
+    table->scope_marks[table->scope_depth++] = table->undo_count;
+}
+
+// Desfaz as declarações do log até o tamanho 'mark'
+static void undo_declarations(SymbolTable* table, int mark) {
+    while (table->undo_count > mark) {
+        UndoEntry* undo = &table->undo[--table->undo_count];
+        table->names[undo->name].visible = undo->previous;
+    }
+}
+
+static void exit_scope(SymbolTable* table) {
+    if (table->scope_depth == 0) return;
+    undo_declarations(table, table->scope_marks[--table->scope_depth]);
+}
+
+// ID do símbolo visível com este nome, ou -1
+static int find_symbol(const SymbolTable* table, const char* name) {
+    int index = lookup_name((SymbolTable*)table, name, 0);
+    return index < 0 ? -1 : table->names[index].visible;
+}
+
+// ==================== ERROS ====================
+
+/*
+ * Com report_errors, a mensagem é impressa na hora; sem, fica guardada em
+ * sema->errors com a declaração de nível superior em que ocorreu, para que
+ * a análise paralela possa juntar as mensagens na ordem do fonte.
+ */
+static void semantic_error(SemanticAnalyzer* sema, int line, const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    if (sema->report_errors) {
+        printf("Erro semântico na linha %d: %s\n", line, message);
+    } else {
+        if (sema->error_count == sema->error_capacity) {
+            sema->errors = grow_array(sema->errors, &sema->error_capacity, sizeof(SemanticError));
+        }
+        SemanticError* error = &sema->errors[sema->error_count];
+        error->declaration = sema->declaration;
+        error->line = line;
+        error->message = strdup(message);
+    }
+    sema->error_count++;
+}
+
+/*
+ * Declara o nome do nó no escopo atual e anota o nó com o novo símbolo.
+ * Toda declaração ganha um símbolo, na ordem em que aparece no fonte, de
+ * modo que os IDs dependem só da forma da árvore (a análise paralela
+ * reserva faixas de IDs por função). Em redeclaração o símbolo é criado,
+ * mas o nome continua designando a declaração anterior.
+ */
+static int declare(SemanticAnalyzer* sema, ASTNode* decl, SymbolKind kind, DataType type) {
+    SymbolTable* table = &sema->table;
+    decl->data_type = type;
+
+    if (table->symbol_count == table->symbol_capacity) {
+        table->symbols = grow_array(table->symbols, &table->symbol_capacity, sizeof(Symbol));
+    }
+    // O texto precisa estar no símbolo antes de lookup_name criar o registro
+    int id = table->symbol_count;
+    Symbol* symbol = &table->symbols[id];
+    symbol->name = decl->value;
+    symbol->type = type;
+    symbol->kind = kind;
+    symbol->scope = table->scope_depth;
+    symbol->line = decl->line;
+    symbol->decl = decl;
+    decl->symbol_id = id;
+
+    int index = lookup_name(table, decl->value, 1);
+    table->symbol_count++;
+    int previous = table->names[index].visible;
+    if (previous >= 0 && table->symbols[previous].scope == table->scope_depth) {
+        semantic_error(sema, decl->line, "'%s' já foi declarado neste escopo (linha %d)",
+                       decl->value, table->symbols[previous].line);
+        return id;
+    }
+
+    if (table->undo_count == table->undo_capacity) {
+        table->undo = grow_array(table->undo, &table->undo_capacity, sizeof(UndoEntry));
+    }
+    table->undo[table->undo_count].name = index;
+    table->undo[table->undo_count].previous = previous;
+    table->undo_count++;
+    table->names[index].visible = id;
+    return id;
+}
+
+/*
+ * Símbolo visível com o nome, ou -1. Nos workers da análise paralela a
+ * tabela local só tem parâmetros e variáveis locais; os nomes globais vêm
+ * da tabela compartilhada, que só é lida. Um global declarado depois da
+ * função em análise (ID maior) ainda não é visível, como no modo sequencial.
+ */
+static int resolve_name(SemanticAnalyzer* sema, const char* name) {
+    int id = find_symbol(&sema->table, name);
+    if (id < 0 && sema->globals) {
+        id = find_symbol(&sema->globals->table, name);
+        if (id > sema->current_function) id = -1;
+        if (sema->record_uses) {
+            // Dependência do corpo em análise (análise incremental)
+            if (sema->use_count == sema->use_capacity) {
+                sema->uses = grow_array(sema->uses, &sema->use_capacity, sizeof(SemanticUse));
+            }
+            sema->uses[sema->use_count].name = name;
+            sema->uses[sema->use_count].symbol = id;
+            sema->use_count++;
+        }
+    }
+    return id;
+}
+
+/*
+ * Símbolo global visível com o nome para a função 'function' (como na
+ * análise do corpo dela), ou -1. Vale enquanto o escopo global está aberto.
+ */
+int semantic_lookup_global(const SemanticAnalyzer* sema, const char* name, int function) {
+    int id = find_symbol(&sema->table, name);
+    return id > function ? -1 : id;
+}
+
+// ==================== TIPOS ====================
+
+const char* data_type_to_string(DataType type) {
+    switch (type) {
+        case TYPE_INT: return "int";
+        case TYPE_FLOAT: return "float";
+        case TYPE_CHAR: return "char";
+        case TYPE_ERROR: return "erro";
+        default: return "?";
+    }
+}
+
+// Inverso de data_type_to_string para os tipos da linguagem
+DataType type_from_name(const char* name) {
+    if (!name) return TYPE_ERROR;
+    if (strcmp(name, "int") == 0) return TYPE_INT;
+    if (strcmp(name, "float") == 0) return TYPE_FLOAT;
+    if (strcmp(name, "char") == 0) return TYPE_CHAR;
+    return TYPE_ERROR;
+}
+
+// Nó IDENTIFIER com o nome do tipo (filho esquerdo de declarações)
+static DataType resolve_type_name(ASTNode* type_node) {
+    DataType type = type_node ? type_from_name(type_node->value) : TYPE_ERROR;
+    if (type_node) {
+        type_node->data_type = type;
+        type_node->symbol_id = -1;
+    }
+    return type;
+}
+
+// Promoção do operando de '-' unário: char vira int
+static DataType promote_unary(DataType operand) {
+    return operand == TYPE_FLOAT ? TYPE_FLOAT : TYPE_INT;
+}
+
+// ID do operador na tabela gerada, pelo caractere e pela forma; -1 se não tem regras
+static int operator_id(const char* op) {
+    unsigned char c = (unsigned char)op[0];
+    int form = op[1] == '\0' ? 0 : op[1] == '=' ? 1 : op[1] == op[0] ? 2 : -1;
+    if (c >= 128 || form < 0 || (form > 0 && op[2] != '\0')) return -1;
+    return type_operator_ids[c][form] - 1;
+}
+
+// Envolve *slot em um nó CONVERT para 'to' (se o tipo muda e há arena)
+/*
+ * Nó CONVERT acima de *slot. Reaproveita os nós desfeitos por check_operand
+ * (uma nova análise da mesma árvore não aloca) antes de usar a arena.
+ */
+static void insert_conversion(SemanticAnalyzer* sema, ASTNode** slot, DataType from, DataType to) {
+    if (!*slot || to == TYPE_UNKNOWN || from == to) return;
+    const char* name = data_type_to_string(to);
+    ASTNode* convert = sema->spare_converts;
+    if (convert && (sema->arena || strcmp(convert->value, name) == 0)) {
+        sema->spare_converts = convert->right;
+        convert->right = NULL;
+        if (strcmp(convert->value, name) != 0) convert->value = arena_strdup(sema->arena, name);
+    } else if (sema->arena) {
+        convert = create_node(sema->arena, NODE_CONVERT, name);
+    } else {
+        return;
+    }
+    ASTNode* operand = *slot;
+    convert->left = operand;
+    convert->line = operand->line;
+    convert->src_start = operand->src_start;
+    convert->src_end = operand->src_end;
+    convert->data_type = to;
+    *slot = convert;
+}
+
+/*
+ * Aplica a regra da tabela a 'left op right': devolve o tipo do resultado
+ * e converte os operandos em *left_slot e *right_slot (NULL quando o lado
+ * não é uma expressão, como o destino de uma inicialização). Operandos com
+ * erro não geram outra mensagem.
+ */
+static DataType apply_type_rule(SemanticAnalyzer* sema, int line, const char* op,
+                                DataType left, ASTNode** left_slot,
+                                DataType right, ASTNode** right_slot) {
+    if (left == TYPE_ERROR || right == TYPE_ERROR) return TYPE_ERROR;
+
+    int id = operator_id(op);
+    if (id < 0) {
+        semantic_error(sema, line, "Operador '%s' sem regra de tipos", op);
+        return TYPE_ERROR;
+    }
+    TypeRule rule = type_rules[id][left][right];
+    if (rule.result == TYPE_UNKNOWN) {
+        semantic_error(sema, line, "Operador '%s' não se aplica a %s e %s",
+                       op, data_type_to_string(left), data_type_to_string(right));
+        return TYPE_ERROR;
+    }
+    if (left_slot) insert_conversion(sema, left_slot, left, rule.operand);
+    if (right_slot) insert_conversion(sema, right_slot, right, rule.operand);
+    return rule.result;
+}
+
+// ==================== EXPRESSÕES ====================
+
+static DataType check_expression(SemanticAnalyzer* sema, ASTNode* node);
+
+/*
+ * Expressão em uma posição que pode receber um CONVERT. Um CONVERT de uma
+ * análise anterior da mesma árvore é desfeito e guardado para reúso: a
+ * nova análise decide de novo onde converter.
+ */
+static DataType check_operand(SemanticAnalyzer* sema, ASTNode** slot) {
+    while (*slot && (*slot)->type == NODE_CONVERT) {
+        ASTNode* convert = *slot;
+        *slot = convert->left;
+        convert->left = NULL;
+        convert->right = sema->spare_converts;
+        sema->spare_converts = convert;
+    }
+    return check_expression(sema, *slot);
+}
+
+static DataType check_identifier(SemanticAnalyzer* sema, ASTNode* node) {
+    int id = resolve_name(sema, node->value);
+    node->symbol_id = id;
+    if (id < 0) {
+        semantic_error(sema, node->line, "Variável '%s' não foi declarada", node->value);
+        return TYPE_ERROR;
+    }
+    const Symbol* symbol = &sema->table.symbols[id];
+    if (symbol->kind == SYMBOL_FUNCTION) {
+        semantic_error(sema, node->line, "Função '%s' usada como valor", node->value);
+        return TYPE_ERROR;
+    }
+    return symbol->type;
+}
+
+static DataType check_call(SemanticAnalyzer* sema, ASTNode* node) {
+    // Os argumentos são analisados mesmo quando a chamada tem erro
+    for (int i = 0; i < node->child_count; i++) {
+        check_operand(sema, &node->children[i]);
+    }
+
+    int id = resolve_name(sema, node->value);
+    node->symbol_id = id;
+    if (id < 0) {
+        semantic_error(sema, node->line, "Função '%s' não foi declarada", node->value);
+        return TYPE_ERROR;
+    }
+    const Symbol* symbol = &sema->table.symbols[id];
+    if (symbol->kind != SYMBOL_FUNCTION) {
+        semantic_error(sema, node->line, "'%s' não é uma função", node->value);
+        return TYPE_ERROR;
+    }
+    int expected = symbol->decl->child_count;
+    if (node->child_count != expected) {
+        semantic_error(sema, node->line, "Função '%s' espera %d argumento(s), recebeu %d",
+                       node->value, expected, node->child_count);
+        return symbol->type;
+    }
+    // Cada argumento vai para o tipo do parâmetro. O tipo vem do texto da
+    // declaração: os nós do parâmetro podem estar em análise em outro worker
+    for (int i = 0; i < expected; i++) {
+        const ASTNode* param = symbol->decl->children[i];
+        DataType type = type_from_name(param->left ? param->left->value : NULL);
+        DataType value = node->children[i] ? node->children[i]->data_type : TYPE_ERROR;
+        apply_type_rule(sema, node->line, "=", type, NULL, value, &node->children[i]);
+    }
+    return symbol->type;
+}
+
+static DataType check_assign(SemanticAnalyzer* sema, ASTNode* node) {
+    DataType target = check_expression(sema, node->left);
+    DataType value = check_operand(sema, &node->right);
+
+    const ASTNode* left = node->left;
+    if (!left) return TYPE_ERROR;
+    if (left->type != NODE_IDENTIFIER) {
+        semantic_error(sema, node->line, "O lado esquerdo da atribuição não é uma variável");
+        return TYPE_ERROR;
+    }
+    // O valor da atribuição é o da variável, já convertido para o seu tipo
+    apply_type_rule(sema, node->line, "=", target, NULL, value, &node->right);
+    return target;
+}
+
+static DataType check_expression(SemanticAnalyzer* sema, ASTNode* node) {
+    if (!node) return TYPE_ERROR;   // expressão perdida em um erro sintático
+
+    DataType type = TYPE_ERROR;
+    node->symbol_id = -1;
+
+    switch (node->type) {
+        case NODE_NUMBER:
+            type = TYPE_INT;
+            break;
+
+        case NODE_IDENTIFIER:
+            type = check_identifier(sema, node);
+            break;
+
+        case NODE_UNARY_OP: {
+            DataType operand = check_operand(sema, &node->left);
+            if (operand == TYPE_ERROR) {
+                type = TYPE_ERROR;
+            } else if (strcmp(node->value, "!") == 0) {
+                type = TYPE_INT;
+            } else {
+                type = promote_unary(operand);
+                insert_conversion(sema, &node->left, operand, type);
+            }
+            break;
+        }
+
+        case NODE_BINARY_OP: {
+            DataType left = check_operand(sema, &node->left);
+            DataType right = check_operand(sema, &node->right);
+            type = apply_type_rule(sema, node->line, node->value, left, &node->left, right, &node->right);
+            break;
+        }
+
+        case NODE_ASSIGN:
+            type = check_assign(sema, node);
+            break;
+
+        case NODE_FUNC_CALL:
+            type = check_call(sema, node);
+            break;
+
+        default:
+            break;
+    }
+
+    node->data_type = type;
+    return type;
+}
+
+// ==================== COMANDOS E DECLARAÇÕES ====================
+
+static void check_statement(SemanticAnalyzer* sema, ASTNode* node);
+
+static void check_statements(SemanticAnalyzer* sema, ASTNode* block) {
+    for (int i = 0; i < block->child_count; i++) {
+        check_statement(sema, block->children[i]);
+    }
+}
+
+static void check_variable_declaration(SemanticAnalyzer* sema, ASTNode* node) {
+    DataType type = resolve_type_name(node->left);
+    // Como em C, o nome já está no escopo durante a inicialização
+    declare(sema, node, SYMBOL_VARIABLE, type);
+    if (node->right) {
+        DataType value = check_operand(sema, &node->right);
+        apply_type_rule(sema, node->line, "=", type, NULL, value, &node->right);
+    }
+}
+
+/*
+ * Declara a função (nome e tipo de retorno) no escopo atual. O corpo é
+ * analisado à parte, por semantic_check_function_body.
+ */
+int semantic_declare_function(SemanticAnalyzer* sema, ASTNode* node) {
+    node->symbol_id = -1;
+    if (sema->table.scope_depth > 0) {
+        semantic_error(sema, node->line, "Função '%s' declarada dentro de um bloco", node->value);
+    }
+    DataType type = resolve_type_name(node->left);
+    return declare(sema, node, SYMBOL_FUNCTION, type);
+}
+
+// Parâmetros e corpo da função já declarada, no mesmo escopo
+void semantic_check_function_body(SemanticAnalyzer* sema, ASTNode* node) {
+    int enclosing = sema->current_function;
+    sema->current_function = node->symbol_id;
+    enter_scope(&sema->table);
+    for (int i = 0; i < node->child_count; i++) {
+        ASTNode* param = node->children[i];
+        declare(sema, param, SYMBOL_PARAMETER, resolve_type_name(param->left));
+    }
+    if (node->right) {
+        node->right->data_type = TYPE_UNKNOWN;
+        node->right->symbol_id = -1;
+        check_statements(sema, node->right);
+    }
+    exit_scope(&sema->table);
+    sema->current_function = enclosing;
+}
+
+static void check_return(SemanticAnalyzer* sema, ASTNode* node) {
+    DataType value = node->child_count > 0 ? check_operand(sema, &node->children[0]) : TYPE_ERROR;
+
+    if (sema->current_function < 0) {
+        semantic_error(sema, node->line, "'return' fora de uma função");
+        return;
+    }
+    const Symbol* function = &sema->table.symbols[sema->current_function];
+    if (node->child_count == 0) {
+        semantic_error(sema, node->line, "Função '%s' deve retornar um valor do tipo %s",
+                       function->name, data_type_to_string(function->type));
+    } else {
+        apply_type_rule(sema, node->line, "=", function->type, NULL, value, &node->children[0]);
+    }
+    node->symbol_id = sema->current_function;
+}
+
+static void check_statement(SemanticAnalyzer* sema, ASTNode* node) {
+    if (!node) return;
+
+    node->data_type = TYPE_UNKNOWN;
+    node->symbol_id = -1;
+
+    switch (node->type) {
+        case NODE_VAR_DECL:
+            check_variable_declaration(sema, node);
+            break;
+
+        case NODE_FUNC_DECL:
+            semantic_declare_function(sema, node);
+            semantic_check_function_body(sema, node);
+            break;
+
+        case NODE_COMPOUND_STMT:
+            enter_scope(&sema->table);
+            check_statements(sema, node);
+            exit_scope(&sema->table);
+            break;
+
+        case NODE_IF_STMT:
+        case NODE_WHILE_STMT:
+            // Condição seguida dos comandos (then/else ou corpo)
+            if (node->child_count > 0) check_expression(sema, node->children[0]);
+            for (int i = 1; i < node->child_count; i++) {
+                check_statement(sema, node->children[i]);
+            }
+            break;
+
+        case NODE_RETURN_STMT:
+            check_return(sema, node);
+            break;
+
+        case NODE_EXPRESSION_STMT:
+            if (node->child_count > 0) check_expression(sema, node->children[0]);
+            break;
+
+        default:
+            // Expressão solta (recuperação de erro do parser)
+            check_expression(sema, node);
+            break;
+    }
+}
+
+// ==================== INTERFACE ====================
+
+void semantic_init(SemanticAnalyzer* sema) {
+    init_symbol_table(&sema->table);
+    sema->error_count = 0;
+    sema->report_errors = 1;
+    sema->errors = NULL;
+    sema->error_capacity = 0;
+    sema->current_function = -1;
+    sema->declaration = 0;
+    sema->globals = NULL;
+    sema->arena = NULL;
+    sema->spare_converts = NULL;
+    sema->uses = NULL;
+    sema->use_count = 0;
+    sema->use_capacity = 0;
+    sema->record_uses = 0;
+}
+
+void semantic_free(SemanticAnalyzer* sema) {
+    free_symbol_table(&sema->table);
+    semantic_clear_errors(sema);
+    free(sema->errors);
+    sema->errors = NULL;
+    sema->error_capacity = 0;
+    free(sema->uses);
+    sema->uses = NULL;
+    sema->use_count = sema->use_capacity = 0;
+}
+
+// Descarta as mensagens guardadas (e zera a contagem de erros)
+void semantic_clear_errors(SemanticAnalyzer* sema) {
+    if (!sema->report_errors) {
+        for (int i = 0; i < sema->error_count; i++) free(sema->errors[i].message);
+    }
+    sema->error_count = 0;
+}
+
+/*
+ * Análise de uma declaração (ou comando) de nível superior, no escopo
+ * global. 'index' é a posição da declaração no programa.
+ */
+void semantic_check_declaration(SemanticAnalyzer* sema, ASTNode* node, int index) {
+    sema->declaration = index;
+    check_statement(sema, node);
+}
+
+/*
+ * Analisa o programa, anotando os nós, e devolve o número de erros. Os
+ * símbolos continuam na tabela depois da análise (os IDs anotados apontam
+ * para eles), mas nenhum nome fica visível: o escopo global também fecha.
+ */
+int semantic_analyze(SemanticAnalyzer* sema, ASTNode* program) {
+    if (!program) return sema->error_count;
+
+    program->data_type = TYPE_UNKNOWN;
+    program->symbol_id = -1;
+    for (int i = 0; i < program->child_count; i++) {
+        semantic_check_declaration(sema, program->children[i], i);
+    }
+    semantic_close_globals(sema);
+    return sema->error_count;
+}
+
+// Fecha o escopo global: os símbolos ficam, mas nenhum nome continua visível
+void semantic_close_globals(SemanticAnalyzer* sema) {
+    while (sema->table.scope_depth > 0) exit_scope(&sema->table);
+    undo_declarations(&sema->table, 0);
+}
+
+// Parâmetros e declarações locais: o número de IDs que o corpo vai usar
+static int count_local_declarations(const ASTNode* node) {
+    if (!node) return 0;
+    int total = node->type == NODE_VAR_DECL;
+    if (node->type == NODE_COMPOUND_STMT || node->type == NODE_IF_STMT ||
+        node->type == NODE_WHILE_STMT) {
+        for (int i = 0; i < node->child_count; i++) {
+            total += count_local_declarations(node->children[i]);
+        }
+    }
+    return total;
+}
+
+// IDs reservados logo depois do símbolo da função para o seu corpo
+int semantic_count_locals(const ASTNode* function) {
+    return function->child_count + count_local_declarations(function->right);
+}
+
+/*
+ * Reserva 'count' IDs consecutivos depois do último símbolo, para que
+ * outra tabela (um worker da análise paralela) os preencha sem realocar.
+ */
+void semantic_reserve_symbols(SemanticAnalyzer* sema, int count) {
+    SymbolTable* table = &sema->table;
+    while (table->symbol_count + count > table->symbol_capacity) {
+        table->symbols = grow_array(table->symbols, &table->symbol_capacity, sizeof(Symbol));
+    }
+    table->symbol_count += count;
+}
+
+// Como print_ast, com o tipo e o símbolo de cada nó anotado
+void print_annotated_ast(const SemanticAnalyzer* sema, const ASTNode* node, int depth) {
+    if (!node) return;
+
+    for (int i = 0; i < depth; i++) printf("  ");
+    print_node_label(node->type, node->value);
+    if (node->data_type != TYPE_UNKNOWN) printf("  : %s", data_type_to_string(node->data_type));
+    if (node->symbol_id >= 0) {
+        const Symbol* symbol = &sema->table.symbols[node->symbol_id];
+        printf("  -> #%d (linha %d)", node->symbol_id, symbol->line);
+    }
+    printf("\n");
+
+    print_annotated_ast(sema, node->left, depth + 1);
+    print_annotated_ast(sema, node->right, depth + 1);
+    for (int i = 0; i < node->child_count; i++) {
+        print_annotated_ast(sema, node->children[i], depth + 1);
+    }
+}
+
+void print_symbols(const SemanticAnalyzer* sema) {
+    static const char* kinds[] = {"variável", "parâmetro", "função"};
+
+    printf("\n=== TABELA DE SÍMBOLOS ===\n");
+    printf("%-5s %-15s %-7s %-7s %-7s %s\n", "ID", "Nome", "Tipo", "Linha", "Escopo", "Categoria");
+    for (int i = 0; i < sema->table.symbol_count; i++) {
+        const Symbol* s = &sema->table.symbols[i];
+        printf("#%-4d %-15s %-7s %-7d %-7d %s\n", i, s->name, data_type_to_string(s->type),
+               s->line, s->scope, kinds[s->kind]);
+    }
+}
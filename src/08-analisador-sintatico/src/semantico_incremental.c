@@ -0,0 +1,418 @@
+/*
+ * Análise semântica incremental
+ *
+ * Depois de uma edição, o parser incremental devolve a mesma AST com
+ * poucos nós novos: uma função cujo texto não foi tocado continua sendo o
+ * mesmo nó FUNC_DECL (no máximo com as linhas deslocadas). O resultado da
+ * análise do corpo de uma função depende só do próprio corpo e dos nomes
+ * globais que ele lê, então a sessão guarda, por função:
+ *
+ *   - as dependências: cada nome global lido pelo corpo e o que ele
+ *     designava (categoria, tipo e, para funções, os tipos dos
+ *     parâmetros), ou que o nome não estava declarado;
+ *   - os símbolos do corpo, os erros e as anotações, que ficam nos nós.
+ *
+ * Uma atualização refaz sempre a parte global, que é pequena: variáveis
+ * globais, comandos de nível superior e assinaturas das funções, com a
+ * reserva das faixas de IDs (como a rodada 1 da análise paralela). Depois,
+ * para cada função:
+ *
+ *   - nó novo, ou alguma dependência que agora resolve para outra coisa:
+ *     o corpo é analisado de novo, gravando os nomes globais que lê;
+ *   - nó antigo com as dependências intactas: os símbolos do corpo são
+ *     copiados para a faixa nova e os erros guardados são reaproveitados
+ *     (se a função mudou de linha e tem erros, analisa de novo: as
+ *     mensagens citam linhas). Se os IDs mudaram (uma declaração a mais
+ *     antes da função, por exemplo), uma visita ao corpo renumera as
+ *     anotações, sem conferir tipos nem consultar tabelas.
+ *
+ * Símbolos, erros e anotações ficam idênticos aos de semantic_analyze
+ * sobre a árvore atual. O cache identifica as funções pelos ponteiros dos
+ * nós; depois de uma análise completa do parser (arena compactada), os
+ * ponteiros antigos não valem mais e a atualização recebe invalidate = 1.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "../include/parser.h"
+
+// Uma função do programa atual, na ordem do fonte
+typedef struct {
+    ASTNode* function;
+    int declaration;    // índice no programa
+    int cached;         // entrada do cache anterior, ou -1
+    int locals;
+} SessionTask;
+
+// ==================== CACHE ====================
+
+static unsigned int hash_pointer(const void* pointer) {
+    uintptr_t value = (uintptr_t)pointer;
+    return (unsigned int)((value >> 4) * 2654435761u);
+}
+
+// Tabela aberta nó FUNC_DECL -> entrada do cache anterior
+static int* index_cache(const SemanticSession* session, int* capacity) {
+    *capacity = 16;
+    while (*capacity < session->function_count * 2) *capacity *= 2;
+    int* slots = malloc(*capacity * sizeof(int));
+    for (int i = 0; i < *capacity; i++) slots[i] = -1;
+    for (int f = 0; f < session->function_count; f++) {
+        unsigned int i = hash_pointer(session->functions[f].function) & (*capacity - 1);
+        while (slots[i] != -1) i = (i + 1) & (*capacity - 1);
+        slots[i] = f;
+    }
+    return slots;
+}
+
+static int find_cached(const SemanticSession* session, const int* slots, int capacity,
+                       const ASTNode* function) {
+    unsigned int i = hash_pointer(function) & (capacity - 1);
+    while (slots[i] != -1) {
+        if (session->functions[slots[i]].function == function) return slots[i];
+        i = (i + 1) & (capacity - 1);
+    }
+    return -1;
+}
+
+static void free_cache_entry(FunctionCache* entry) {
+    for (int i = 0; i < entry->error_count; i++) free(entry->errors[i].message);
+    free(entry->errors);
+    free(entry->dependencies);
+    free(entry->param_types);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static void append_error(SemanticAnalyzer* sema, int declaration, int line, const char* message) {
+    if (sema->error_count == sema->error_capacity) {
+        sema->error_capacity = sema->error_capacity ? sema->error_capacity * 2 : 16;
+        sema->errors = realloc(sema->errors, sema->error_capacity * sizeof(SemanticError));
+    }
+    SemanticError* error = &sema->errors[sema->error_count++];
+    error->declaration = declaration;
+    error->line = line;
+    error->message = strdup(message);
+}
+
+// ==================== DEPENDÊNCIAS ====================
+
+// 1 se o símbolo 'id' da tabela global é o que a dependência registrou
+static int dependency_holds(const FunctionCache* entry, const SemanticDependency* dep,
+                            const SemanticAnalyzer* globals, int id) {
+    if (dep->symbol < 0 || id < 0) return dep->symbol < 0 && id < 0;
+    const Symbol* symbol = &globals->table.symbols[id];
+    if (symbol->kind != dep->kind || symbol->type != dep->type) return 0;
+    if (symbol->kind != SYMBOL_FUNCTION || symbol->decl == dep->decl) return 1;
+    if (symbol->decl->child_count != dep->param_count) return 0;
+    for (int i = 0; i < dep->param_count; i++) {
+        const ASTNode* param = symbol->decl->children[i];
+        if (type_from_name(param->left ? param->left->value : NULL) !=
+            entry->param_types[dep->first_param + i]) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Dependências do corpo recém-analisado, a partir dos usos gravados pelo
+ * worker: um registro por símbolo (stamp marca os já vistos nesta função)
+ * e um por nome não declarado.
+ */
+static void record_dependencies(FunctionCache* entry, const SemanticAnalyzer* worker,
+                                const SemanticAnalyzer* globals, int* stamp, int mark) {
+    int capacity = worker->use_count > 0 ? worker->use_count : 1;
+    int param_capacity = 0;
+    entry->dependencies = malloc(capacity * sizeof(SemanticDependency));
+    entry->dependency_count = 0;
+    entry->param_types = NULL;
+
+    int params = 0;
+    for (int u = 0; u < worker->use_count; u++) {
+        const SemanticUse* use = &worker->uses[u];
+        if (use->symbol >= 0) {
+            if (stamp[use->symbol] == mark) continue;
+            stamp[use->symbol] = mark;
+        } else {
+            int seen = 0;
+            for (int d = 0; d < entry->dependency_count && !seen; d++) {
+                const SemanticDependency* dep = &entry->dependencies[d];
+                seen = dep->symbol < 0 && strcmp(dep->name, use->name) == 0;
+            }
+            if (seen) continue;
+        }
+
+        SemanticDependency* dep = &entry->dependencies[entry->dependency_count++];
+        dep->name = use->name;
+        dep->symbol = use->symbol;
+        dep->kind = 0;
+        dep->type = TYPE_UNKNOWN;
+        dep->decl = NULL;
+        dep->param_count = 0;
+        dep->first_param = params;
+        if (use->symbol < 0) continue;
+
+        const Symbol* symbol = &globals->table.symbols[use->symbol];
+        dep->kind = symbol->kind;
+        dep->type = symbol->type;
+        dep->decl = symbol->decl;
+        if (symbol->kind != SYMBOL_FUNCTION) continue;
+        dep->param_count = symbol->decl->child_count;
+        while (params + dep->param_count > param_capacity) {
+            param_capacity = param_capacity ? param_capacity * 2 : 8;
+            entry->param_types = realloc(entry->param_types, param_capacity);
+        }
+        for (int i = 0; i < dep->param_count; i++) {
+            const ASTNode* param = symbol->decl->children[i];
+            entry->param_types[params++] = type_from_name(param->left ? param->left->value : NULL);
+        }
+    }
+}
+
+// ==================== REAPROVEITAMENTO ====================
+
+// Renumeração das anotações de um corpo aproveitado
+typedef struct {
+    int first;          // faixa antiga da função e do corpo
+    int last;
+    int delta;
+    const SemanticDependency* dependencies;   // IDs antigos
+    const int* resolved;                      // IDs novos, na mesma ordem
+    int count;
+} SymbolRemap;
+
+static void remap_symbols(ASTNode* node, const SymbolRemap* remap) {
+    if (!node) return;
+    int id = node->symbol_id;
+    if (id >= remap->first && id <= remap->last) {
+        node->symbol_id = id + remap->delta;
+    } else if (id >= 0) {
+        for (int d = 0; d < remap->count; d++) {
+            if (remap->dependencies[d].symbol == id) {
+                node->symbol_id = remap->resolved[d];
+                break;
+            }
+        }
+    }
+    remap_symbols(node->left, remap);
+    remap_symbols(node->right, remap);
+    for (int i = 0; i < node->child_count; i++) {
+        remap_symbols(node->children[i], remap);
+    }
+}
+
+/*
+ * Tenta aproveitar a análise guardada do corpo. Devolve 0 (sem mudar nada)
+ * se o corpo precisa ser analisado de novo. 'resolved' tem espaço para as
+ * dependências da entrada.
+ */
+static int reuse_function(FunctionCache* entry, ASTNode* function, const SemanticAnalyzer* previous,
+                          SemanticAnalyzer* sema, int* resolved, SemanticIncrementalStats* stats) {
+    if (function->line != entry->line && entry->error_count > 0) return 0;
+
+    int id = function->symbol_id;
+    int renumbered = id != entry->symbol;
+    for (int d = 0; d < entry->dependency_count; d++) {
+        const SemanticDependency* dep = &entry->dependencies[d];
+        resolved[d] = semantic_lookup_global(sema, dep->name, id);
+        if (!dependency_holds(entry, dep, sema, resolved[d])) return 0;
+        renumbered |= resolved[d] != dep->symbol;
+    }
+    stats->dependencies += entry->dependency_count;
+
+    // Símbolos do corpo na faixa nova; as linhas andam com a função
+    Symbol* symbols = &sema->table.symbols[id + 1];
+    memcpy(symbols, &previous->table.symbols[entry->symbol + 1], entry->locals * sizeof(Symbol));
+    if (function->line != entry->line) {
+        for (int i = 0; i < entry->locals; i++) symbols[i].line = symbols[i].decl->line;
+    }
+
+    if (renumbered) {
+        SymbolRemap remap = {entry->symbol, entry->symbol + entry->locals, id - entry->symbol,
+                             entry->dependencies, resolved, entry->dependency_count};
+        for (int i = 0; i < function->child_count; i++) remap_symbols(function->children[i], &remap);
+        remap_symbols(function->right, &remap);
+        stats->remapped++;
+    }
+    for (int d = 0; d < entry->dependency_count; d++) {
+        entry->dependencies[d].symbol = resolved[d];
+        entry->dependencies[d].decl = resolved[d] >= 0 ? sema->table.symbols[resolved[d]].decl : NULL;
+    }
+    entry->symbol = id;
+    entry->line = function->line;
+    return 1;
+}
+
+// ==================== ERROS ====================
+
+/*
+ * Junta os erros da parte global e dos corpos na ordem do fonte: as duas
+ * listas já estão ordenadas por declaração, e na mesma declaração os da
+ * parte global (a assinatura da função) vêm antes dos do corpo.
+ */
+static void merge_errors(SemanticAnalyzer* sema, SemanticError* global, int global_count,
+                         SemanticError* body, int body_count) {
+    int total = global_count + body_count;
+    SemanticError* merged = malloc((total > 0 ? total : 1) * sizeof(SemanticError));
+    int g = 0, b = 0;
+    for (int k = 0; k < total; k++) {
+        if (b == body_count || (g < global_count && global[g].declaration <= body[b].declaration)) {
+            merged[k] = global[g++];
+        } else {
+            merged[k] = body[b++];
+        }
+    }
+    free(sema->errors);
+    sema->errors = merged;
+    sema->error_capacity = total > 0 ? total : 1;
+    sema->error_count = total;
+}
+
+// ==================== INTERFACE ====================
+
+void semantic_session_init(SemanticSession* session, Arena* arena) {
+    semantic_init(&session->sema);
+    session->sema.report_errors = 0;
+    session->sema.arena = arena;
+    session->functions = NULL;
+    session->function_count = 0;
+}
+
+void semantic_session_free(SemanticSession* session) {
+    for (int f = 0; f < session->function_count; f++) free_cache_entry(&session->functions[f]);
+    free(session->functions);
+    session->functions = NULL;
+    session->function_count = 0;
+    semantic_free(&session->sema);
+}
+
+/*
+ * Analisa o programa aproveitando a análise anterior da sessão e devolve o
+ * número de erros (guardados em session->sema.errors, na ordem do fonte).
+ * Com invalidate, os nós da análise anterior não existem mais e todos os
+ * corpos são analisados de novo.
+ */
+int semantic_session_update(SemanticSession* session, ASTNode* program, int invalidate,
+                            SemanticIncrementalStats* stats) {
+    SemanticIncrementalStats local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (!program) return session->sema.error_count;
+
+    SemanticAnalyzer sema;
+    semantic_init(&sema);
+    sema.report_errors = 0;
+    sema.arena = session->sema.arena;
+    if (session->sema.table.symbol_count > 0) {
+        // O vetor de símbolos já nasce com o tamanho da análise anterior
+        sema.table.symbol_capacity = session->sema.table.symbol_count;
+        sema.table.symbols = malloc(sema.table.symbol_capacity * sizeof(Symbol));
+    }
+
+    int slot_capacity = 0;
+    int* slots = invalidate ? NULL : index_cache(session, &slot_capacity);
+
+    // Parte global: declarações, comandos e assinaturas, com as faixas de IDs
+    program->data_type = TYPE_UNKNOWN;
+    program->symbol_id = -1;
+    SessionTask* tasks = malloc((program->child_count > 0 ? program->child_count : 1) * sizeof(SessionTask));
+    int task_count = 0;
+    for (int i = 0; i < program->child_count; i++) {
+        ASTNode* node = program->children[i];
+        if (!node || node->type != NODE_FUNC_DECL) {
+            semantic_check_declaration(&sema, node, i);
+            continue;
+        }
+        SessionTask* task = &tasks[task_count++];
+        task->function = node;
+        task->declaration = i;
+        task->cached = slots ? find_cached(session, slots, slot_capacity, node) : -1;
+        task->locals = task->cached >= 0 ? session->functions[task->cached].locals
+                                         : semantic_count_locals(node);
+        sema.declaration = i;
+        semantic_declare_function(&sema, node);
+        semantic_reserve_symbols(&sema, task->locals);
+    }
+    free(slots);
+
+    // Corpos analisados de novo usam uma tabela de worker sobre o vetor global
+    SemanticAnalyzer worker;
+    semantic_init(&worker);
+    worker.report_errors = 0;
+    worker.globals = &sema;
+    worker.arena = sema.arena;
+    worker.record_uses = 1;
+    free(worker.table.symbols);
+    worker.table.symbols = sema.table.symbols;
+    worker.table.symbol_capacity = sema.table.symbol_capacity;
+
+    int* stamp = calloc(sema.table.symbol_count > 0 ? sema.table.symbol_count : 1, sizeof(int));
+    int resolved_capacity = 16;
+    int* resolved = malloc(resolved_capacity * sizeof(int));
+    FunctionCache* cache = calloc(task_count > 0 ? task_count : 1, sizeof(FunctionCache));
+
+    for (int t = 0; t < task_count; t++) {
+        SessionTask* task = &tasks[t];
+        if (task->cached >= 0) {
+            FunctionCache* entry = &session->functions[task->cached];
+            if (entry->dependency_count > resolved_capacity) {
+                resolved_capacity = entry->dependency_count;
+                resolved = realloc(resolved, resolved_capacity * sizeof(int));
+            }
+            if (reuse_function(entry, task->function, &session->sema, &sema, resolved, stats)) {
+                for (int e = 0; e < entry->error_count; e++) {
+                    append_error(&worker, task->declaration, entry->errors[e].line, entry->errors[e].message);
+                }
+                cache[t] = *entry;
+                memset(entry, 0, sizeof(*entry));
+                stats->reused++;
+                continue;
+            }
+        }
+
+        worker.declaration = task->declaration;
+        worker.table.symbol_count = task->function->symbol_id + 1;
+        worker.use_count = 0;
+        int first_error = worker.error_count;
+        semantic_check_function_body(&worker, task->function);
+
+        FunctionCache* entry = &cache[t];
+        entry->function = task->function;
+        entry->line = task->function->line;
+        entry->symbol = task->function->symbol_id;
+        entry->locals = task->locals;
+        record_dependencies(entry, &worker, &sema, stamp, t + 1);
+        entry->error_count = worker.error_count - first_error;
+        entry->errors = malloc((entry->error_count > 0 ? entry->error_count : 1) * sizeof(SemanticError));
+        for (int e = 0; e < entry->error_count; e++) {
+            entry->errors[e] = worker.errors[first_error + e];
+            entry->errors[e].message = strdup(entry->errors[e].message);
+        }
+        stats->rechecked++;
+    }
+
+    // Erros na ordem do fonte; os corpos ficaram em worker.errors
+    SemanticError* global = sema.errors;
+    int global_count = sema.error_count;
+    sema.errors = NULL;
+    merge_errors(&sema, global, global_count, worker.errors, worker.error_count);
+    free(global);
+    free(worker.errors);
+    worker.errors = NULL;
+    worker.error_count = 0;
+    semantic_close_globals(&sema);
+
+    worker.table.symbols = NULL;   // pertence à tabela global
+    semantic_free(&worker);
+
+    // A análise nova substitui a anterior
+    for (int f = 0; f < session->function_count; f++) free_cache_entry(&session->functions[f]);
+    free(session->functions);
+    semantic_free(&session->sema);
+    session->sema = sema;
+    session->functions = cache;
+    session->function_count = task_count;
+
+    stats->functions = task_count;
+    free(resolved);
+    free(stamp);
+    free(tasks);
+    return sema.error_count;
+}
@@ -0,0 +1,252 @@
+/*
+ * Análise semântica paralela por função
+ *
+ * Depois que os nomes globais são conhecidos, o corpo de uma função só lê
+ * a tabela global e declara nomes próprios (parâmetros e locais). Os IDs
+ * de símbolo seguem a ordem das declarações no fonte, então cada função
+ * precisa saber, antes de começar, a partir de qual ID numerar os seus.
+ * A análise é feita em três rodadas:
+ *
+ * 0. Paralela: conta os parâmetros e declarações locais de cada função
+ *    (só os comandos são visitados, não as expressões).
+ * 1. Sequencial, na ordem do fonte: variáveis globais, comandos de nível
+ *    superior e a assinatura (nome e tipo de retorno) de cada função,
+ *    reservando logo depois dela a faixa de IDs do seu corpo. O vetor de
+ *    símbolos não cresce mais depois desta rodada.
+ * 2. Paralela: os corpos das funções, com tabela de escopos própria em
+ *    cada worker; os símbolos são gravados direto na faixa reservada do
+ *    vetor compartilhado, os erros vão para um buffer por worker, marcados
+ *    com a declaração de origem, e os nós CONVERT para a arena do worker,
+ *    juntada depois à arena do programa.
+ *
+ * As rodadas paralelas usam um pool com roubo de trabalho: cada worker tem
+ * uma fila de funções contíguas no fonte, consome a sua pela frente e,
+ * quando ela acaba, rouba do fim da fila de outro worker. No final os
+ * buffers são juntados na ordem do fonte: a saída, os IDs e as anotações
+ * são idênticos aos de semantic_analyze.
+ */
+
+#include <pthread.h>
+#include "../include/parser.h"
+
+typedef struct {
+    ASTNode* function;
+    int declaration;    // índice no programa (ordem das mensagens)
+    int locals;         // parâmetros + declarações locais (rodada 0)
+} SemanticTask;
+
+// Fila de um worker: tarefas [head, tail) ainda não iniciadas
+typedef struct {
+    pthread_mutex_t lock;
+    int head;
+    int tail;
+} TaskQueue;
+
+typedef struct {
+    SemanticAnalyzer sema;
+    Arena arena;        // nós CONVERT inseridos pelo worker
+    SemanticTask* tasks;
+    int counting;       // 1 na rodada 0, 0 na rodada 2
+    TaskQueue* queues;
+    int index;
+    int worker_count;
+    int steals;
+} SemanticWorker;
+
+static int take_task(TaskQueue* queue, int from_tail) {
+    int task = -1;
+    pthread_mutex_lock(&queue->lock);
+    if (queue->head < queue->tail) {
+        task = from_tail ? --queue->tail : queue->head++;
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return task;
+}
+
+static void* semantic_worker(void* arg) {
+    SemanticWorker* worker = arg;
+
+    while (1) {
+        int task = take_task(&worker->queues[worker->index], 0);
+
+        // Fila vazia: procura trabalho nas outras, a partir da vizinha
+        for (int k = 1; task < 0 && k < worker->worker_count; k++) {
+            task = take_task(&worker->queues[(worker->index + k) % worker->worker_count], 1);
+            if (task >= 0) worker->steals++;
+        }
+        if (task < 0) break;
+
+        SemanticTask* t = &worker->tasks[task];
+        if (worker->counting) {
+            t->locals = semantic_count_locals(t->function);
+            continue;
+        }
+        worker->sema.declaration = t->declaration;
+        worker->sema.table.symbol_count = t->function->symbol_id + 1;
+        semantic_check_function_body(&worker->sema, t->function);
+    }
+
+    return NULL;
+}
+
+// Uma rodada do pool: filas com blocos contíguos de tarefas, um worker por fila
+static void run_round(SemanticWorker* workers, TaskQueue* queues, pthread_t* threads,
+                      int worker_count, int task_count, int counting) {
+    for (int w = 0; w < worker_count; w++) {
+        queues[w].head = (int)((long)task_count * w / worker_count);
+        queues[w].tail = (int)((long)task_count * (w + 1) / worker_count);
+        workers[w].counting = counting;
+    }
+    for (int w = 0; w < worker_count; w++) {
+        pthread_create(&threads[w], NULL, semantic_worker, &workers[w]);
+    }
+    for (int w = 0; w < worker_count; w++) {
+        pthread_join(threads[w], NULL);
+    }
+}
+
+/*
+ * Junta os erros da rodada sequencial e dos workers na ordem do fonte e os
+ * imprime (ou os deixa em sema->errors, se report_errors for 0). Os erros
+ * de uma declaração vêm de uma só fonte (ou da rodada 1 e, depois, de um
+ * único worker), então uma ordenação estável por declaração basta: uma
+ * contagem por declaração, na ordem rodada 1, worker 0, worker 1...
+ */
+static void merge_errors(SemanticAnalyzer* sema, SemanticError* phase1, int phase1_count,
+                         SemanticWorker* workers, int worker_count, int declarations) {
+    int* start = calloc(declarations + 1, sizeof(int));
+    int total = phase1_count;
+    for (int i = 0; i < phase1_count; i++) start[phase1[i].declaration + 1]++;
+    for (int w = 0; w < worker_count; w++) {
+        for (int i = 0; i < workers[w].sema.error_count; i++) {
+            start[workers[w].sema.errors[i].declaration + 1]++;
+        }
+        total += workers[w].sema.error_count;
+    }
+    for (int d = 0; d < declarations; d++) start[d + 1] += start[d];
+
+    SemanticError* merged = malloc((total > 0 ? total : 1) * sizeof(SemanticError));
+    for (int i = 0; i < phase1_count; i++) merged[start[phase1[i].declaration]++] = phase1[i];
+    for (int w = 0; w < worker_count; w++) {
+        for (int i = 0; i < workers[w].sema.error_count; i++) {
+            const SemanticError* error = &workers[w].sema.errors[i];
+            merged[start[error->declaration]++] = *error;
+        }
+        workers[w].sema.error_count = 0;   // as mensagens passaram para 'merged'
+    }
+    free(start);
+
+    if (sema->report_errors) {
+        for (int i = 0; i < total; i++) {
+            printf("Erro semântico na linha %d: %s\n", merged[i].line, merged[i].message);
+            free(merged[i].message);
+        }
+        free(merged);
+    } else {
+        free(sema->errors);
+        sema->errors = merged;
+        sema->error_capacity = total > 0 ? total : 1;
+    }
+    sema->error_count = total;
+}
+
+/*
+ * Análise com até num_threads workers. Devolve o número de erros, como
+ * semantic_analyze. Em stats (opcional) ficam o número de funções, de
+ * workers e de tarefas roubadas.
+ */
+int semantic_analyze_parallel(SemanticAnalyzer* sema, ASTNode* program, int num_threads,
+                              SemanticParallelStats* stats) {
+    if (!program) return sema->error_count;
+
+    program->data_type = TYPE_UNKNOWN;
+    program->symbol_id = -1;
+    SemanticTask* tasks = malloc((program->child_count > 0 ? program->child_count : 1) * sizeof(SemanticTask));
+    int task_count = 0;
+    for (int i = 0; i < program->child_count; i++) {
+        ASTNode* node = program->children[i];
+        if (node && node->type == NODE_FUNC_DECL) {
+            tasks[task_count].function = node;
+            tasks[task_count].declaration = i;
+            task_count++;
+        }
+    }
+
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > task_count) num_threads = task_count > 0 ? task_count : 1;
+
+    SemanticWorker* workers = calloc(num_threads, sizeof(SemanticWorker));
+    TaskQueue* queues = malloc(num_threads * sizeof(TaskQueue));
+    pthread_t* threads = malloc(num_threads * sizeof(pthread_t));
+    for (int w = 0; w < num_threads; w++) {
+        pthread_mutex_init(&queues[w].lock, NULL);
+        semantic_init(&workers[w].sema);
+        workers[w].sema.report_errors = 0;
+        workers[w].sema.globals = sema;
+        arena_init(&workers[w].arena);
+        if (sema->arena) workers[w].sema.arena = &workers[w].arena;
+        workers[w].tasks = tasks;
+        workers[w].queues = queues;
+        workers[w].index = w;
+        workers[w].worker_count = num_threads;
+    }
+
+    // Rodada 0: tamanho da faixa de IDs de cada corpo
+    run_round(workers, queues, threads, num_threads, task_count, 1);
+
+    // Rodada 1: os erros ficam guardados até a junção
+    int report = sema->report_errors;
+    sema->report_errors = 0;
+    int next_task = 0;
+    for (int i = 0; i < program->child_count; i++) {
+        ASTNode* node = program->children[i];
+        if (!node || node->type != NODE_FUNC_DECL) {
+            semantic_check_declaration(sema, node, i);
+            continue;
+        }
+        sema->declaration = i;
+        semantic_declare_function(sema, node);
+        semantic_reserve_symbols(sema, tasks[next_task++].locals);
+    }
+
+    // Rodada 2: os símbolos vão direto para o vetor global, nas faixas reservadas
+    for (int w = 0; w < num_threads; w++) {
+        free(workers[w].sema.table.symbols);
+        workers[w].sema.table.symbols = sema->table.symbols;
+        workers[w].sema.table.symbol_capacity = sema->table.symbol_capacity;
+    }
+    run_round(workers, queues, threads, num_threads, task_count, 0);
+
+    // Junta os erros na ordem do fonte
+    SemanticError* phase1 = sema->errors;
+    int phase1_count = sema->error_count;
+    sema->errors = NULL;
+    sema->error_capacity = 0;
+    sema->report_errors = report;
+    merge_errors(sema, phase1, phase1_count, workers, num_threads, program->child_count);
+    free(phase1);
+
+    int steals = 0;
+    for (int w = 0; w < num_threads; w++) {
+        steals += workers[w].steals;
+        workers[w].sema.table.symbols = NULL;   // pertence à tabela global
+        if (sema->arena) arena_merge(sema->arena, &workers[w].arena);
+        semantic_free(&workers[w].sema);
+        pthread_mutex_destroy(&queues[w].lock);
+    }
+
+    // Como no modo sequencial, nenhum nome global continua visível
+    semantic_close_globals(sema);
+
+    if (stats) {
+        stats->functions = task_count;
+        stats->threads_used = num_threads;
+        stats->steals = steals;
+    }
+
+    free(threads);
+    free(queues);
+    free(workers);
+    free(tasks);
+    return sema->error_count;
+}
@@ -0,0 +1,336 @@
+/*
+ * Gerador da tabela de tipos dos operadores
+ *
+ * Lê a especificação declarativa (gramaticas/tipos.spec) e grava um
+ * cabeçalho C usado pela análise semântica (semantico.c):
+ *
+ *     tiposgen gramaticas/tipos.spec -o build/tabela_tipos.h
+ *
+ * As regras são expandidas em uma tabela densa
+ *
+ *     type_rules[operador][tipo esquerdo][tipo direito] = {resultado, operandos}
+ *
+ * indexada pelos IDs dos operadores (na ordem em que aparecem na
+ * especificação) e pelos valores de DataType. Os índices de tipo são
+ * escritos como inicializadores designados com os nomes TYPE_<NOME>, então
+ * a tabela acompanha o enum de parser.h sem que o gerador conheça os
+ * valores. A primeira regra que cobre uma combinação vale; regras que não
+ * acrescentam nenhuma combinação são reportadas.
+ *
+ * O nó da AST guarda o operador como texto; o cabeçalho traz também o
+ * mapa caractere x forma -> ID (forma 0: só o caractere, 1: seguido de
+ * '=', 2: dobrado, como em "&&"), que cobre todos os operadores da
+ * linguagem sem comparar strings.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define MAX_TYPES 8
+#define MAX_GROUPS 16
+#define MAX_OPERATORS 32
+#define MAX_WORDS 32
+#define NO_TYPE (-1)
+
+typedef struct {
+    char name[32];
+    unsigned int members;   // bit i = tipo i
+} TypeGroup;
+
+typedef struct {
+    int result;             // NO_TYPE = combinação sem regra
+    int operand;            // NO_TYPE = operandos mantidos
+    int line;               // linha da regra que preencheu a célula
+} Cell;
+
+typedef struct {
+    char types[MAX_TYPES][32];
+    int type_count;
+    TypeGroup groups[MAX_GROUPS];
+    int group_count;
+    char operators[MAX_OPERATORS][4];
+    int operator_count;
+    int rule_count;
+    Cell cells[MAX_OPERATORS][MAX_TYPES][MAX_TYPES];
+} TypeSpec;
+
+static int find_type(const TypeSpec* spec, const char* name) {
+    for (int i = 0; i < spec->type_count; i++) {
+        if (strcmp(spec->types[i], name) == 0) return i;
+    }
+    return NO_TYPE;
+}
+
+// Conjunto de tipos de um nome (tipo ou grupo); 0 se o nome não existe
+static unsigned int type_set(const TypeSpec* spec, const char* name) {
+    int type = find_type(spec, name);
+    if (type != NO_TYPE) return 1u << type;
+    for (int i = 0; i < spec->group_count; i++) {
+        if (strcmp(spec->groups[i].name, name) == 0) return spec->groups[i].members;
+    }
+    return 0;
+}
+
+// Forma do operador no mapa de IDs: 0 = "c", 1 = "c=", 2 = "cc"; -1 se não cabe
+static int operator_form(const char* op) {
+    if ((unsigned char)op[0] >= 128 || op[0] == '\0') return -1;
+    if (op[1] == '\0') return 0;
+    if (op[2] != '\0') return -1;
+    if (op[1] == '=') return 1;
+    if (op[1] == op[0]) return 2;
+    return -1;
+}
+
+static int find_operator(TypeSpec* spec, const char* op, int create) {
+    for (int i = 0; i < spec->operator_count; i++) {
+        if (strcmp(spec->operators[i], op) == 0) return i;
+    }
+    if (!create || spec->operator_count == MAX_OPERATORS) return -1;
+    strcpy(spec->operators[spec->operator_count], op);
+    for (int l = 0; l < MAX_TYPES; l++) {
+        for (int r = 0; r < MAX_TYPES; r++) {
+            spec->cells[spec->operator_count][l][r] = (Cell){NO_TYPE, NO_TYPE, 0};
+        }
+    }
+    return spec->operator_count++;
+}
+
+// ==================== LEITURA ====================
+
+static int split_words(char* line, char* words[]) {
+    char* comment = strchr(line, '#');
+    if (comment) *comment = '\0';
+    int count = 0;
+    for (char* word = strtok(line, " \t\r\n"); word; word = strtok(NULL, " \t\r\n")) {
+        if (count == MAX_WORDS) return -1;
+        words[count++] = word;
+    }
+    return count;
+}
+
+static int read_types(TypeSpec* spec, char* words[], int count, const char* file, int line) {
+    for (int i = 1; i < count; i++) {
+        if (spec->type_count == MAX_TYPES || strlen(words[i]) >= 32 || find_type(spec, words[i]) != NO_TYPE) {
+            fprintf(stderr, "%s:%d: tipo '%s' repetido ou tipos demais\n", file, line, words[i]);
+            return 0;
+        }
+        strcpy(spec->types[spec->type_count++], words[i]);
+    }
+    return 1;
+}
+
+static int read_group(TypeSpec* spec, char* words[], int count, const char* file, int line) {
+    if (count < 4 || strcmp(words[2], "=") != 0 || spec->group_count == MAX_GROUPS ||
+        strlen(words[1]) >= 32) {
+        fprintf(stderr, "%s:%d: esperado 'grupo nome = tipo...'\n", file, line);
+        return 0;
+    }
+    TypeGroup* group = &spec->groups[spec->group_count];
+    strcpy(group->name, words[1]);
+    group->members = 0;
+    for (int i = 3; i < count; i++) {
+        int type = find_type(spec, words[i]);
+        if (type == NO_TYPE) {
+            fprintf(stderr, "%s:%d: '%s' não é um tipo\n", file, line, words[i]);
+            return 0;
+        }
+        group->members |= 1u << type;
+    }
+    spec->group_count++;
+    return 1;
+}
+
+// operador... esquerdo direito -> operandos resultado
+static int read_rule(TypeSpec* spec, char* words[], int count, const char* file, int line) {
+    int ops = 0;
+    while (ops < count && !isalpha((unsigned char)words[ops][0])) ops++;
+    if (ops == 0 || count != ops + 5 || strcmp(words[ops + 2], "->") != 0) {
+        fprintf(stderr, "%s:%d: esperado 'operador... esquerdo direito -> operandos resultado'\n", file, line);
+        return 0;
+    }
+
+    unsigned int left = type_set(spec, words[ops]);
+    unsigned int right = type_set(spec, words[ops + 1]);
+    int operand = strcmp(words[ops + 3], "-") == 0 ? NO_TYPE : find_type(spec, words[ops + 3]);
+    int result = find_type(spec, words[ops + 4]);
+    if (!left || !right || result == NO_TYPE ||
+        (operand == NO_TYPE && strcmp(words[ops + 3], "-") != 0)) {
+        fprintf(stderr, "%s:%d: tipo ou grupo desconhecido na regra\n", file, line);
+        return 0;
+    }
+
+    int added = 0;
+    for (int i = 0; i < ops; i++) {
+        int op = operator_form(words[i]) < 0 ? -1 : find_operator(spec, words[i], 1);
+        if (op < 0) {
+            fprintf(stderr, "%s:%d: operador '%s' inválido ou operadores demais\n", file, line, words[i]);
+            return 0;
+        }
+        for (int l = 0; l < spec->type_count; l++) {
+            if (!(left & (1u << l))) continue;
+            for (int r = 0; r < spec->type_count; r++) {
+                Cell* cell = &spec->cells[op][l][r];
+                if (!(right & (1u << r)) || cell->result != NO_TYPE) continue;
+                *cell = (Cell){result, operand, line};
+                added++;
+            }
+        }
+    }
+    if (added == 0) {
+        fprintf(stderr, "%s:%d: aviso: regra coberta por regras anteriores\n", file, line);
+    }
+    spec->rule_count++;
+    return 1;
+}
+
+static int load_spec(TypeSpec* spec, const char* filename) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Erro: não foi possível abrir o arquivo '%s'\n", filename);
+        return 0;
+    }
+
+    char buffer[512];
+    char* words[MAX_WORDS];
+    int line = 0, ok = 1;
+    while (ok && fgets(buffer, sizeof(buffer), file)) {
+        line++;
+        int count = split_words(buffer, words);
+        if (count == 0) continue;
+        if (count < 0) {
+            fprintf(stderr, "%s:%d: linha longa demais\n", filename, line);
+            ok = 0;
+        } else if (strcmp(words[0], "tipos") == 0) {
+            ok = read_types(spec, words, count, filename, line);
+        } else if (spec->type_count == 0) {
+            fprintf(stderr, "%s:%d: a linha 'tipos' deve vir primeiro\n", filename, line);
+            ok = 0;
+        } else if (strcmp(words[0], "grupo") == 0) {
+            ok = read_group(spec, words, count, filename, line);
+        } else {
+            ok = read_rule(spec, words, count, filename, line);
+        }
+    }
+    fclose(file);
+
+    if (ok && spec->operator_count == 0) {
+        fprintf(stderr, "%s: nenhuma regra\n", filename);
+        ok = 0;
+    }
+    return ok;
+}
+
+// ==================== SAÍDA ====================
+
+static void type_constant(const TypeSpec* spec, int type, char* out) {
+    if (type == NO_TYPE) {
+        strcpy(out, "TYPE_UNKNOWN");
+        return;
+    }
+    strcpy(out, "TYPE_");
+    for (int i = 0; spec->types[type][i]; i++) {
+        out[5 + i] = toupper((unsigned char)spec->types[type][i]);
+        out[6 + i] = '\0';
+    }
+}
+
+static int write_table(const TypeSpec* spec, const char* output, const char* source) {
+    FILE* out = fopen(output, "w");
+    if (!out) {
+        fprintf(stderr, "Erro: não foi possível criar o arquivo '%s'\n", output);
+        return 0;
+    }
+
+    fprintf(out, "/* Gerado por tiposgen a partir de %s. Não edite. */\n\n", source);
+    fprintf(out, "#define TYPE_OPERATORS %d\n\n", spec->operator_count);
+    fprintf(out, "// Resultado (TYPE_UNKNOWN = combinação inválida) e tipo dos operandos\n");
+    fprintf(out, "// depois da conversão implícita (TYPE_UNKNOWN = sem conversão)\n");
+    fprintf(out, "typedef struct {\n    uint8_t result;\n    uint8_t operand;\n} TypeRule;\n\n");
+
+    fprintf(out, "static const char* const type_operator_names[TYPE_OPERATORS] = {");
+    for (int i = 0; i < spec->operator_count; i++) {
+        fprintf(out, "%s\"%s\"", i ? ", " : "", spec->operators[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    // Um inicializador por caractere, com as três formas
+    fprintf(out, "// [caractere][forma] -> ID + 1 (0 = operador sem regras)\n");
+    fprintf(out, "static const uint8_t type_operator_ids[128][3] = {\n");
+    for (int c = 0; c < 128; c++) {
+        int ids[3] = {0, 0, 0}, used = 0;
+        for (int i = 0; i < spec->operator_count; i++) {
+            if ((unsigned char)spec->operators[i][0] == c) {
+                ids[operator_form(spec->operators[i])] = i + 1;
+                used = 1;
+            }
+        }
+        if (used) fprintf(out, "    [%d] = {%d, %d, %d},   // '%c'\n", c, ids[0], ids[1], ids[2], c);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const TypeRule type_rules[TYPE_OPERATORS][TYPE_ERROR + 1][TYPE_ERROR + 1] = {\n");
+    char left[40], right[40], operand[40], result[40];
+    for (int op = 0; op < spec->operator_count; op++) {
+        fprintf(out, "    // %d: %s\n", op, spec->operators[op]);
+        for (int l = 0; l < spec->type_count; l++) {
+            for (int r = 0; r < spec->type_count; r++) {
+                const Cell* cell = &spec->cells[op][l][r];
+                if (cell->result == NO_TYPE) continue;
+                type_constant(spec, l, left);
+                type_constant(spec, r, right);
+                type_constant(spec, cell->operand, operand);
+                type_constant(spec, cell->result, result);
+                fprintf(out, "    [%d][%s][%s] = {%s, %s},   // linha %d\n",
+                        op, left, right, result, operand, cell->line);
+            }
+        }
+    }
+    fprintf(out, "};\n");
+
+    int ok = fclose(out) == 0;
+    if (!ok) fprintf(stderr, "Erro: falha ao gravar o arquivo '%s'\n", output);
+    return ok;
+}
+
+// ==================== PROGRAMA ====================
+
+int main(int argc, char* argv[]) {
+    const char* spec_file = NULL;
+    const char* output = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] != '-' && !spec_file) {
+            spec_file = argv[i];
+        } else {
+            spec_file = NULL;
+            break;
+        }
+    }
+
+    if (!spec_file) {
+        printf("Uso: %s tipos.spec [-o tabela.h]\n", argv[0]);
+        return 1;
+    }
+
+    TypeSpec* spec = calloc(1, sizeof(TypeSpec));
+    int ok = load_spec(spec, spec_file);
+    if (ok) {
+        int valid = 0;
+        for (int op = 0; op < spec->operator_count; op++) {
+            for (int l = 0; l < spec->type_count; l++) {
+                for (int r = 0; r < spec->type_count; r++) valid += spec->cells[op][l][r].result != NO_TYPE;
+            }
+        }
+        printf("%s: %d tipos, %d operadores, %d regras, %d de %d combinações válidas\n",
+               spec_file, spec->type_count, spec->operator_count, spec->rule_count, valid,
+               spec->operator_count * spec->type_count * spec->type_count);
+        if (output) ok = write_table(spec, output, spec_file);
+    }
+
+    free(spec);
+    return ok ? 0 : 1;
+}
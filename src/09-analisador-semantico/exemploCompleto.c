@@ -7,10 +7,12 @@
  * 1. Declaração de variáveis antes do uso
  * 2. Compatibilidade de tipos em operações
  * 3. Compatibilidade de tipos em atribuições
- * 4. Verificação de escopo de variáveis
+ * 4. Verificação de escopo de variáveis (blocos { } aninhados)
  * 5. Detecção de redeclaração de variáveis
  * 6. Verificação de tipos em chamadas de função
  * 7. Detecção de divisão por zero em tempo de compilação
+ * 8. Avaliação de expressões constantes: o valor de cada variável
+ *    inicializada com constantes fica registrado na tabela de símbolos
  * 
  * TIPOS SUPORTADOS:
  * - int: números inteiros
@@ -20,7 +22,8 @@
  * 
  * GRAMÁTICA SIMPLIFICADA:
  * program      ::= declaration*
- * declaration  ::= var_decl | assignment
+ * declaration  ::= var_decl | assignment | block
+ * block        ::= '{' declaration* '}'
  * var_decl     ::= type IDENTIFIER ('=' expression)? ';'
  * assignment   ::= IDENTIFIER '=' expression ';'
  * type         ::= 'int' | 'float' | 'char' | 'bool'
@@ -28,6 +31,11 @@
  * term         ::= factor (('*' | '/' | '==' | '!=') factor)*
  * factor       ::= NUMBER | IDENTIFIER | '(' expression ')'
  * 
+ * Uso:
+ *   ./exemploCompleto                    exemplos
+ *   ./exemploCompleto --benchmark [N]    tabela de símbolos com N declarações
+ *                                        e diagnósticos de N linhas com erro
+ *
  * Autor: Disciplina de Compiladores
  * Data: 2024
  */
@@ -36,10 +44,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <time.h>
 
 #define MAX_TOKEN_LENGTH 100
-#define MAX_VARIABLES 100
-#define MAX_ERRORS 50
 
 // Tipos de dados
 typedef enum {
@@ -73,22 +82,27 @@ typedef enum {
     TOKEN_OR,           // ||
     TOKEN_LPAREN,       // (
     TOKEN_RPAREN,       // )
+    TOKEN_LBRACE,       // {
+    TOKEN_RBRACE,       // }
     TOKEN_SEMICOLON,    // ;
     TOKEN_EOF,
     TOKEN_ERROR
 } TokenType;
 
+// Valor de um literal, ou de uma variável/expressão conhecido na compilação
+typedef union {
+    int int_val;
+    float float_val;
+    char char_val;
+    int bool_val;
+} Value;
+
 // Token
 typedef struct {
     TokenType type;
     char lexeme[MAX_TOKEN_LENGTH];
     DataType data_type;
-    union {
-        int int_val;
-        float float_val;
-        char char_val;
-        int bool_val;
-    } value;
+    Value value;
     int line;
 } Token;
 
@@ -97,20 +111,109 @@ typedef struct {
     char name[MAX_TOKEN_LENGTH];
     DataType type;
     int line_declared;
+    int scope;              // profundidade do bloco da declaração (0 = global)
     int is_initialized;
-    union {
-        int int_val;
-        float float_val;
-        char char_val;
-        int bool_val;
-    } value;
+    int is_constant;        // value vale até a próxima atribuição
+    Value value;
 } Symbol;
 
-// Erro semântico
+/*
+ * Tabela de símbolos com escopos aninhados
+ *
+ * - symbols: todos os símbolos declarados, em ordem; o índice é o ID do
+ *   símbolo e continua válido depois que o escopo fecha.
+ * - names: um registro por nome distinto, com o símbolo visível no momento
+ *   (-1 se nenhum). slots é o hash aberto (sondagem linear) que leva do
+ *   nome ao seu registro; registros nunca são removidos, então a sondagem
+ *   não precisa de marcas de remoção.
+ * - undo: cada declaração anota o nome e o símbolo que ela escondeu.
+ *   Entrar em um escopo guarda o tamanho do log; sair desfaz as anotações
+ *   até esse ponto, sem percorrer a tabela.
+ * Todos os vetores crescem por duplicação, sem limite de símbolos.
+ */
+typedef struct {
+    unsigned int hash;
+    int first_symbol;       // símbolo que guarda o texto do nome
+    int visible;            // símbolo visível agora, ou -1
+} NameEntry;
+
+typedef struct {
+    int name;               // índice em names
+    int previous;           // símbolo visível antes da declaração
+} UndoEntry;
+
+typedef struct {
+    Symbol* symbols;
+    int symbol_count;
+    int symbol_capacity;
+
+    NameEntry* names;
+    int name_count;
+    int name_capacity;
+
+    int* slots;             // índices em names; -1 = vazio
+    int slot_capacity;      // potência de 2
+
+    UndoEntry* undo;
+    int undo_count;
+    int undo_capacity;
+
+    int* scope_marks;       // tamanho do log na entrada de cada escopo
+    int scope_depth;
+    int scope_capacity;
+} SymbolTable;
+
+/*
+ * Diagnósticos
+ *
+ * Um erro é guardado como um registro compacto: código, linha e até três
+ * argumentos. Argumentos de texto (nomes, operadores) são internados: o
+ * registro guarda só o ID da string, e cada texto distinto é copiado uma
+ * vez. A mensagem só é montada quando o erro é impresso, a partir do
+ * formato do código; o analisador não chama sprintf ao encontrar um erro.
+ * Os vetores crescem por duplicação, então nenhum erro é descartado.
+ */
+typedef enum {
+    ERR_REDECLARED,
+    ERR_UNDECLARED,
+    ERR_UNINITIALIZED,
+    ERR_EXPECTED_RPAREN,
+    ERR_INVALID_FACTOR,
+    ERR_DIVISION_BY_ZERO,
+    ERR_INCOMPATIBLE_OPERANDS,
+    ERR_INVALID_TYPE,
+    ERR_EXPECTED_NAME,
+    ERR_INIT_MISMATCH,
+    ERR_DECL_SEMICOLON,
+    ERR_EXPECTED_ASSIGN,
+    ERR_ASSIGN_MISMATCH,
+    ERR_ASSIGN_SEMICOLON,
+    ERR_EXPECTED_RBRACE,
+    ERR_INVALID_DECLARATION,
+    ERROR_CODE_COUNT
+} ErrorCode;
+
 typedef struct {
-    char message[200];
     int line;
-} SemanticError;
+    uint16_t code;          // ErrorCode
+    int32_t args[3];        // IDs de strings internadas ou DataType, conforme o formato
+} Diagnostic;
+
+typedef struct {
+    Diagnostic* records;
+    int count;
+    int capacity;
+
+    // Strings internadas: texto em 'text', terminado em '\0', a partir de offsets[id]
+    char* text;
+    int text_length;
+    int text_capacity;
+    int* offsets;
+    int string_count;
+    int string_capacity;
+    int* slots;             // hash aberto de IDs; -1 = vazio
+    int slot_capacity;      // potência de 2
+} Diagnostics;
 
 // Estado do analisador
 typedef struct {
@@ -119,11 +222,9 @@ typedef struct {
     int line;
     Token current_token;
     
-    Symbol symbol_table[MAX_VARIABLES];
-    int symbol_count;
+    SymbolTable table;
     
-    SemanticError errors[MAX_ERRORS];
-    int error_count;
+    Diagnostics diagnostics;
 } Analyzer;
 
 // ==================== UTILITÁRIOS ====================
@@ -140,59 +241,292 @@ const char* type_to_string(DataType type) {
     }
 }
 
-void add_error(Analyzer* analyzer, const char* message) {
-    if (analyzer->error_count < MAX_ERRORS) {
-        strcpy(analyzer->errors[analyzer->error_count].message, message);
-        analyzer->errors[analyzer->error_count].line = analyzer->line;
-        analyzer->error_count++;
+static void* grow_array(void* array, int* capacity, size_t element_size) {
+    *capacity = *capacity ? *capacity * 2 : 16;
+    void* grown = realloc(array, *capacity * element_size);
+    if (!grown) {
+        fprintf(stderr, "Erro: memória insuficiente\n");
+        exit(1);
     }
+    return grown;
+}
+
+static unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;   // FNV-1a
+    while (*name) {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ==================== DIAGNÓSTICOS ====================
+
+// Formato de cada código: %s = string internada, %t = tipo
+static const struct {
+    const char* format;
+    int args;
+} error_messages[ERROR_CODE_COUNT] = {
+    [ERR_REDECLARED]            = {"Variável '%s' já foi declarada", 1},
+    [ERR_UNDECLARED]            = {"Variável '%s' não foi declarada", 1},
+    [ERR_UNINITIALIZED]         = {"Variável '%s' usada antes de ser inicializada", 1},
+    [ERR_EXPECTED_RPAREN]       = {"Esperado ')' após expressão", 0},
+    [ERR_INVALID_FACTOR]        = {"Fator inválido em expressão", 0},
+    [ERR_DIVISION_BY_ZERO]      = {"Divisão por zero detectada", 0},
+    [ERR_INCOMPATIBLE_OPERANDS] = {"Tipos incompatíveis para operador '%s': %t e %t", 3},
+    [ERR_INVALID_TYPE]          = {"Tipo de variável inválido", 0},
+    [ERR_EXPECTED_NAME]         = {"Esperado nome da variável", 0},
+    [ERR_INIT_MISMATCH]         = {"Incompatibilidade de tipos na inicialização: %t = %t", 2},
+    [ERR_DECL_SEMICOLON]        = {"Esperado ';' após declaração", 0},
+    [ERR_EXPECTED_ASSIGN]       = {"Esperado '=' na atribuição", 0},
+    [ERR_ASSIGN_MISMATCH]       = {"Incompatibilidade de tipos na atribuição: %t = %t", 2},
+    [ERR_ASSIGN_SEMICOLON]      = {"Esperado ';' após atribuição", 0},
+    [ERR_EXPECTED_RBRACE]       = {"Esperado '}' ao final do bloco", 0},
+    [ERR_INVALID_DECLARATION]   = {"Declaração inválida", 0},
+};
+
+void init_diagnostics(Diagnostics* diagnostics) {
+    memset(diagnostics, 0, sizeof(*diagnostics));
+    diagnostics->slot_capacity = 64;
+    diagnostics->slots = malloc(diagnostics->slot_capacity * sizeof(int));
+    for (int i = 0; i < diagnostics->slot_capacity; i++) diagnostics->slots[i] = -1;
+}
+
+void free_diagnostics(Diagnostics* diagnostics) {
+    free(diagnostics->records);
+    free(diagnostics->text);
+    free(diagnostics->offsets);
+    free(diagnostics->slots);
+}
+
+static const char* interned_string(const Diagnostics* diagnostics, int id) {
+    return diagnostics->text + diagnostics->offsets[id];
+}
+
+// ID da string, copiando o texto só na primeira vez que ela aparece
+int intern_string(Diagnostics* diagnostics, const char* text) {
+    unsigned int mask = diagnostics->slot_capacity - 1;
+    unsigned int slot = hash_name(text) & mask;
+    while (diagnostics->slots[slot] >= 0) {
+        int id = diagnostics->slots[slot];
+        if (strcmp(interned_string(diagnostics, id), text) == 0) return id;
+        slot = (slot + 1) & mask;
+    }
+
+    int length = (int)strlen(text) + 1;
+    while (diagnostics->text_length + length > diagnostics->text_capacity) {
+        diagnostics->text = grow_array(diagnostics->text, &diagnostics->text_capacity, 1);
+    }
+    memcpy(diagnostics->text + diagnostics->text_length, text, length);
+    if (diagnostics->string_count == diagnostics->string_capacity) {
+        diagnostics->offsets = grow_array(diagnostics->offsets, &diagnostics->string_capacity, sizeof(int));
+    }
+    int id = diagnostics->string_count++;
+    diagnostics->offsets[id] = diagnostics->text_length;
+    diagnostics->text_length += length;
+    diagnostics->slots[slot] = id;
+
+    // Carga máxima de 1/2: dobra o hash e reinsere os IDs
+    if (diagnostics->string_count * 2 > diagnostics->slot_capacity) {
+        free(diagnostics->slots);
+        diagnostics->slot_capacity *= 2;
+        diagnostics->slots = malloc(diagnostics->slot_capacity * sizeof(int));
+        for (int i = 0; i < diagnostics->slot_capacity; i++) diagnostics->slots[i] = -1;
+        mask = diagnostics->slot_capacity - 1;
+        for (int i = 0; i < diagnostics->string_count; i++) {
+            slot = hash_name(interned_string(diagnostics, i)) & mask;
+            while (diagnostics->slots[slot] >= 0) slot = (slot + 1) & mask;
+            diagnostics->slots[slot] = i;
+        }
+    }
+    return id;
+}
+
+/*
+ * Registra um erro na linha atual. Os argumentos seguem o formato do
+ * código: IDs de intern_string para %s e valores de DataType para %t.
+ */
+void add_error(Analyzer* analyzer, ErrorCode code, ...) {
+    Diagnostics* diagnostics = &analyzer->diagnostics;
+    if (diagnostics->count == diagnostics->capacity) {
+        diagnostics->records = grow_array(diagnostics->records, &diagnostics->capacity, sizeof(Diagnostic));
+    }
+    Diagnostic* record = &diagnostics->records[diagnostics->count++];
+    record->line = analyzer->line;
+    record->code = (uint16_t)code;
+
+    va_list args;
+    va_start(args, code);
+    for (int i = 0; i < error_messages[code].args; i++) record->args[i] = va_arg(args, int);
+    va_end(args);
+}
+
+// Monta a mensagem do registro em 'out' (truncada em 'size' bytes)
+void format_diagnostic(const Diagnostics* diagnostics, const Diagnostic* record, char* out, size_t size) {
+    const char* format = error_messages[record->code].format;
+    size_t length = 0;
+    int arg = 0;
+    for (const char* p = format; *p && length + 1 < size; p++) {
+        const char* piece = NULL;
+        if (p[0] == '%' && p[1] == 's') piece = interned_string(diagnostics, record->args[arg++]);
+        else if (p[0] == '%' && p[1] == 't') piece = type_to_string((DataType)record->args[arg++]);
+
+        if (!piece) {
+            out[length++] = *p;
+            continue;
+        }
+        while (*piece && length + 1 < size) out[length++] = *piece++;
+        p++;
+    }
+    out[length] = '\0';
 }
 
 // ==================== TABELA DE SÍMBOLOS ====================
 
-Symbol* find_symbol(Analyzer* analyzer, const char* name) {
-    for (int i = 0; i < analyzer->symbol_count; i++) {
-        if (strcmp(analyzer->symbol_table[i].name, name) == 0) {
-            return &analyzer->symbol_table[i];
+void init_symbol_table(SymbolTable* table) {
+    memset(table, 0, sizeof(*table));
+    table->slot_capacity = 64;
+    table->slots = malloc(table->slot_capacity * sizeof(int));
+    for (int i = 0; i < table->slot_capacity; i++) table->slots[i] = -1;
+}
+
+void free_symbol_table(SymbolTable* table) {
+    free(table->symbols);
+    free(table->names);
+    free(table->slots);
+    free(table->undo);
+    free(table->scope_marks);
+}
+
+// Registro do nome na tabela hash; com create, cria um se não existir
+static int lookup_name(SymbolTable* table, const char* name, int create) {
+    unsigned int hash = hash_name(name);
+    unsigned int mask = table->slot_capacity - 1;
+    unsigned int i = hash & mask;
+
+    while (table->slots[i] != -1) {
+        NameEntry* entry = &table->names[table->slots[i]];
+        if (entry->hash == hash && strcmp(table->symbols[entry->first_symbol].name, name) == 0) {
+            return table->slots[i];
+        }
+        i = (i + 1) & mask;
+    }
+    if (!create) return -1;
+
+    // Novo nome; o texto fica no símbolo que está sendo declarado
+    if (table->name_count == table->name_capacity) {
+        table->names = grow_array(table->names, &table->name_capacity, sizeof(NameEntry));
+    }
+    int index = table->name_count++;
+    table->names[index].hash = hash;
+    table->names[index].first_symbol = table->symbol_count;
+    table->names[index].visible = -1;
+    table->slots[i] = index;
+
+    // Carga máxima de 1/2: dobra e redistribui os registros
+    if (table->name_count * 2 > table->slot_capacity) {
+        free(table->slots);
+        table->slot_capacity *= 2;
+        table->slots = malloc(table->slot_capacity * sizeof(int));
+        for (int k = 0; k < table->slot_capacity; k++) table->slots[k] = -1;
+        mask = table->slot_capacity - 1;
+        for (int n = 0; n < table->name_count; n++) {
+            unsigned int k = table->names[n].hash & mask;
+            while (table->slots[k] != -1) k = (k + 1) & mask;
+            table->slots[k] = n;
         }
     }
-    return NULL;
+    return index;
 }
 
-void add_symbol(Analyzer* analyzer, const char* name, DataType type) {
-    if (analyzer->symbol_count >= MAX_VARIABLES) {
-        add_error(analyzer, "Muitas variáveis declaradas");
-        return;
+void enter_scope(Analyzer* analyzer) {
+    SymbolTable* table = &analyzer->table;
+    if (table->scope_depth == table->scope_capacity) {
+        table->scope_marks = grow_array(table->scope_marks, &table->scope_capacity, sizeof(int));
     }
-    
-    // Verifica se já existe
-    if (find_symbol(analyzer, name)) {
-        char error[200];
-        sprintf(error, "Variável '%s' já foi declarada", name);
-        add_error(analyzer, error);
-        return;
+    table->scope_marks[table->scope_depth++] = table->undo_count;
+}
+
+void exit_scope(Analyzer* analyzer) {
+    SymbolTable* table = &analyzer->table;
+    if (table->scope_depth == 0) return;
+    int mark = table->scope_marks[--table->scope_depth];
+    while (table->undo_count > mark) {
+        UndoEntry* undo = &table->undo[--table->undo_count];
+        table->names[undo->name].visible = undo->previous;
     }
-    
-    Symbol* symbol = &analyzer->symbol_table[analyzer->symbol_count];
+}
+
+Symbol* find_symbol(Analyzer* analyzer, const char* name) {
+    SymbolTable* table = &analyzer->table;
+    int index = lookup_name(table, name, 0);
+    if (index < 0 || table->names[index].visible < 0) return NULL;
+    return &table->symbols[table->names[index].visible];
+}
+
+// Declara o nome no escopo atual; devolve o símbolo, ou NULL em redeclaração
+Symbol* add_symbol(Analyzer* analyzer, const char* name, DataType type) {
+    SymbolTable* table = &analyzer->table;
+    if (table->symbol_count == table->symbol_capacity) {
+        table->symbols = grow_array(table->symbols, &table->symbol_capacity, sizeof(Symbol));
+    }
+    // O texto precisa estar no símbolo antes de lookup_name criar o registro
+    Symbol* symbol = &table->symbols[table->symbol_count];
     strcpy(symbol->name, name);
+
+    int index = lookup_name(table, name, 1);
+    int previous = table->names[index].visible;
+    if (previous >= 0 && table->symbols[previous].scope == table->scope_depth) {
+        add_error(analyzer, ERR_REDECLARED, intern_string(&analyzer->diagnostics, name));
+        return NULL;
+    }
+
     symbol->type = type;
     symbol->line_declared = analyzer->line;
+    symbol->scope = table->scope_depth;
     symbol->is_initialized = 0;
-    analyzer->symbol_count++;
+    symbol->is_constant = 0;
+
+    if (table->undo_count == table->undo_capacity) {
+        table->undo = grow_array(table->undo, &table->undo_capacity, sizeof(UndoEntry));
+    }
+    table->undo[table->undo_count].name = index;
+    table->undo[table->undo_count].previous = previous;
+    table->undo_count++;
+    table->names[index].visible = table->symbol_count++;
+    return symbol;
+}
+
+void format_value(DataType type, Value value, char* out, size_t size) {
+    switch (type) {
+        case TYPE_INT:   snprintf(out, size, "%d", value.int_val); break;
+        case TYPE_FLOAT: snprintf(out, size, "%g", value.float_val); break;
+        case TYPE_CHAR:  snprintf(out, size, "'%c'", value.char_val); break;
+        case TYPE_BOOL:  snprintf(out, size, "%s", value.bool_val ? "true" : "false"); break;
+        default:         snprintf(out, size, "?"); break;
+    }
 }
 
 void print_symbol_table(Analyzer* analyzer) {
     printf("\n=== TABELA DE SÍMBOLOS ===\n");
-    printf("%-15s %-10s %-10s %-12s\n", "Nome", "Tipo", "Linha", "Inicializada");
-    printf("%-15s %-10s %-10s %-12s\n", "----", "----", "-----", "------------");
+    printf("%-15s %-10s %-10s %-8s %-13s %s\n", "Nome", "Tipo", "Linha", "Escopo", "Inicializada", "Valor");
+    printf("%-15s %-10s %-10s %-8s %-13s %s\n", "----", "----", "-----", "------", "------------", "-----");
     
-    for (int i = 0; i < analyzer->symbol_count; i++) {
-        Symbol* s = &analyzer->symbol_table[i];
-        printf("%-15s %-10s %-10d %-12s\n", 
+    for (int i = 0; i < analyzer->table.symbol_count; i++) {
+        Symbol* s = &analyzer->table.symbols[i];
+        char value[32] = "-";
+        if (s->is_constant) {
+            format_value(s->type, s->value, value, sizeof(value));
+        }
+        // "Não" tem um byte a mais que o número de colunas que ocupa
+        printf("%-15s %-10s %-10d %-8d %-*s %s\n", 
                s->name, 
                type_to_string(s->type), 
                s->line_declared,
-               s->is_initialized ? "Sim" : "Não");
+               s->scope,
+               s->is_initialized ? 13 : 14,
+               s->is_initialized ? "Sim" : "Não",
+               value);
     }
 }
 
@@ -304,8 +638,7 @@ Token get_next_token(Analyzer* analyzer) {
     }
     
     // Operadores
-    char next = (analyzer->position + 1 < strlen(analyzer->input)) ? 
-                analyzer->input[analyzer->position + 1] : '\0';
+    char next = analyzer->input[analyzer->position + 1];   // ch != '\0', então existe
     
     switch (ch) {
         case '=':
@@ -382,6 +715,18 @@ Token get_next_token(Analyzer* analyzer) {
             token.lexeme[1] = '\0';
             analyzer->position++;
             break;
+        case '{':
+            token.type = TOKEN_LBRACE;
+            token.lexeme[0] = ch;
+            token.lexeme[1] = '\0';
+            analyzer->position++;
+            break;
+        case '}':
+            token.type = TOKEN_RBRACE;
+            token.lexeme[0] = ch;
+            token.lexeme[1] = '\0';
+            analyzer->position++;
+            break;
         case ';':
             token.type = TOKEN_SEMICOLON;
             token.lexeme[0] = ch;
@@ -405,160 +750,310 @@ void advance_token(Analyzer* analyzer) {
 
 // ==================== VERIFICAÇÃO SEMÂNTICA ====================
 
-DataType get_compatible_type(DataType type1, DataType type2, const char* op) {
-    // Regras de compatibilidade de tipos
-    
-    // Operações lógicas retornam bool
-    if (strcmp(op, "&&") == 0 || strcmp(op, "||") == 0) {
-        if (type1 == TYPE_BOOL && type2 == TYPE_BOOL) {
-            return TYPE_BOOL;
+/*
+ * Tabela de compatibilidade de tipos
+ *
+ * As regras ficam em uma especificação declarativa (type_spec): cada linha
+ * dá um conjunto de operadores, os tipos aceitos de cada lado, o tipo para
+ * o qual os operandos são convertidos e o tipo do resultado. Na partida,
+ * build_type_table expande a especificação em uma tabela densa indexada
+ * por [operador][tipo esquerdo][tipo direito]; a verificação de uma
+ * operação é uma única leitura, sem comparar o texto do operador. A
+ * primeira regra que cobre uma combinação vale; combinações sem regra são
+ * TYPE_ERROR.
+ */
+
+// Operadores binários, na mesma ordem dos tokens TOKEN_PLUS..TOKEN_OR
+typedef enum {
+    OP_ADD,
+    OP_SUB,
+    OP_MUL,
+    OP_DIV,
+    OP_EQ,
+    OP_NE,
+    OP_AND,
+    OP_OR,
+    OP_COUNT
+} BinaryOp;
+
+#define TYPE_COUNT (TYPE_ERROR + 1)
+#define OPERATOR_ID(token) ((BinaryOp)((token) - TOKEN_PLUS))
+
+// Conjuntos de operadores e de tipos (bit = valor do enum)
+#define OPS(op) (1u << (op))
+#define TYPES(type) (1u << (type))
+#define ARITHMETIC (OPS(OP_ADD) | OPS(OP_SUB) | OPS(OP_MUL) | OPS(OP_DIV))
+#define EQUALITY (OPS(OP_EQ) | OPS(OP_NE))
+#define LOGICAL (OPS(OP_AND) | OPS(OP_OR))
+#define NUMERIC (TYPES(TYPE_INT) | TYPES(TYPE_FLOAT))
+
+typedef struct {
+    unsigned int operators;
+    unsigned int left;
+    unsigned int right;
+    DataType operand;       // tipo dos operandos depois da conversão implícita
+    DataType result;
+} TypeRuleSpec;
+
+static const TypeRuleSpec type_spec[] = {
+    // operadores  esquerdo            direito             operandos   resultado
+    {ARITHMETIC,   TYPES(TYPE_INT),    TYPES(TYPE_INT),    TYPE_INT,   TYPE_INT},
+    {ARITHMETIC,   NUMERIC,            NUMERIC,            TYPE_FLOAT, TYPE_FLOAT}, // promoção
+    {EQUALITY,     TYPES(TYPE_INT),    TYPES(TYPE_INT),    TYPE_INT,   TYPE_BOOL},
+    {EQUALITY,     TYPES(TYPE_FLOAT),  TYPES(TYPE_FLOAT),  TYPE_FLOAT, TYPE_BOOL},
+    {EQUALITY,     TYPES(TYPE_CHAR),   TYPES(TYPE_CHAR),   TYPE_CHAR,  TYPE_BOOL},
+    {EQUALITY,     TYPES(TYPE_BOOL),   TYPES(TYPE_BOOL),   TYPE_BOOL,  TYPE_BOOL},
+    {LOGICAL,      TYPES(TYPE_BOOL),   TYPES(TYPE_BOOL),   TYPE_BOOL,  TYPE_BOOL},
+};
+
+typedef struct {
+    unsigned char result;
+    unsigned char operand;
+} TypeRule;
+
+static TypeRule type_table[OP_COUNT][TYPE_COUNT][TYPE_COUNT];
+
+void build_type_table(void) {
+    for (int op = 0; op < OP_COUNT; op++) {
+        for (int l = 0; l < TYPE_COUNT; l++) {
+            for (int r = 0; r < TYPE_COUNT; r++) {
+                TypeRule* cell = &type_table[op][l][r];
+                cell->result = TYPE_ERROR;
+                cell->operand = TYPE_ERROR;
+                for (size_t i = 0; i < sizeof(type_spec) / sizeof(type_spec[0]); i++) {
+                    const TypeRuleSpec* rule = &type_spec[i];
+                    if ((rule->operators & OPS(op)) && (rule->left & TYPES(l)) &&
+                        (rule->right & TYPES(r))) {
+                        cell->result = rule->result;
+                        cell->operand = rule->operand;
+                        break;
+                    }
+                }
+            }
         }
-        return TYPE_ERROR;
     }
-    
-    // Comparações retornam bool
-    if (strcmp(op, "==") == 0 || strcmp(op, "!=") == 0) {
-        if (type1 == type2) {
-            return TYPE_BOOL;
+}
+
+/*
+ * Aplica a tabela à operação e reporta combinações inválidas. Um operando
+ * que já tem erro não gera outra mensagem.
+ */
+DataType check_binary_types(Analyzer* analyzer, BinaryOp op, const char* lexeme,
+                            DataType left, DataType right) {
+    DataType result = type_table[op][left][right].result;
+    if (result == TYPE_ERROR && left != TYPE_ERROR && right != TYPE_ERROR) {
+        add_error(analyzer, ERR_INCOMPATIBLE_OPERANDS,
+                  intern_string(&analyzer->diagnostics, lexeme), left, right);
+    }
+    return result;
+}
+
+/*
+ * Avaliação de constantes
+ *
+ * Cada expressão verificada devolve, além do tipo, o seu valor quando
+ * todos os operandos são conhecidos na compilação: literais e variáveis
+ * cujo valor atual é constante. A linguagem não tem desvios, então o valor
+ * dado por uma declaração ou atribuição vale até a próxima atribuição da
+ * mesma variável, em qualquer bloco interno.
+ *
+ * Os operandos são convertidos para a coluna "operandos" da tabela de
+ * tipos antes da conta, como o código gerado faria. A aritmética inteira
+ * dá a volta no estouro (complemento de dois), em vez de cair em
+ * comportamento indefinido no próprio compilador. Um divisor constante
+ * igual a zero é reportado, e a divisão não é avaliada.
+ */
+typedef struct {
+    DataType type;
+    int is_constant;
+    Value value;
+} ExprValue;
+
+static ExprValue non_constant(DataType type) {
+    ExprValue result;
+    result.type = type;
+    result.is_constant = 0;
+    result.value.int_val = 0;
+    return result;
+}
+
+static ExprValue constant(DataType type, Value value) {
+    ExprValue result;
+    result.type = type;
+    result.is_constant = 1;
+    result.value = value;
+    return result;
+}
+
+// Conversão implícita de um valor (só int -> float existe na tabela)
+static Value convert_value(Value value, DataType from, DataType to) {
+    if (from == TYPE_INT && to == TYPE_FLOAT) {
+        Value converted;
+        converted.float_val = (float)value.int_val;
+        return converted;
+    }
+    return value;
+}
+
+static int is_zero(DataType type, Value value) {
+    return type == TYPE_INT ? value.int_val == 0 :
+           type == TYPE_FLOAT ? value.float_val == 0.0f : 0;
+}
+
+// a op b, com os dois operandos já no tipo 'operand'
+static Value fold_binary(BinaryOp op, DataType operand, Value a, Value b) {
+    Value r;
+    r.int_val = 0;
+    if (op == OP_EQ || op == OP_NE) {
+        int equal = operand == TYPE_INT   ? a.int_val == b.int_val :
+                    operand == TYPE_FLOAT ? a.float_val == b.float_val :
+                    operand == TYPE_CHAR  ? a.char_val == b.char_val :
+                                            a.bool_val == b.bool_val;
+        r.bool_val = op == OP_EQ ? equal : !equal;
+    } else if (op == OP_AND) {
+        r.bool_val = a.bool_val && b.bool_val;
+    } else if (op == OP_OR) {
+        r.bool_val = a.bool_val || b.bool_val;
+    } else if (operand == TYPE_FLOAT) {
+        r.float_val = op == OP_ADD ? a.float_val + b.float_val :
+                      op == OP_SUB ? a.float_val - b.float_val :
+                      op == OP_MUL ? a.float_val * b.float_val :
+                                     a.float_val / b.float_val;
+    } else {
+        unsigned int x = (unsigned int)a.int_val, y = (unsigned int)b.int_val;
+        switch (op) {
+            case OP_ADD: r.int_val = (int)(x + y); break;
+            case OP_SUB: r.int_val = (int)(x - y); break;
+            case OP_MUL: r.int_val = (int)(x * y); break;
+            default:     // INT_MIN / -1 estoura: dá a volta como as outras
+                r.int_val = b.int_val == -1 ? (int)(0u - x) : a.int_val / b.int_val;
+                break;
         }
-        return TYPE_ERROR;
     }
-    
-    // Operações aritméticas
-    if (type1 == TYPE_INT && type2 == TYPE_INT) {
-        return TYPE_INT;
+    return r;
+}
+
+// Verifica 'left op right' e, se os dois lados são constantes, calcula o resultado
+ExprValue check_binary(Analyzer* analyzer, BinaryOp op, const char* lexeme,
+                       ExprValue left, ExprValue right) {
+    DataType result = check_binary_types(analyzer, op, lexeme, left.type, right.type);
+    if (result == TYPE_ERROR) return non_constant(TYPE_ERROR);
+
+    DataType operand = type_table[op][left.type][right.type].operand;
+    Value b = convert_value(right.value, right.type, operand);
+    if (op == OP_DIV && right.is_constant && is_zero(operand, b)) {
+        add_error(analyzer, ERR_DIVISION_BY_ZERO);
+        return non_constant(result);
     }
-    
-    if ((type1 == TYPE_INT || type1 == TYPE_FLOAT) && 
-        (type2 == TYPE_INT || type2 == TYPE_FLOAT)) {
-        return TYPE_FLOAT; // promoção para float
+    if (!left.is_constant || !right.is_constant) {
+        return non_constant(result);
     }
-    
-    return TYPE_ERROR;
+    Value a = convert_value(left.value, left.type, operand);
+    return constant(result, fold_binary(op, operand, a, b));
 }
 
-DataType check_expression(Analyzer* analyzer);
+ExprValue check_expression(Analyzer* analyzer);
 
-DataType check_factor(Analyzer* analyzer) {
+ExprValue check_factor(Analyzer* analyzer) {
     Token token = analyzer->current_token;
     
     if (token.type == TOKEN_NUMBER) {
         advance_token(analyzer);
-        return TYPE_INT;
+        return constant(TYPE_INT, token.value);
     }
     
     if (token.type == TOKEN_FLOAT_NUM) {
         advance_token(analyzer);
-        return TYPE_FLOAT;
+        return constant(TYPE_FLOAT, token.value);
     }
     
     if (token.type == TOKEN_CHAR_LIT) {
         advance_token(analyzer);
-        return TYPE_CHAR;
+        return constant(TYPE_CHAR, token.value);
     }
     
     if (token.type == TOKEN_BOOL_LIT) {
         advance_token(analyzer);
-        return TYPE_BOOL;
+        return constant(TYPE_BOOL, token.value);
     }
     
     if (token.type == TOKEN_IDENTIFIER) {
         Symbol* symbol = find_symbol(analyzer, token.lexeme);
         if (!symbol) {
-            char error[200];
-            sprintf(error, "Variável '%s' não foi declarada", token.lexeme);
-            add_error(analyzer, error);
+            add_error(analyzer, ERR_UNDECLARED, intern_string(&analyzer->diagnostics, token.lexeme));
             advance_token(analyzer);
-            return TYPE_ERROR;
+            return non_constant(TYPE_ERROR);
         }
         
         if (!symbol->is_initialized) {
-            char error[200];
-            sprintf(error, "Variável '%s' usada antes de ser inicializada", token.lexeme);
-            add_error(analyzer, error);
+            add_error(analyzer, ERR_UNINITIALIZED, intern_string(&analyzer->diagnostics, token.lexeme));
         }
         
         advance_token(analyzer);
-        return symbol->type;
+        return symbol->is_constant ? constant(symbol->type, symbol->value)
+                                   : non_constant(symbol->type);
     }
     
     if (token.type == TOKEN_LPAREN) {
         advance_token(analyzer);
-        DataType expr_type = check_expression(analyzer);
+        ExprValue expr = check_expression(analyzer);
         
         if (analyzer->current_token.type != TOKEN_RPAREN) {
-            add_error(analyzer, "Esperado ')' após expressão");
+            add_error(analyzer, ERR_EXPECTED_RPAREN);
         } else {
             advance_token(analyzer);
         }
         
-        return expr_type;
+        return expr;
     }
     
-    add_error(analyzer, "Fator inválido em expressão");
-    return TYPE_ERROR;
+    add_error(analyzer, ERR_INVALID_FACTOR);
+    return non_constant(TYPE_ERROR);
 }
 
-DataType check_term(Analyzer* analyzer) {
-    DataType left_type = check_factor(analyzer);
+ExprValue check_term(Analyzer* analyzer) {
+    ExprValue left = check_factor(analyzer);
     
     while (analyzer->current_token.type == TOKEN_MULTIPLY ||
            analyzer->current_token.type == TOKEN_DIVIDE ||
            analyzer->current_token.type == TOKEN_EQ ||
            analyzer->current_token.type == TOKEN_NE) {
         
-        char op[10];
-        strcpy(op, analyzer->current_token.lexeme);
+        Token op = analyzer->current_token;
         advance_token(analyzer);
         
-        DataType right_type = check_factor(analyzer);
+        ExprValue right = check_factor(analyzer);
         
-        // Verificação especial para divisão por zero
-        if (strcmp(op, "/") == 0 && analyzer->current_token.type == TOKEN_NUMBER &&
-            analyzer->current_token.value.int_val == 0) {
-            add_error(analyzer, "Divisão por zero detectada");
-        }
-        
-        DataType result_type = get_compatible_type(left_type, right_type, op);
-        if (result_type == TYPE_ERROR) {
-            char error[200];
-            sprintf(error, "Tipos incompatíveis para operador '%s': %s e %s",
-                   op, type_to_string(left_type), type_to_string(right_type));
-            add_error(analyzer, error);
-        }
-        
-        left_type = result_type;
+        left = check_binary(analyzer, OPERATOR_ID(op.type), op.lexeme, left, right);
     }
     
-    return left_type;
+    return left;
 }
 
-DataType check_expression(Analyzer* analyzer) {
-    DataType left_type = check_term(analyzer);
+ExprValue check_expression(Analyzer* analyzer) {
+    ExprValue left = check_term(analyzer);
     
     while (analyzer->current_token.type == TOKEN_PLUS ||
            analyzer->current_token.type == TOKEN_MINUS ||
            analyzer->current_token.type == TOKEN_AND ||
            analyzer->current_token.type == TOKEN_OR) {
         
-        char op[10];
-        strcpy(op, analyzer->current_token.lexeme);
+        Token op = analyzer->current_token;
         advance_token(analyzer);
         
-        DataType right_type = check_term(analyzer);
+        ExprValue right = check_term(analyzer);
         
-        DataType result_type = get_compatible_type(left_type, right_type, op);
-        if (result_type == TYPE_ERROR) {
-            char error[200];
-            sprintf(error, "Tipos incompatíveis para operador '%s': %s e %s",
-                   op, type_to_string(left_type), type_to_string(right_type));
-            add_error(analyzer, error);
-        }
-        
-        left_type = result_type;
+        left = check_binary(analyzer, OPERATOR_ID(op.type), op.lexeme, left, right);
     }
     
-    return left_type;
+    return left;
+}
+
+// Grava o valor atribuído: constante, ou desconhecido a partir daqui
+static void assign_value(Symbol* symbol, ExprValue expr) {
+    symbol->is_initialized = 1;
+    symbol->is_constant = expr.is_constant;
+    symbol->value = expr.value;
 }
 
 void check_variable_declaration(Analyzer* analyzer) {
@@ -574,7 +1069,7 @@ void check_variable_declaration(Analyzer* analyzer) {
     } else if (analyzer->current_token.type == TOKEN_BOOL_TYPE) {
         var_type = TYPE_BOOL;
     } else {
-        add_error(analyzer, "Tipo de variável inválido");
+        add_error(analyzer, ERR_INVALID_TYPE);
         return;
     }
     
@@ -582,7 +1077,7 @@ void check_variable_declaration(Analyzer* analyzer) {
     
     // Lê o nome
     if (analyzer->current_token.type != TOKEN_IDENTIFIER) {
-        add_error(analyzer, "Esperado nome da variável");
+        add_error(analyzer, ERR_EXPECTED_NAME);
         return;
     }
     
@@ -591,32 +1086,28 @@ void check_variable_declaration(Analyzer* analyzer) {
     advance_token(analyzer);
     
     // Adiciona à tabela de símbolos
-    add_symbol(analyzer, var_name, var_type);
+    Symbol* declared = add_symbol(analyzer, var_name, var_type);
     
     // Verifica inicialização
     if (analyzer->current_token.type == TOKEN_ASSIGN) {
         advance_token(analyzer);
         
-        DataType expr_type = check_expression(analyzer);
+        ExprValue expr = check_expression(analyzer);
         
         // Verifica compatibilidade de tipos na atribuição
-        if (var_type != expr_type && expr_type != TYPE_ERROR) {
-            char error[200];
-            sprintf(error, "Incompatibilidade de tipos na inicialização: %s = %s",
-                   type_to_string(var_type), type_to_string(expr_type));
-            add_error(analyzer, error);
+        if (var_type != expr.type && expr.type != TYPE_ERROR) {
+            add_error(analyzer, ERR_INIT_MISMATCH, var_type, expr.type);
         } else {
-            // Marca como inicializada
-            Symbol* symbol = find_symbol(analyzer, var_name);
-            if (symbol) {
-                symbol->is_initialized = 1;
+            // Marca como inicializada (declared é NULL em redeclaração)
+            if (declared) {
+                assign_value(declared, expr);
             }
         }
     }
     
     // Verifica ponto e vírgula
     if (analyzer->current_token.type != TOKEN_SEMICOLON) {
-        add_error(analyzer, "Esperado ';' após declaração");
+        add_error(analyzer, ERR_DECL_SEMICOLON);
     } else {
         advance_token(analyzer);
     }
@@ -628,42 +1119,69 @@ void check_assignment(Analyzer* analyzer) {
     
     Symbol* symbol = find_symbol(analyzer, var_name);
     if (!symbol) {
-        char error[200];
-        sprintf(error, "Variável '%s' não foi declarada", var_name);
-        add_error(analyzer, error);
+        add_error(analyzer, ERR_UNDECLARED, intern_string(&analyzer->diagnostics, var_name));
+        
+        // Recuperação: descarta o restante da atribuição
+        while (analyzer->current_token.type != TOKEN_SEMICOLON &&
+               analyzer->current_token.type != TOKEN_EOF) {
+            advance_token(analyzer);
+        }
+        if (analyzer->current_token.type == TOKEN_SEMICOLON) {
+            advance_token(analyzer);
+        }
         return;
     }
     
     advance_token(analyzer); // nome da variável
     
     if (analyzer->current_token.type != TOKEN_ASSIGN) {
-        add_error(analyzer, "Esperado '=' na atribuição");
+        add_error(analyzer, ERR_EXPECTED_ASSIGN);
         return;
     }
     
     advance_token(analyzer); // =
     
-    DataType expr_type = check_expression(analyzer);
+    ExprValue expr = check_expression(analyzer);
     
     // Verifica compatibilidade de tipos
-    if (symbol->type != expr_type && expr_type != TYPE_ERROR) {
-        char error[200];
-        sprintf(error, "Incompatibilidade de tipos na atribuição: %s = %s",
-               type_to_string(symbol->type), type_to_string(expr_type));
-        add_error(analyzer, error);
+    if (symbol->type != expr.type && expr.type != TYPE_ERROR) {
+        add_error(analyzer, ERR_ASSIGN_MISMATCH, symbol->type, expr.type);
+        symbol->is_constant = 0;
     } else {
-        symbol->is_initialized = 1;
+        assign_value(symbol, expr);
     }
     
     if (analyzer->current_token.type != TOKEN_SEMICOLON) {
-        add_error(analyzer, "Esperado ';' após atribuição");
+        add_error(analyzer, ERR_ASSIGN_SEMICOLON);
+    } else {
+        advance_token(analyzer);
+    }
+}
+
+void check_declaration(Analyzer* analyzer);
+
+// Bloco: as declarações internas somem ao fechar a chave
+void check_block(Analyzer* analyzer) {
+    advance_token(analyzer); // {
+    enter_scope(analyzer);
+    
+    while (analyzer->current_token.type != TOKEN_RBRACE &&
+           analyzer->current_token.type != TOKEN_EOF) {
+        check_declaration(analyzer);
+    }
+    
+    if (analyzer->current_token.type != TOKEN_RBRACE) {
+        add_error(analyzer, ERR_EXPECTED_RBRACE);
     } else {
         advance_token(analyzer);
     }
+    exit_scope(analyzer);
 }
 
 void check_declaration(Analyzer* analyzer) {
-    if (analyzer->current_token.type == TOKEN_INT_TYPE ||
+    if (analyzer->current_token.type == TOKEN_LBRACE) {
+        check_block(analyzer);
+    } else if (analyzer->current_token.type == TOKEN_INT_TYPE ||
         analyzer->current_token.type == TOKEN_FLOAT_TYPE ||
         analyzer->current_token.type == TOKEN_CHAR_TYPE ||
         analyzer->current_token.type == TOKEN_BOOL_TYPE) {
@@ -671,7 +1189,7 @@ void check_declaration(Analyzer* analyzer) {
     } else if (analyzer->current_token.type == TOKEN_IDENTIFIER) {
         check_assignment(analyzer);
     } else {
-        add_error(analyzer, "Declaração inválida");
+        add_error(analyzer, ERR_INVALID_DECLARATION);
         advance_token(analyzer); // pula token inválido
     }
 }
@@ -684,38 +1202,220 @@ void check_program(Analyzer* analyzer) {
     }
 }
 
+void init_analyzer(Analyzer* analyzer, const char* code) {
+    analyzer->input = code;
+    analyzer->position = 0;
+    analyzer->line = 1;
+    init_symbol_table(&analyzer->table);
+    init_diagnostics(&analyzer->diagnostics);
+}
+
 // ==================== DEMO ====================
 
+void print_diagnostics(const Diagnostics* diagnostics) {
+    char message[512];
+    for (int i = 0; i < diagnostics->count; i++) {
+        format_diagnostic(diagnostics, &diagnostics->records[i], message, sizeof(message));
+        printf("  Linha %d: %s\n", diagnostics->records[i].line, message);
+    }
+}
+
 void analyze_code(const char* code, const char* description) {
     printf("\n=== %s ===\n", description);
     printf("Código:\n%s\n", code);
     
     Analyzer analyzer;
-    analyzer.input = code;
-    analyzer.position = 0;
-    analyzer.line = 1;
-    analyzer.symbol_count = 0;
-    analyzer.error_count = 0;
+    init_analyzer(&analyzer, code);
     
     check_program(&analyzer);
     
     print_symbol_table(&analyzer);
     
     printf("\n=== RESULTADO DA ANÁLISE SEMÂNTICA ===\n");
-    if (analyzer.error_count == 0) {
+    if (analyzer.diagnostics.count == 0) {
         printf("✓ Análise semântica bem-sucedida! Nenhum erro encontrado.\n");
     } else {
-        printf("✗ %d erro(s) semântico(s) encontrado(s):\n", analyzer.error_count);
-        for (int i = 0; i < analyzer.error_count; i++) {
-            printf("  Linha %d: %s\n", 
-                   analyzer.errors[i].line, 
-                   analyzer.errors[i].message);
-        }
+        printf("✗ %d erro(s) semântico(s) encontrado(s):\n", analyzer.diagnostics.count);
+        print_diagnostics(&analyzer.diagnostics);
     }
     printf("\n==================================================\n");
+    free_symbol_table(&analyzer.table);
+    free_diagnostics(&analyzer.diagnostics);
+}
+
+// ==================== BENCHMARK ====================
+
+static double elapsed_seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/*
+ * A tabela antiga: vetor com busca linear por strcmp, e a declaração
+ * procurando o nome de novo para detectar redeclaração. Mantida aqui só
+ * como referência de tempo.
+ */
+static double time_linear_table(char (*names)[16], int n) {
+    Symbol* table = malloc(n * sizeof(Symbol));
+    int count = 0, found = 0;
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) {
+        if (i > 0) {    // uso do nome anterior na inicialização
+            for (int k = 0; k < count; k++) {
+                if (strcmp(table[k].name, names[i - 1]) == 0) { found++; break; }
+            }
+        }
+        int exists = 0;
+        for (int k = 0; k < count && !exists; k++) exists = strcmp(table[k].name, names[i]) == 0;
+        if (!exists) strcpy(table[count++].name, names[i]);
+    }
+    double seconds = elapsed_seconds(start);
+    if (found != n - 1) printf("(busca linear: %d de %d usos encontrados)\n", found, n - 1);
+    free(table);
+    return seconds;
+}
+
+static double time_hash_table(char (*names)[16], int n) {
+    Analyzer analyzer;
+    init_analyzer(&analyzer, "");
+    int found = 0;
+    clock_t start = clock();
+    for (int i = 0; i < n; i++) {
+        if (i > 0) found += find_symbol(&analyzer, names[i - 1]) != NULL;
+        add_symbol(&analyzer, names[i], TYPE_INT);
+    }
+    double seconds = elapsed_seconds(start);
+    if (found != n - 1) printf("(hash: %d de %d usos encontrados)\n", found, n - 1);
+    free_symbol_table(&analyzer.table);
+    free_diagnostics(&analyzer.diagnostics);
+    return seconds;
+}
+
+/*
+ * Programa com n declarações: variáveis globais g<i> e, a cada 2000
+ * declarações, um bloco com 1000 locais a0..a999. Os nomes dos blocos se
+ * repetem, então cada bloco reabre os mesmos nomes em um escopo novo.
+ */
+static char* generate_declarations(int n) {
+    size_t capacity = (size_t)n * 40 + 64, length = 0;
+    char* source = malloc(capacity);
+    int in_block = 0;
+    for (int i = 0; i < n; i++) {
+        int local = i % 2000 >= 1000;
+        if (local && !in_block) {
+            length += sprintf(source + length, "{\n");
+            in_block = 1;
+        } else if (!local && in_block) {
+            length += sprintf(source + length, "}\n");
+            in_block = 0;
+        }
+        if (local) {
+            int k = i % 1000;
+            if (k == 0) length += sprintf(source + length, "int a0 = g%d;\n", i - 1);
+            else length += sprintf(source + length, "int a%d = a%d + 1;\n", k, k - 1);
+        } else if (i == 0) {
+            length += sprintf(source + length, "int g0 = 0;\n");
+        } else {
+            length += sprintf(source + length, "int g%d = g%d + 1;\n", i, i % 2000 == 0 ? i - 1001 : i - 1);
+        }
+    }
+    if (in_block) length += sprintf(source + length, "}\n");
+    return source;
+}
+
+/*
+ * Programa com um erro por linha: metade usa um nome não declarado (um
+ * nome novo por linha, para exercitar as strings internadas) e metade
+ * inicializa um bool com float.
+ */
+static char* generate_errors(int n) {
+    size_t capacity = (size_t)n * 40 + 64, length = 0;
+    char* source = malloc(capacity);
+    for (int i = 0; i < n; i++) {
+        if (i % 2 == 0) length += sprintf(source + length, "int e%d = w%d;\n", i, i);
+        else length += sprintf(source + length, "bool b%d = 1 + 2.5;\n", i);
+    }
+    source[length] = '\0';
+    return source;
 }
 
-int main() {
+// Análise (só registra os erros) e formatação das mensagens, medidas à parte
+static void run_error_benchmark(int n) {
+    char* source = generate_errors(n);
+    Analyzer analyzer;
+    init_analyzer(&analyzer, source);
+    clock_t start = clock();
+    check_program(&analyzer);
+    double analysis = elapsed_seconds(start);
+
+    const Diagnostics* diagnostics = &analyzer.diagnostics;
+    char message[512];
+    size_t total = 0;
+    start = clock();
+    for (int i = 0; i < diagnostics->count; i++) {
+        format_diagnostic(diagnostics, &diagnostics->records[i], message, sizeof(message));
+        total += strlen(message);
+    }
+    double formatting = elapsed_seconds(start);
+
+    printf("\nPrograma com %d linhas com erro (%zu KB):\n", n, strlen(source) / 1024);
+    printf("  análise:    %.3f s, %d erro(s) registrados (%zu bytes por registro)\n",
+           analysis, diagnostics->count, sizeof(Diagnostic));
+    printf("              %d strings internadas, %.1f KB de texto\n",
+           diagnostics->string_count, diagnostics->text_length / 1024.0);
+    printf("  formatação: %.3f s para todas as mensagens (%.1f KB), feita só na impressão\n",
+           formatting, total / 1024.0);
+    free_symbol_table(&analyzer.table);
+    free_diagnostics(&analyzer.diagnostics);
+    free(source);
+}
+
+void run_benchmark(int n) {
+    printf("=== BENCHMARK: TABELA DE SÍMBOLOS ===\n\n");
+    printf("Declarações seguidas do uso do nome anterior (somente operações na tabela):\n");
+    printf("%10s %14s %14s\n", "N", "linear (s)", "hash (s)");
+
+    char (*names)[16] = malloc(n * sizeof(*names));
+    for (int i = 0; i < n; i++) snprintf(names[i], sizeof(*names), "v%d", i);
+    for (int size = 1000; size <= n; size *= 5) {
+        // A busca linear é quadrática: acima de 25000 declarações levaria minutos
+        if (size <= 25000) printf("%10d %14.4f", size, time_linear_table(names, size));
+        else printf("%10d %14s", size, "-");
+        printf(" %14.4f\n", time_hash_table(names, size));
+        if (size * 5 > n && size != n) size = n / 5;
+    }
+    free(names);
+
+    char* source = generate_declarations(n);
+    Analyzer analyzer;
+    init_analyzer(&analyzer, source);
+    clock_t start = clock();
+    check_program(&analyzer);
+    double seconds = elapsed_seconds(start);
+    printf("\nAnálise completa de %d declarações (%zu KB, blocos aninhados):\n",
+           n, strlen(source) / 1024);
+    printf("  %.3f s, %.0f declarações/s, %d símbolos, %d nomes distintos, %d erro(s)\n",
+           seconds, seconds > 0 ? n / seconds : 0.0, analyzer.table.symbol_count,
+           analyzer.table.name_count, analyzer.diagnostics.count);
+    free_symbol_table(&analyzer.table);
+    free_diagnostics(&analyzer.diagnostics);
+    free(source);
+
+    run_error_benchmark(n);
+}
+
+int main(int argc, char* argv[]) {
+    build_type_table();
+
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 100000;
+        if (n < 1000) {
+            printf("Uso: %s --benchmark [N >= 1000]\n", argv[0]);
+            return 1;
+        }
+        run_benchmark(n);
+        return 0;
+    }
+
     printf("=== ANALISADOR SEMÂNTICO PARA LINGUAGEM C SIMPLIFICADA ===\n");
     printf("Este programa verifica a correção semântica de declarações e\n");
     printf("expressões, incluindo tipos, escopo e inicialização de variáveis.\n");
@@ -767,6 +1467,23 @@ int main() {
         "ERRO: Operação aritmética com booleanos"
     );
     
+    // Escopos aninhados
+    analyze_code(
+        "int x = 1;\n"
+        "{\n"
+        "    float x = 2.5;\n"
+        "    int y = 3;\n"
+        "    x = x * 2.0;\n"
+        "    {\n"
+        "        bool y = true;\n"
+        "    }\n"
+        "    y = y + 1;\n"
+        "}\n"
+        "x = x + 1;\n"
+        "y = 4;\n",
+        "ESCOPOS: sombreamento em blocos e variável fora do escopo"
+    );
+    
     // Expressões complexas válidas
     analyze_code(
         "int a = 10;\n"
@@ -777,12 +1494,27 @@ int main() {
         "CÓDIGO VÁLIDO - Expressões complexas com tipos compatíveis"
     );
     
+    // Valores calculados na compilação
+    analyze_code(
+        "int a = 10;\n"
+        "int b = a * 3 + 2;\n"
+        "float media = b / 4.0;\n"
+        "bool ok = (b == 32) && true;\n"
+        "int n;\n"
+        "n = b - 32;\n"
+        "int q = a / n;\n"
+        "a = q;\n",
+        "CONSTANTES: valores calculados e divisão por zero detectada"
+    );
+    
     printf("\n=== VERIFICAÇÕES SEMÂNTICAS IMPLEMENTADAS ===\n");
     printf("• Declaração obrigatória de variáveis antes do uso\n");
     printf("• Verificação de compatibilidade de tipos em operações\n");
     printf("• Verificação de compatibilidade em atribuições\n");
-    printf("• Detecção de redeclaração de variáveis\n");
+    printf("• Detecção de redeclaração de variáveis (no mesmo escopo)\n");
+    printf("• Escopos aninhados com sombreamento de nomes\n");
     printf("• Verificação de inicialização antes do uso\n");
+    printf("• Avaliação de expressões constantes e divisão por zero\n");
     printf("• Promoção automática de tipos (int -> float)\n");
     printf("• Verificação de tipos em operações lógicas\n");
     printf("• Verificação de tipos em comparações\n");
@@ -68,56 +68,102 @@ DataType get_variable_type(const char* name) {
     return TYPE_ERROR;
 }
 
-DataType check_binary_operation(DataType left, DataType right, const char* op) {
+/*
+ * Regras de tipos dos operadores
+ *
+ * Em vez de uma cadeia de if/strcmp por operador, as regras estão escritas
+ * como dados: cada linha da especificação dá os operadores, os tipos
+ * aceitos de cada lado, o tipo para o qual os operandos são convertidos e
+ * o resultado. build_type_table expande a especificação em uma tabela
+ * [operador][esquerdo][direito], e verificar uma operação é uma leitura.
+ */
+
+typedef enum {
+    OP_ADD, OP_SUB, OP_MUL, OP_DIV,     // aritméticos
+    OP_EQ, OP_NE,                       // comparação
+    OP_AND, OP_OR,                      // lógicos
+    OP_COUNT
+} BinaryOp;
+
+#define TYPE_COUNT (TYPE_ERROR + 1)
+#define OPS(op) (1u << (op))
+#define TYPES(type) (1u << (type))
+
+static const char* op_symbol[OP_COUNT] = {"+", "-", "*", "/", "==", "!=", "&&", "||"};
+
+// Mensagem de erro de cada operador (por categoria)
+static const char* op_error[OP_COUNT] = {
+    "Operação aritmética com tipo bool", "Operação aritmética com tipo bool",
+    "Operação aritmética com tipo bool", "Operação aritmética com tipo bool",
+    "Comparação entre tipos diferentes", "Comparação entre tipos diferentes",
+    "Operação lógica requer tipo bool", "Operação lógica requer tipo bool"
+};
+
+typedef struct {
+    unsigned int operators;
+    unsigned int left;
+    unsigned int right;
+    DataType operand;       // tipo dos operandos depois da conversão implícita
+    DataType result;
+} TypeRuleSpec;
+
+#define ARITHMETIC (OPS(OP_ADD) | OPS(OP_SUB) | OPS(OP_MUL) | OPS(OP_DIV))
+#define NUMERIC (TYPES(TYPE_INT) | TYPES(TYPE_FLOAT))
+
+// A primeira regra que cobre uma combinação vale
+static const TypeRuleSpec type_spec[] = {
+    {ARITHMETIC,                 TYPES(TYPE_INT),   TYPES(TYPE_INT),   TYPE_INT,   TYPE_INT},
+    {ARITHMETIC,                 NUMERIC,           NUMERIC,           TYPE_FLOAT, TYPE_FLOAT},
+    {OPS(OP_EQ) | OPS(OP_NE),    TYPES(TYPE_INT),   TYPES(TYPE_INT),   TYPE_INT,   TYPE_BOOL},
+    {OPS(OP_EQ) | OPS(OP_NE),    TYPES(TYPE_FLOAT), TYPES(TYPE_FLOAT), TYPE_FLOAT, TYPE_BOOL},
+    {OPS(OP_EQ) | OPS(OP_NE),    TYPES(TYPE_BOOL),  TYPES(TYPE_BOOL),  TYPE_BOOL,  TYPE_BOOL},
+    {OPS(OP_AND) | OPS(OP_OR),   TYPES(TYPE_BOOL),  TYPES(TYPE_BOOL),  TYPE_BOOL,  TYPE_BOOL},
+};
+
+typedef struct {
+    DataType result;
+    DataType operand;
+} TypeRule;
+
+TypeRule type_table[OP_COUNT][TYPE_COUNT][TYPE_COUNT];
+
+void build_type_table() {
+    for (int op = 0; op < OP_COUNT; op++) {
+        for (int l = 0; l < TYPE_COUNT; l++) {
+            for (int r = 0; r < TYPE_COUNT; r++) {
+                type_table[op][l][r].result = TYPE_ERROR;
+                type_table[op][l][r].operand = TYPE_ERROR;
+                for (size_t i = 0; i < sizeof(type_spec) / sizeof(type_spec[0]); i++) {
+                    const TypeRuleSpec* rule = &type_spec[i];
+                    if ((rule->operators & OPS(op)) && (rule->left & TYPES(l)) &&
+                        (rule->right & TYPES(r))) {
+                        type_table[op][l][r].result = rule->result;
+                        type_table[op][l][r].operand = rule->operand;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+DataType check_binary_operation(DataType left, DataType right, BinaryOp op) {
     printf("  Verificando operação: %s %s %s\n", 
-           type_name(left), op, type_name(right));
+           type_name(left), op_symbol[op], type_name(right));
     
     if (left == TYPE_ERROR || right == TYPE_ERROR) {
         return TYPE_ERROR;
     }
     
-    // Operações aritméticas
-    if (strcmp(op, "+") == 0 || strcmp(op, "-") == 0 || 
-        strcmp(op, "*") == 0 || strcmp(op, "/") == 0) {
-        
-        if (left == TYPE_BOOL || right == TYPE_BOOL) {
-            printf("  ERRO: Operação aritmética com tipo bool\n");
-            return TYPE_ERROR;
-        }
-        
-        if (left == TYPE_FLOAT || right == TYPE_FLOAT) {
-            printf("  Resultado: float (promoção de tipo)\n");
-            return TYPE_FLOAT;
-        }
-        
-        printf("  Resultado: int\n");
-        return TYPE_INT;
-    }
-    
-    // Operações de comparação
-    if (strcmp(op, "==") == 0 || strcmp(op, "!=") == 0) {
-        if (left == right) {
-            printf("  Resultado: bool\n");
-            return TYPE_BOOL;
-        } else {
-            printf("  ERRO: Comparação entre tipos diferentes\n");
-            return TYPE_ERROR;
-        }
-    }
-    
-    // Operações lógicas
-    if (strcmp(op, "&&") == 0 || strcmp(op, "||") == 0) {
-        if (left == TYPE_BOOL && right == TYPE_BOOL) {
-            printf("  Resultado: bool\n");
-            return TYPE_BOOL;
-        } else {
-            printf("  ERRO: Operação lógica requer tipo bool\n");
-            return TYPE_ERROR;
-        }
+    TypeRule rule = type_table[op][left][right];
+    if (rule.result == TYPE_ERROR) {
+        printf("  ERRO: %s\n", op_error[op]);
+    } else if (rule.operand != left || rule.operand != right) {
+        printf("  Resultado: %s (promoção de tipo)\n", type_name(rule.result));
+    } else {
+        printf("  Resultado: %s\n", type_name(rule.result));
     }
-    
-    printf("  ERRO: Operador desconhecido '%s'\n", op);
-    return TYPE_ERROR;
+    return rule.result;
 }
 
 void check_assignment(const char* var_name, DataType expr_type) {
@@ -161,15 +207,15 @@ void demo_type_checking() {
     printf("\n=== TESTE 2: VERIFICAÇÃO DE TIPOS EM OPERAÇÕES ===\n");
     
     // Operações válidas
-    check_binary_operation(TYPE_INT, TYPE_INT, "+");
-    check_binary_operation(TYPE_INT, TYPE_FLOAT, "*");
-    check_binary_operation(TYPE_BOOL, TYPE_BOOL, "&&");
-    check_binary_operation(TYPE_INT, TYPE_INT, "==");
+    check_binary_operation(TYPE_INT, TYPE_INT, OP_ADD);
+    check_binary_operation(TYPE_INT, TYPE_FLOAT, OP_MUL);
+    check_binary_operation(TYPE_BOOL, TYPE_BOOL, OP_AND);
+    check_binary_operation(TYPE_INT, TYPE_INT, OP_EQ);
     
     // Operações inválidas
-    check_binary_operation(TYPE_BOOL, TYPE_INT, "+");
-    check_binary_operation(TYPE_INT, TYPE_FLOAT, "==");
-    check_binary_operation(TYPE_INT, TYPE_INT, "&&");
+    check_binary_operation(TYPE_BOOL, TYPE_INT, OP_ADD);
+    check_binary_operation(TYPE_INT, TYPE_FLOAT, OP_EQ);
+    check_binary_operation(TYPE_INT, TYPE_INT, OP_AND);
 }
 
 void demo_assignments() {
@@ -191,17 +237,19 @@ void demo_complex_expressions() {
     printf("\n=== TESTE 4: EXPRESSÕES COMPLEXAS ===\n");
     
     printf("Simulando: int result = (x + 10) * y;\n");
-    DataType expr1 = check_binary_operation(TYPE_INT, TYPE_INT, "+"); // x + 10
-    DataType expr2 = check_binary_operation(expr1, TYPE_FLOAT, "*");  // (x+10) * y
+    DataType expr1 = check_binary_operation(TYPE_INT, TYPE_INT, OP_ADD); // x + 10
+    DataType expr2 = check_binary_operation(expr1, TYPE_FLOAT, OP_MUL);  // (x+10) * y
     check_assignment("result", expr2);
     
     printf("\nSimulando: bool test = (x == 10) && flag;\n");
-    DataType comp = check_binary_operation(TYPE_INT, TYPE_INT, "==");  // x == 10
-    DataType logic = check_binary_operation(comp, TYPE_BOOL, "&&");   // (...) && flag
+    DataType comp = check_binary_operation(TYPE_INT, TYPE_INT, OP_EQ);  // x == 10
+    DataType logic = check_binary_operation(comp, TYPE_BOOL, OP_AND);   // (...) && flag
     check_assignment("test", logic);
 }
 
 int main() {
+    build_type_table();
+
     printf("=== ANALISADOR SEMÂNTICO - VERIFICAÇÃO DE TIPOS ===\n");
     printf("Demonstração de verificações semânticas básicas em compiladores\n");
     
@@ -1,9 +1,9 @@
 /*
  * Gerador de Código Intermediário com SDT
- * 
+ *
  * Implementa um tradutor que gera código de três endereços
  * para atribuições com expressões aritméticas.
- * 
+ *
  * Gramática com geração de código:
  *   S → id = E ;    { emit(id, "=", E.addr) }
  *   E → E + T       { t = new_temp(); emit(t, "=", E.addr, "+", T.addr); E.addr = t }
@@ -13,9 +13,20 @@
  *   F → (E)         { F.addr = E.addr }
  *   F → id          { F.addr = id.lexeme }
  *   F → num         { F.addr = num.lexeme }
- * 
- * Compilação: gcc gerador_codigo.c -o gerador_codigo -std=c99
- * Uso: ./gerador_codigo
+ *
+ * Depois de impresso, o código é executado por uma máquina de
+ * registradores; as variáveis atribuídas valem nas linhas seguintes.
+ *
+ * Todo o estado de uma tradução (código, tabelas, analisador léxico e
+ * erros) fica em um Translator; não há variáveis globais. O código cresce
+ * por duplicação, sem limite de instruções, e threads diferentes podem
+ * traduzir ao mesmo tempo, cada uma com o seu Translator.
+ *
+ * Compilação: gcc gerador_codigo.c -o gerador_codigo -std=c99 -pthread
+ * Uso:
+ *   ./gerador_codigo                           modo interativo
+ *   ./gerador_codigo --benchmark [N] [T]       expressão com N termos
+ *                                              traduzida por T threads
  */
 
 #define _GNU_SOURCE
@@ -23,6 +34,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <time.h>
 
 // ========== DEFINIÇÃO DE TOKENS ==========
 typedef enum {
@@ -46,133 +60,413 @@ typedef struct {
 } Token;
 
 // ========== CÓDIGO DE TRÊS ENDEREÇOS ==========
+
+/*
+ * Operandos: o tipo nos 2 bits de baixo e um índice no resto. Um
+ * temporário é só o seu número; variáveis e constantes são índices nas
+ * tabelas de nomes e de valores, em que cada nome ou valor aparece uma vez.
+ * Uma instrução ocupa 16 bytes e nenhum texto é copiado ao emiti-la.
+ */
+typedef uint32_t Operand;
+
+typedef enum {
+    OPND_NONE,
+    OPND_TEMP,
+    OPND_VAR,
+    OPND_CONST
+} OperandKind;
+
+#define OPERAND(kind, index) ((Operand)(((uint32_t)(index) << 2) | (uint32_t)(kind)))
+#define OPERAND_KIND(operand) ((OperandKind)((operand) & 3u))
+#define OPERAND_INDEX(operand) ((int)((operand) >> 2))
+#define NO_OPERAND OPERAND(OPND_NONE, 0)
+
 typedef struct {
-    char op;        // '+', '-', '*', '/', '='
-    char arg1[32];  // Primeiro argumento
-    char arg2[32];  // Segundo argumento
-    char result[32];// Resultado (temporário ou variável)
+    uint32_t op;        // '+', '-', '*', '/', '='
+    Operand arg1;       // Primeiro argumento
+    Operand arg2;       // Segundo argumento (NO_OPERAND na cópia)
+    Operand result;     // Resultado (temporário ou variável)
 } Instruction;
 
-#define MAX_INSTRUCTIONS 100
-Instruction code[MAX_INSTRUCTIONS];
-int code_count = 0;
+/*
+ * Estado de uma tradução. O código, os temporários e as constantes são
+ * da linha atual (translator_reset os esvazia, mantendo a memória); os
+ * nomes e os valores das variáveis valem para todas as linhas.
+ */
+typedef struct {
+    Instruction* code;
+    int code_count;
+    int code_capacity;
+    int temp_count;
+
+    char** var_names;
+    int var_count;
+    int var_capacity;
+    int* var_values;            // valor de cada variável entre as linhas
+    int* var_defined;           // variável já recebeu valor?
+    int value_capacity;
+
+    int* constants;
+    int const_count;
+    int const_capacity;
+
+    int* slots;                 // hash: var + 1, -(const + 1) ou 0 (vazio)
+    int slot_capacity;          // potência de 2
+
+    // Analisador léxico
+    const char* input;
+    int pos;
+    Token current_token;
+
+    char error[128];            // primeiro erro da linha; "" se não houve
+} Translator;
+
+void translator_init(Translator* tr) {
+    memset(tr, 0, sizeof(*tr));
+}
+
+static void fill_slots(Translator* tr);
 
-int temp_count = 0;
+// Prepara o tradutor para uma nova linha
+void translator_reset(Translator* tr, const char* input) {
+    tr->code_count = 0;
+    tr->temp_count = 0;
+    if (tr->const_count > 0) {
+        tr->const_count = 0;
+        fill_slots(tr);         // tira as constantes da linha anterior do hash
+    }
+    tr->input = input;
+    tr->pos = 0;
+    tr->error[0] = '\0';
+}
+
+void translator_free(Translator* tr) {
+    for (int i = 0; i < tr->var_count; i++) free(tr->var_names[i]);
+    free(tr->var_names);
+    free(tr->var_values);
+    free(tr->var_defined);
+    free(tr->constants);
+    free(tr->slots);
+    free(tr->code);
+    memset(tr, 0, sizeof(*tr));
+}
+
+static void* grow_array(void* array, int* capacity, size_t element_size) {
+    *capacity = *capacity ? *capacity * 2 : 16;
+    array = realloc(array, (size_t)*capacity * element_size);
+    if (array == NULL) {
+        fprintf(stderr, "Erro: falha ao alocar memória\n");
+        exit(1);
+    }
+    return array;
+}
+
+// Guarda o primeiro erro da linha; a tradução para e devolve o controle
+static void fail(Translator* tr, const char* message) {
+    if (tr->error[0] == '\0') {
+        snprintf(tr->error, sizeof(tr->error), "%s", message);
+    }
+}
 
 /*
- * Cria um novo temporário
- * Retorna: nome do temporário (ex: "t0", "t1", ...)
+ * Nomes e constantes são internados por hash aberto (sondagem linear),
+ * como em 12-geracao-codigo-intermediario; o hash fica no Translator.
  */
-char* new_temp() {
-    /* Aloca um novo buffer para cada temporário para evitar sobrescrever um buffer estático */
-    char *temp = malloc(16);
-    if (temp == NULL) {
-        fprintf(stderr, "Erro: falha ao alocar memória para temporário\n");
+static unsigned int hash_text(const char* text) {
+    unsigned int hash = 2166136261u;    // FNV-1a
+    while (*text) {
+        hash ^= (unsigned char)*text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int hash_value(int value) {
+    unsigned int hash = (unsigned int)value * 2654435761u;
+    return hash ^ (hash >> 16);
+}
+
+// Reinsere as variáveis e as constantes atuais, com a capacidade atual
+static void fill_slots(Translator* tr) {
+    memset(tr->slots, 0, tr->slot_capacity * sizeof(int));
+    unsigned int mask = (unsigned int)tr->slot_capacity - 1;
+    for (int v = 0; v < tr->var_count; v++) {
+        unsigned int i = hash_text(tr->var_names[v]) & mask;
+        while (tr->slots[i]) i = (i + 1) & mask;
+        tr->slots[i] = v + 1;
+    }
+    for (int c = 0; c < tr->const_count; c++) {
+        unsigned int i = hash_value(tr->constants[c]) & mask;
+        while (tr->slots[i]) i = (i + 1) & mask;
+        tr->slots[i] = -(c + 1);
+    }
+}
+
+static void grow_slots(Translator* tr) {
+    free(tr->slots);
+    tr->slot_capacity = tr->slot_capacity ? tr->slot_capacity * 2 : 64;
+    tr->slots = malloc(tr->slot_capacity * sizeof(int));
+    if (tr->slots == NULL) {
+        fprintf(stderr, "Erro: falha ao alocar memória\n");
         exit(1);
     }
-    snprintf(temp, 16, "t%d", temp_count++);
-    return temp;
+    fill_slots(tr);
+}
+
+// Operando da variável; o nome é copiado só na primeira ocorrência
+Operand var_operand(Translator* tr, const char* name) {
+    if (2 * (tr->var_count + tr->const_count + 1) > tr->slot_capacity) grow_slots(tr);
+    unsigned int mask = (unsigned int)tr->slot_capacity - 1;
+    unsigned int i = hash_text(name) & mask;
+    for (; tr->slots[i]; i = (i + 1) & mask) {
+        int var = tr->slots[i] - 1;
+        if (var >= 0 && strcmp(tr->var_names[var], name) == 0) return OPERAND(OPND_VAR, var);
+    }
+    if (tr->var_count == tr->var_capacity) {
+        tr->var_names = grow_array(tr->var_names, &tr->var_capacity, sizeof(char*));
+    }
+    tr->var_names[tr->var_count] = strdup(name);
+    tr->slots[i] = tr->var_count + 1;
+    return OPERAND(OPND_VAR, tr->var_count++);
+}
+
+Operand const_operand(Translator* tr, int value) {
+    if (2 * (tr->var_count + tr->const_count + 1) > tr->slot_capacity) grow_slots(tr);
+    unsigned int mask = (unsigned int)tr->slot_capacity - 1;
+    unsigned int i = hash_value(value) & mask;
+    for (; tr->slots[i]; i = (i + 1) & mask) {
+        int c = -tr->slots[i] - 1;
+        if (c >= 0 && tr->constants[c] == value) return OPERAND(OPND_CONST, c);
+    }
+    if (tr->const_count == tr->const_capacity) {
+        tr->constants = grow_array(tr->constants, &tr->const_capacity, sizeof(int));
+    }
+    tr->constants[tr->const_count] = value;
+    tr->slots[i] = -(tr->const_count + 1);
+    return OPERAND(OPND_CONST, tr->const_count++);
 }
 
 /*
- * Emite uma instrução de três endereços
+ * Cria um novo temporário
+ * Retorna: o operando t0, t1, ... (nada é alocado)
  */
-void emit(char op, const char* arg1, const char* arg2, const char* result) {
-    if (code_count >= MAX_INSTRUCTIONS) {
-        fprintf(stderr, "Erro: limite de instruções excedido\n");
-        exit(1);
+Operand new_temp(Translator* tr) {
+    return OPERAND(OPND_TEMP, tr->temp_count++);
+}
+
+// Texto do operando, para impressão
+const char* operand_text(const Translator* tr, Operand operand, char* buffer) {
+    switch (OPERAND_KIND(operand)) {
+        case OPND_TEMP:  sprintf(buffer, "t%d", OPERAND_INDEX(operand)); return buffer;
+        case OPND_CONST: sprintf(buffer, "%d", tr->constants[OPERAND_INDEX(operand)]); return buffer;
+        case OPND_VAR:   return tr->var_names[OPERAND_INDEX(operand)];
+        default:         return "";
+    }
+}
+
+/*
+ * Emite uma instrução de três endereços. O buffer dobra quando enche,
+ * então o custo por instrução é constante (amortizado).
+ */
+void emit(Translator* tr, char op, Operand arg1, Operand arg2, Operand result) {
+    if (tr->code_count == tr->code_capacity) {
+        tr->code = grow_array(tr->code, &tr->code_capacity, sizeof(Instruction));
     }
     
-    code[code_count].op = op;
-    strcpy(code[code_count].arg1, arg1);
-    strcpy(code[code_count].arg2, arg2);
-    strcpy(code[code_count].result, result);
-    code_count++;
+    Instruction* instr = &tr->code[tr->code_count++];
+    instr->op = (uint32_t)op;
+    instr->arg1 = arg1;
+    instr->arg2 = arg2;
+    instr->result = result;
 }
 
 /*
  * Imprime o código intermediário gerado
  */
-void print_code() {
+void print_code(const Translator* tr) {
     printf("\n╔════════════════════════════════════════════╗\n");
     printf("║  CÓDIGO INTERMEDIÁRIO GERADO               ║\n");
     printf("╚════════════════════════════════════════════╝\n\n");
     
-    for (int i = 0; i < code_count; i++) {
-        if (code[i].op == '=') {
-            // Atribuição simples
-            if (strlen(code[i].arg2) > 0) {
-                // Atribuição com operação: t = a op b
-                printf("%s = %s %c %s\n", 
-                       code[i].result,
-                       code[i].arg1,
-                       code[i].arg2[0],  // operador em arg2
-                       code[i].arg2 + 1); // segundo operando
-            } else {
-                // Atribuição direta: x = t
-                printf("%s = %s\n", code[i].result, code[i].arg1);
-            }
+    char r[16], a[16], b[16];
+    for (int i = 0; i < tr->code_count; i++) {
+        const Instruction* instr = &tr->code[i];
+        const char* result = operand_text(tr, instr->result, r);
+        const char* arg1 = operand_text(tr, instr->arg1, a);
+        if (instr->op == '=') {
+            // Atribuição direta: x = t
+            printf("%s = %s\n", result, arg1);
         } else {
             // Operação aritmética: t = a op b
-            printf("%s = %s %c %s\n", 
-                   code[i].result,
-                   code[i].arg1,
-                   code[i].op,
-                   code[i].arg2);
+            printf("%s = %s %c %s\n", result, arg1, (char)instr->op,
+                   operand_text(tr, instr->arg2, b));
         }
     }
     printf("\n");
 }
 
-// ========== VARIÁVEIS GLOBAIS DO LEXER ==========
-char* input;
-int pos = 0;
-Token current_token;
+// ========== EXECUÇÃO DO CÓDIGO ==========
+
+/*
+ * Máquina de registradores para o código gerado. O banco tem as
+ * variáveis, os temporários e as constantes da linha, nessa ordem, e o
+ * registrador de um operando é o início da faixa do seu tipo mais o
+ * índice: a carga não procura nomes. Os valores das variáveis persistem
+ * entre as linhas, então "a = 2;" seguido de "b = a * 3;" dá b = 6.
+ */
+typedef struct {
+    char op;
+    int dst;
+    int a;
+    int b;
+} RegInstr;
+
+static int register_of(const Translator* tr, Operand operand) {
+    switch (OPERAND_KIND(operand)) {
+        case OPND_VAR:   return OPERAND_INDEX(operand);
+        case OPND_TEMP:  return tr->var_count + OPERAND_INDEX(operand);
+        case OPND_CONST: return tr->var_count + tr->temp_count + OPERAND_INDEX(operand);
+        default:         return 0;
+    }
+}
+
+/*
+ * Aritmética inteira com volta no estouro (complemento de dois), como na
+ * VM de 12-geracao-codigo-intermediario. Em int com sinal o estouro seria
+ * comportamento indefinido. wrap_div exige b != 0.
+ */
+static int wrap_add(int a, int b) { return (int)((unsigned int)a + (unsigned int)b); }
+static int wrap_sub(int a, int b) { return (int)((unsigned int)a - (unsigned int)b); }
+static int wrap_mul(int a, int b) { return (int)((unsigned int)a * (unsigned int)b); }
+static int wrap_div(int a, int b) { return b == -1 ? (int)(0u - (unsigned int)a) : a / b; }
+
+/*
+ * Carrega o código em instruções de registradores e as executa. Com
+ * verbose, variáveis lidas antes de receber valor são avisadas (valem 0)
+ * e a divisão por zero é reportada. Devolve 0 em divisão por zero (a
+ * execução para na instrução).
+ */
+int run_code(Translator* tr, int verbose) {
+    // Valores das variáveis novas, com a mesma capacidade da tabela de nomes
+    if (tr->value_capacity < tr->var_count) {
+        int old = tr->value_capacity;
+        tr->value_capacity = tr->var_capacity;
+        tr->var_values = realloc(tr->var_values, tr->value_capacity * sizeof(int));
+        tr->var_defined = realloc(tr->var_defined, tr->value_capacity * sizeof(int));
+        if (tr->var_values == NULL || tr->var_defined == NULL) {
+            fprintf(stderr, "Erro: falha ao alocar memória\n");
+            exit(1);
+        }
+        memset(tr->var_values + old, 0, (tr->value_capacity - old) * sizeof(int));
+        memset(tr->var_defined + old, 0, (tr->value_capacity - old) * sizeof(int));
+    }
+
+    RegInstr* program = malloc((tr->code_count + 1) * sizeof(RegInstr));
+    for (int i = 0; i < tr->code_count; i++) {
+        const Instruction* instr = &tr->code[i];
+        program[i].op = (char)instr->op;
+        program[i].a = register_of(tr, instr->arg1);
+        program[i].b = instr->op == '=' ? program[i].a : register_of(tr, instr->arg2);
+        program[i].dst = register_of(tr, instr->result);
+
+        Operand operands[2] = {instr->arg1, instr->arg2};
+        for (int k = 0; k < 2; k++) {
+            if (OPERAND_KIND(operands[k]) != OPND_VAR) continue;
+            int var = OPERAND_INDEX(operands[k]);
+            if (!tr->var_defined[var]) {
+                if (verbose) printf("Aviso: variável '%s' sem valor; usando 0\n", tr->var_names[var]);
+                tr->var_defined[var] = 1;
+            }
+        }
+    }
+
+    int register_count = tr->var_count + tr->temp_count + tr->const_count;
+    int* registers = calloc(register_count + 1, sizeof(int));
+    memcpy(registers, tr->var_values, tr->var_count * sizeof(int));
+    memcpy(registers + tr->var_count + tr->temp_count, tr->constants, tr->const_count * sizeof(int));
+
+    int ok = 1;
+    for (int i = 0; i < tr->code_count && ok; i++) {
+        const RegInstr* in = &program[i];
+        switch (in->op) {
+            case '+': registers[in->dst] = wrap_add(registers[in->a], registers[in->b]); break;
+            case '-': registers[in->dst] = wrap_sub(registers[in->a], registers[in->b]); break;
+            case '*': registers[in->dst] = wrap_mul(registers[in->a], registers[in->b]); break;
+            case '/':
+                if (registers[in->b] == 0) {
+                    if (verbose) {
+                        char r[16], a[16], b[16];
+                        fprintf(stderr, "Erro de execução: divisão por zero em %s = %s / %s\n",
+                                operand_text(tr, tr->code[i].result, r),
+                                operand_text(tr, tr->code[i].arg1, a),
+                                operand_text(tr, tr->code[i].arg2, b));
+                    }
+                    ok = 0;
+                    break;
+                }
+                registers[in->dst] = wrap_div(registers[in->a], registers[in->b]);
+                break;
+            case '=': registers[in->dst] = registers[in->a]; break;
+        }
+        // A variável só passa a ter valor quando a atribuição executa
+        if (ok && OPERAND_KIND(tr->code[i].result) == OPND_VAR) {
+            tr->var_defined[OPERAND_INDEX(tr->code[i].result)] = 1;
+        }
+    }
+
+    // As variáveis guardam o que foi atribuído até a instrução que parou
+    memcpy(tr->var_values, registers, tr->var_count * sizeof(int));
+    free(registers);
+    free(program);
+    return ok;
+}
 
 // ========== ANALISADOR LÉXICO ==========
 
-Token next_token() {
+Token next_token(Translator* tr) {
+    const char* input = tr->input;
+    
     // Pular espaços em branco
-    while (input[pos] == ' ' || input[pos] == '\t') {
-        pos++;
+    while (input[tr->pos] == ' ' || input[tr->pos] == '\t') {
+        tr->pos++;
     }
     
     Token tok;
     tok.lexeme[0] = '\0';
     
     // Fim da entrada
-    if (input[pos] == '\0') {
+    if (input[tr->pos] == '\0') {
         tok.type = TOKEN_EOF;
         return tok;
     }
     
     // Números
-    if (isdigit(input[pos])) {
+    if (isdigit((unsigned char)input[tr->pos])) {
         tok.type = TOKEN_NUM;
         tok.value = 0;
         int i = 0;
-        while (isdigit(input[pos]) && i < 31) {
-            tok.lexeme[i++] = input[pos];
-            tok.value = tok.value * 10 + (input[pos] - '0');
-            pos++;
+        while (isdigit((unsigned char)input[tr->pos]) && i < 31) {
+            tok.lexeme[i++] = input[tr->pos];
+            tok.value = tok.value * 10 + (input[tr->pos] - '0');
+            tr->pos++;
         }
         tok.lexeme[i] = '\0';
         return tok;
     }
     
     // Identificadores
-    if (isalpha(input[pos]) || input[pos] == '_') {
+    if (isalpha((unsigned char)input[tr->pos]) || input[tr->pos] == '_') {
         tok.type = TOKEN_ID;
         int i = 0;
-        while ((isalnum(input[pos]) || input[pos] == '_') && i < 31) {
-            tok.lexeme[i++] = input[pos++];
+        while ((isalnum((unsigned char)input[tr->pos]) || input[tr->pos] == '_') && i < 31) {
+            tok.lexeme[i++] = input[tr->pos++];
         }
         tok.lexeme[i] = '\0';
         return tok;
     }
     
     // Operadores e pontuação
-    switch (input[pos++]) {
+    switch (input[tr->pos++]) {
         case '+': tok.type = TOKEN_PLUS; strcpy(tok.lexeme, "+"); break;
         case '-': tok.type = TOKEN_MINUS; strcpy(tok.lexeme, "-"); break;
         case '*': tok.type = TOKEN_MULT; strcpy(tok.lexeme, "*"); break;
@@ -181,70 +475,63 @@ Token next_token() {
         case ')': tok.type = TOKEN_RPAREN; strcpy(tok.lexeme, ")"); break;
         case '=': tok.type = TOKEN_ASSIGN; strcpy(tok.lexeme, "="); break;
         case ';': tok.type = TOKEN_SEMI; strcpy(tok.lexeme, ";"); break;
-        default:
-            fprintf(stderr, "Erro léxico: caractere inválido '%c'\n", input[pos-1]);
-            exit(1);
+        default: {
+            char message[64];
+            snprintf(message, sizeof(message), "Erro léxico: caractere inválido '%c'", input[tr->pos - 1]);
+            fail(tr, message);
+            tok.type = TOKEN_EOF;
+        }
     }
     
     return tok;
 }
 
-void advance() {
-    current_token = next_token();
+void advance(Translator* tr) {
+    tr->current_token = next_token(tr);
 }
 
 // ========== ANALISADOR SINTÁTICO COM GERAÇÃO DE CÓDIGO ==========
 
 // Declarações forward
-char* parse_expr();
-char* parse_term();
-char* parse_factor();
+Operand parse_expr(Translator* tr);
+Operand parse_term(Translator* tr);
+Operand parse_factor(Translator* tr);
 
 /*
  * F → id | num | (E)
  * Retorna: endereço do resultado (atributo sintetizado)
  */
-char* parse_factor() {
-    if (current_token.type == TOKEN_NUM) {
-        // F → num { F.addr = num.lexeme }
-        char* addr = malloc(32);
-        if (addr == NULL) {
-            fprintf(stderr, "Erro: falha ao alocar memória\n");
-            exit(1);
-        }
-        strcpy(addr, current_token.lexeme);
-        advance();
+Operand parse_factor(Translator* tr) {
+    if (tr->current_token.type == TOKEN_NUM) {
+        // F → num { F.addr = num.value }
+        Operand addr = const_operand(tr, tr->current_token.value);
+        advance(tr);
         return addr;
     }
     
-    if (current_token.type == TOKEN_ID) {
+    if (tr->current_token.type == TOKEN_ID) {
         // F → id { F.addr = id.lexeme }
-        char* addr = malloc(32);
-        if (addr == NULL) {
-            fprintf(stderr, "Erro: falha ao alocar memória\n");
-            exit(1);
-        }
-        strcpy(addr, current_token.lexeme);
-        advance();
+        Operand addr = var_operand(tr, tr->current_token.lexeme);
+        advance(tr);
         return addr;
     }
     
-    if (current_token.type == TOKEN_LPAREN) {
+    if (tr->current_token.type == TOKEN_LPAREN) {
         // F → (E) { F.addr = E.addr }
-        advance();  // consome '('
-        char* addr = parse_expr();
+        advance(tr);  // consome '('
+        Operand addr = parse_expr(tr);
         
-        if (current_token.type != TOKEN_RPAREN) {
-            fprintf(stderr, "Erro sintático: esperado ')'\n");
-            exit(1);
+        if (tr->current_token.type != TOKEN_RPAREN) {
+            fail(tr, "Erro sintático: esperado ')'");
+            return NO_OPERAND;
         }
-        advance();  // consome ')'
+        advance(tr);  // consome ')'
         
         return addr;
     }
     
-    fprintf(stderr, "Erro sintático: esperado identificador, número ou '('\n");
-    exit(1);
+    fail(tr, "Erro sintático: esperado identificador, número ou '('");
+    return NO_OPERAND;
 }
 
 /*
@@ -252,21 +539,22 @@ char* parse_factor() {
  * T' → * F T' | / F T' | ε
  * Retorna: endereço do resultado (atributo sintetizado)
  */
-char* parse_term() {
+Operand parse_term(Translator* tr) {
     // T → F { T.addr = F.addr }
-    char* addr = parse_factor();
+    Operand addr = parse_factor(tr);
     
     // T' → * F T' | / F T' | ε
-    while (current_token.type == TOKEN_MULT || 
-           current_token.type == TOKEN_DIV) {
-        char op = (current_token.type == TOKEN_MULT) ? '*' : '/';
-        advance();
-        char* addr2 = parse_factor();
+    while (!tr->error[0] &&
+           (tr->current_token.type == TOKEN_MULT ||
+            tr->current_token.type == TOKEN_DIV)) {
+        char op = (tr->current_token.type == TOKEN_MULT) ? '*' : '/';
+        advance(tr);
+        Operand addr2 = parse_factor(tr);
         
         // Ação semântica: gerar código
         // T → T₁ op F { t = new_temp(); emit(t, "=", T₁.addr, op, F.addr); T.addr = t }
-        char* temp = new_temp();
-        emit(op, addr, addr2, temp);
+        Operand temp = new_temp(tr);
+        emit(tr, op, addr, addr2, temp);
         addr = temp;
     }
     
@@ -278,21 +566,22 @@ char* parse_term() {
  * E' → + T E' | - T E' | ε
  * Retorna: endereço do resultado (atributo sintetizado)
  */
-char* parse_expr() {
+Operand parse_expr(Translator* tr) {
     // E → T { E.addr = T.addr }
-    char* addr = parse_term();
+    Operand addr = parse_term(tr);
     
     // E' → + T E' | - T E' | ε
-    while (current_token.type == TOKEN_PLUS || 
-           current_token.type == TOKEN_MINUS) {
-        char op = (current_token.type == TOKEN_PLUS) ? '+' : '-';
-        advance();
-        char* addr2 = parse_term();
+    while (!tr->error[0] &&
+           (tr->current_token.type == TOKEN_PLUS ||
+            tr->current_token.type == TOKEN_MINUS)) {
+        char op = (tr->current_token.type == TOKEN_PLUS) ? '+' : '-';
+        advance(tr);
+        Operand addr2 = parse_term(tr);
         
         // Ação semântica: gerar código
         // E → E₁ op T { t = new_temp(); emit(t, "=", E₁.addr, op, T.addr); E.addr = t }
-        char* temp = new_temp();
-        emit(op, addr, addr2, temp);
+        Operand temp = new_temp(tr);
+        emit(tr, op, addr, addr2, temp);
         addr = temp;
     }
     
@@ -301,50 +590,161 @@ char* parse_expr() {
 
 /*
  * S → id = E ;
- * Traduz uma atribuição e gera código intermediário
+ * Traduz uma atribuição e gera código intermediário. Devolve 0 em erro
+ * léxico ou sintático, com a mensagem em tr->error.
  */
-void parse_assignment() {
+int parse_assignment(Translator* tr) {
     // id = E ;
-    if (current_token.type != TOKEN_ID) {
-        fprintf(stderr, "Erro sintático: esperado identificador\n");
-        exit(1);
+    if (tr->current_token.type != TOKEN_ID) {
+        fail(tr, "Erro sintático: esperado identificador");
+        return 0;
     }
     
-    char id[32];
-    if (current_token.lexeme == NULL) {
-        fprintf(stderr, "Erro de memória: identificador nulo\n");
-        exit(1);
-    }
-    strcpy(id, current_token.lexeme);
-    advance();
+    Operand id = var_operand(tr, tr->current_token.lexeme);
+    advance(tr);
     
-    if (current_token.type != TOKEN_ASSIGN) {
-        fprintf(stderr, "Erro sintático: esperado '='\n");
-        exit(1);
+    if (tr->current_token.type != TOKEN_ASSIGN) {
+        fail(tr, "Erro sintático: esperado '='");
+        return 0;
     }
-    advance();
+    advance(tr);
     
-    char* addr = parse_expr();
+    Operand addr = parse_expr(tr);
+    if (tr->error[0]) return 0;
     
     // Ação semântica: gerar código de atribuição
     // S → id = E { emit(id, "=", E.addr) }
-    Instruction instr;
-    instr.op = '=';
-    strcpy(instr.arg1, addr);
-    instr.arg2[0] = '\0';
-    strcpy(instr.result, id);
-    code[code_count++] = instr;
+    emit(tr, '=', addr, NO_OPERAND, id);
     
-    if (current_token.type != TOKEN_SEMI) {
-        fprintf(stderr, "Erro sintático: esperado ';'\n");
-        exit(1);
+    if (tr->current_token.type != TOKEN_SEMI) {
+        fail(tr, "Erro sintático: esperado ';'");
+        return 0;
     }
-    advance();
+    advance(tr);
+    return !tr->error[0];
+}
+
+// Traduz uma linha com o tradutor (o código fica em tr->code)
+int translate(Translator* tr, const char* line) {
+    translator_reset(tr, line);
+    advance(tr);  // Carregar primeiro token
+    return parse_assignment(tr);
+}
+
+// ========== BENCHMARK ==========
+
+/*
+ * Traduções simultâneas: cada thread tem o seu Translator e traduz a
+ * mesma linha; nada é compartilhado além do texto de entrada.
+ */
+typedef struct {
+    const char* line;
+    int instructions;
+    int capacity;
+    int value;
+    int ok;
+} TranslationJob;
+
+static void* translation_worker(void* arg) {
+    TranslationJob* job = arg;
+    Translator tr;
+    translator_init(&tr);
+    job->ok = translate(&tr, job->line) && run_code(&tr, 0);
+    job->instructions = tr.code_count;
+    job->capacity = tr.code_capacity;
+    job->value = job->ok ? tr.var_values[OPERAND_INDEX(tr.code[tr.code_count - 1].result)] : 0;
+    translator_free(&tr);
+    return NULL;
+}
+
+static double elapsed(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/*
+ * Linha "x = 0 + 1 - 2 * v1 - 3 + 4 * v3 + 5 ..." com n termos: mais de n
+ * instruções, muito além do antigo limite de 100. Cada termo tem uma
+ * constante diferente (i + 1) e os termos com variável usam nomes
+ * diferentes (v1, v3, ...), então as tabelas de nomes e de constantes
+ * crescem com a linha. As variáveis valem 0 e os sinais se alternam, então
+ * o resultado esperado só depende das constantes e não estoura.
+ */
+static char* generate_line(int n, int* expected) {
+    size_t size = (size_t)n * 32 + 16;
+    char* line = malloc(size);
+    size_t length = (size_t)sprintf(line, "x = 0");
+    *expected = 0;
+    for (int i = 0; i < n; i++) {
+        int value = i + 1;
+        switch (i % 4) {
+            case 0:
+                length += sprintf(line + length, " + %d", value);
+                *expected += value;
+                break;
+            case 2:
+                length += sprintf(line + length, " - %d", value);
+                *expected -= value;
+                break;
+            default:
+                length += sprintf(line + length, " %c %d * v%d", i % 4 == 1 ? '-' : '+', value, i);
+                break;
+        }
+    }
+    strcpy(line + length, ";");
+    return line;
+}
+
+void run_benchmark(int n, int threads) {
+    int expected = 0;
+    char* line = generate_line(n, &expected);
+
+    printf("Linha com %d termos (%zu KB)\n\n", n, strlen(line) / 1024);
+    printf("%8s %16s %12s %10s\n", "threads", "instruções", "segundos", "resultado");   // ç e õ: 2 bytes
+    for (int t = 1; t <= threads; t *= 2) {
+        TranslationJob* jobs = calloc(t, sizeof(TranslationJob));
+        pthread_t* ids = malloc(t * sizeof(pthread_t));
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int k = 0; k < t; k++) {
+            jobs[k].line = line;
+            pthread_create(&ids[k], NULL, translation_worker, &jobs[k]);
+        }
+        for (int k = 0; k < t; k++) pthread_join(ids[k], NULL);
+        double seconds = elapsed(&start);
+
+        int same = 1;
+        for (int k = 0; k < t; k++) {
+            same &= jobs[k].ok && jobs[k].value == expected &&
+                    jobs[k].instructions == jobs[0].instructions;
+        }
+        printf("%8d %14d %12.3f %10s\n", t, jobs[0].instructions, seconds,
+               same ? "iguais" : "DIFERENTES");
+        if (t == 1) {
+            printf("         (buffer com %d posições depois de %d instruções)\n",
+                   jobs[0].capacity, jobs[0].instructions);
+        }
+        free(ids);
+        free(jobs);
+    }
+    free(line);
 }
 
 // ========== FUNÇÃO PRINCIPAL ==========
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        int n = argc > 2 ? atoi(argv[2]) : 200000;
+        int threads = argc > 3 ? atoi(argv[3]) : 4;
+        if (n < 1 || threads < 1) {
+            printf("Uso: %s --benchmark [N] [threads]\n", argv[0]);
+            return 1;
+        }
+        run_benchmark(n, threads);
+        return 0;
+    }
+
     printf("╔════════════════════════════════════════════╗\n");
     printf("║  GERADOR DE CÓDIGO COM SDT                 ║\n");
     printf("╚════════════════════════════════════════════╝\n\n");
@@ -355,13 +755,17 @@ int main() {
     printf("  • y = 10 + 20 * 30;\n");
     printf("\nDigite 'sair' ou Ctrl+D para encerrar.\n\n");
     
-    char line[256];
+    // As linhas podem ter qualquer tamanho: getline aumenta o buffer
+    char* line = NULL;
+    size_t line_capacity = 0;
+    Translator tr;
+    translator_init(&tr);
     
     while (1) {
         printf(">>> ");
         fflush(stdout);
         
-        if (!fgets(line, sizeof(line), stdin)) {
+        if (getline(&line, &line_capacity, stdin) < 0) {
             break;  // EOF
         }
         
@@ -378,20 +782,24 @@ int main() {
             continue;
         }
         
-        // Reset
-        code_count = 0;
-        temp_count = 0;
-        input = line;
-        pos = 0;
-        advance();  // Carregar primeiro token
-        
         // Traduzir atribuição
-        parse_assignment();
+        if (!translate(&tr, line)) {
+            fprintf(stderr, "%s\n", tr.error);
+            continue;
+        }
         
         // Imprimir código gerado
-        print_code();
+        print_code(&tr);
+        
+        // Executar: o último resultado é a variável atribuída
+        if (run_code(&tr, 1)) {
+            int target = OPERAND_INDEX(tr.code[tr.code_count - 1].result);
+            printf("Execução: %s = %d\n\n", tr.var_names[target], tr.var_values[target]);
+        }
     }
     
+    translator_free(&tr);
+    free(line);
     printf("Encerrando gerador de código.\n");
     return 0;
 }
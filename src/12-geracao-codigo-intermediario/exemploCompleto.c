@@ -1,10 +1,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <time.h>
 
 /*
  * Exemplo Completo de Geração de Código Intermediário
- * Inclui: expressões, comandos de controle e otimizações básicas
+ * Inclui: expressões, comandos de controle, otimizações básicas e uma
+ * máquina virtual de registradores que executa o TAC gerado
+ *
+ * Compilação: gcc exemploCompleto.c -o exemploCompleto -std=c99 -O2
+ * Uso:
+ *   ./exemploCompleto                    exemplos (geração e execução)
+ *   ./exemploCompleto --benchmark [N]    laços em TAC sem e com superinstruções
  */
 
 // ========== FUNÇÕES AUXILIARES ==========
@@ -16,6 +24,17 @@ char* my_strdup(const char* s) {
     return copy;
 }
 
+// Dobra a capacidade do vetor (mínimo 16) e devolve o novo endereço
+static void* grow_array(void* array, int* capacity, size_t element_size) {
+    *capacity = *capacity ? *capacity * 2 : 16;
+    array = realloc(array, (size_t)*capacity * element_size);
+    if (!array) {
+        fprintf(stderr, "Erro: falha ao alocar memória\n");
+        exit(1);
+    }
+    return array;
+}
+
 // ========== TIPOS ==========
 
 typedef enum {
@@ -25,14 +44,70 @@ typedef enum {
     TAC_IF_LE, TAC_IF_GE, TAC_IF_NE
 } TACOp;
 
-typedef struct TACInstr {
-    TACOp op;
-    char* result;
-    char* arg1;
-    char* arg2;
-    struct TACInstr* next;
+#define TAC_OP_COUNT (TAC_IF_NE + 1)
+
+/*
+ * Operandos do TAC
+ *
+ * Um operando é um inteiro de 32 bits: o tipo nos 3 bits de baixo e um
+ * índice no resto. Temporários e rótulos são só números (t3 é o
+ * temporário 3), então criar um não aloca nada. Variáveis e constantes
+ * são índices nas tabelas de nomes e de valores do código, e cada nome ou
+ * valor distinto aparece uma vez.
+ */
+typedef uint32_t Operand;
+
+typedef enum {
+    OPND_NONE,
+    OPND_TEMP,
+    OPND_VAR,
+    OPND_CONST,
+    OPND_LABEL
+} OperandKind;
+
+#define OPERAND(kind, index) ((Operand)(((uint32_t)(index) << 3) | (uint32_t)(kind)))
+#define OPERAND_KIND(operand) ((OperandKind)((operand) & 7u))
+#define OPERAND_INDEX(operand) ((int)((operand) >> 3))
+#define NO_OPERAND OPERAND(OPND_NONE, 0)
+
+// Instrução de 16 bytes: nos desvios, result é o rótulo de destino
+typedef struct {
+    uint32_t op;        // TACOp
+    Operand result;
+    Operand arg1;
+    Operand arg2;
 } TACInstr;
 
+/*
+ * Código de três endereços: as instruções em um vetor contíguo, na ordem
+ * de emissão, e as tabelas laterais. Os nomes das variáveis ficam juntos
+ * em um único buffer de texto; names guarda o deslocamento de cada um.
+ * Variáveis e constantes são internadas por hash aberto (sondagem
+ * linear), então o mesmo nome ou valor dá sempre o mesmo operando.
+ */
+typedef struct {
+    TACInstr* code;
+    int count;
+    int capacity;
+
+    int* names;             // deslocamento do nome de cada variável em text
+    int var_count;
+    int var_capacity;
+    char* text;
+    int text_size;
+    int text_capacity;
+
+    int* constants;         // valor de cada constante
+    int const_count;
+    int const_capacity;
+
+    int* slots;             // hash: var + 1, -(const + 1) ou 0 (vazio)
+    int slot_capacity;      // potência de 2
+
+    int temp_count;
+    int label_count;
+} TACCode;
+
 typedef enum {
     NODE_NUMBER, NODE_IDENTIFIER, NODE_BINARY_OP
 } NodeType;
@@ -42,42 +117,132 @@ typedef struct ASTNode {
     char* value;
     struct ASTNode* left;
     struct ASTNode* right;
+    int is_constant;        // anotados por evaluate_constants
+    int const_value;
 } ASTNode;
 
 // ========== VARIÁVEIS GLOBAIS ==========
 
-TACInstr* tac_head = NULL;
-TACInstr* tac_tail = NULL;
-int temp_count = 0;
-int label_count = 0;
+TACCode tac;
 
 // ========== FUNÇÕES AUXILIARES ==========
 
-char* new_temp() {
-    char* temp = malloc(10);
-    sprintf(temp, "t%d", temp_count++);
-    return temp;
+const char* var_name(int var) {
+    return tac.text + tac.names[var];
+}
+
+static unsigned int hash_text(const char* text) {
+    unsigned int hash = 2166136261u;    // FNV-1a
+    while (*text) {
+        hash ^= (unsigned char)*text++;
+        hash *= 16777619u;
+    }
+    return hash;
 }
 
-char* new_label() {
-    char* label = malloc(10);
-    sprintf(label, "L%d", label_count++);
-    return label;
+static unsigned int hash_value(int value) {
+    unsigned int hash = (unsigned int)value * 2654435761u;
+    return hash ^ (hash >> 16);
 }
 
-void emit(TACOp op, char* result, char* arg1, char* arg2) {
-    TACInstr* instr = malloc(sizeof(TACInstr));
+// Dobra o hash e reinsere as variáveis e constantes
+static void grow_slots(void) {
+    free(tac.slots);
+    tac.slot_capacity = tac.slot_capacity ? tac.slot_capacity * 2 : 64;
+    tac.slots = calloc(tac.slot_capacity, sizeof(int));
+    unsigned int mask = (unsigned int)tac.slot_capacity - 1;
+    for (int v = 0; v < tac.var_count; v++) {
+        unsigned int i = hash_text(var_name(v)) & mask;
+        while (tac.slots[i]) i = (i + 1) & mask;
+        tac.slots[i] = v + 1;
+    }
+    for (int c = 0; c < tac.const_count; c++) {
+        unsigned int i = hash_value(tac.constants[c]) & mask;
+        while (tac.slots[i]) i = (i + 1) & mask;
+        tac.slots[i] = -(c + 1);
+    }
+}
+
+// Operando da variável; o nome é copiado na primeira ocorrência
+Operand tac_var(const char* name) {
+    if (2 * (tac.var_count + tac.const_count + 1) > tac.slot_capacity) grow_slots();
+    unsigned int mask = (unsigned int)tac.slot_capacity - 1;
+    unsigned int i = hash_text(name) & mask;
+    for (; tac.slots[i]; i = (i + 1) & mask) {
+        int var = tac.slots[i] - 1;
+        if (var >= 0 && strcmp(var_name(var), name) == 0) return OPERAND(OPND_VAR, var);
+    }
+
+    int length = (int)strlen(name) + 1;
+    while (tac.text_size + length > tac.text_capacity) {
+        tac.text = grow_array(tac.text, &tac.text_capacity, 1);
+    }
+    memcpy(tac.text + tac.text_size, name, length);
+    if (tac.var_count == tac.var_capacity) {
+        tac.names = grow_array(tac.names, &tac.var_capacity, sizeof(int));
+    }
+    tac.names[tac.var_count] = tac.text_size;
+    tac.text_size += length;
+    tac.slots[i] = tac.var_count + 1;
+    return OPERAND(OPND_VAR, tac.var_count++);
+}
+
+// Operando da constante inteira
+Operand tac_const(int value) {
+    if (2 * (tac.var_count + tac.const_count + 1) > tac.slot_capacity) grow_slots();
+    unsigned int mask = (unsigned int)tac.slot_capacity - 1;
+    unsigned int i = hash_value(value) & mask;
+    for (; tac.slots[i]; i = (i + 1) & mask) {
+        int c = -tac.slots[i] - 1;
+        if (c >= 0 && tac.constants[c] == value) return OPERAND(OPND_CONST, c);
+    }
+
+    if (tac.const_count == tac.const_capacity) {
+        tac.constants = grow_array(tac.constants, &tac.const_capacity, sizeof(int));
+    }
+    tac.constants[tac.const_count] = value;
+    tac.slots[i] = -(tac.const_count + 1);
+    return OPERAND(OPND_CONST, tac.const_count++);
+}
+
+Operand new_temp() {
+    return OPERAND(OPND_TEMP, tac.temp_count++);
+}
+
+Operand new_label() {
+    return OPERAND(OPND_LABEL, tac.label_count++);
+}
+
+void emit(TACOp op, Operand result, Operand arg1, Operand arg2) {
+    if (tac.count == tac.capacity) {
+        tac.code = grow_array(tac.code, &tac.capacity, sizeof(TACInstr));
+    }
+    TACInstr* instr = &tac.code[tac.count++];
     instr->op = op;
     instr->result = result;
     instr->arg1 = arg1;
     instr->arg2 = arg2;
-    instr->next = NULL;
-    
-    if (tac_tail == NULL) {
-        tac_head = tac_tail = instr;
-    } else {
-        tac_tail->next = instr;
-        tac_tail = instr;
+}
+
+// Esvazia o código e as tabelas para uma nova tradução (a memória é reaproveitada)
+void tac_reset() {
+    tac.count = 0;
+    tac.var_count = 0;
+    tac.text_size = 0;
+    tac.const_count = 0;
+    tac.temp_count = 0;
+    tac.label_count = 0;
+    if (tac.slots) memset(tac.slots, 0, tac.slot_capacity * sizeof(int));
+}
+
+// Texto do operando: "t3", "L1", o nome da variável ou o valor
+const char* operand_text(Operand operand, char* buffer) {
+    switch (OPERAND_KIND(operand)) {
+        case OPND_TEMP:  sprintf(buffer, "t%d", OPERAND_INDEX(operand)); return buffer;
+        case OPND_LABEL: sprintf(buffer, "L%d", OPERAND_INDEX(operand)); return buffer;
+        case OPND_CONST: sprintf(buffer, "%d", tac.constants[OPERAND_INDEX(operand)]); return buffer;
+        case OPND_VAR:   return var_name(OPERAND_INDEX(operand));
+        default:         return "";
     }
 }
 
@@ -103,29 +268,24 @@ const char* tac_op_name(TACOp op) {
 void print_tac() {
     printf("\n=== CÓDIGO DE TRÊS ENDEREÇOS ===\n");
     
-    TACInstr* instr = tac_head;
-    while (instr) {
+    char r[16], a[16], b[16];
+    for (int i = 0; i < tac.count; i++) {
+        const TACInstr* instr = &tac.code[i];
+        const char* result = operand_text(instr->result, r);
+        const char* arg1 = operand_text(instr->arg1, a);
+        const char* arg2 = operand_text(instr->arg2, b);
+
         if (instr->op == TAC_LABEL) {
-            printf("%s:\n", instr->result);
+            printf("%s:\n", result);
         } else if (instr->op == TAC_GOTO) {
-            printf("  goto %s\n", instr->result);
+            printf("  goto %s\n", result);
         } else if (instr->op >= TAC_IF_LT && instr->op <= TAC_IF_NE) {
-            printf("  if %s %s %s goto %s\n",
-                   instr->arg1,
-                   tac_op_name(instr->op),
-                   instr->arg2,
-                   instr->result);
+            printf("  if %s %s %s goto %s\n", arg1, tac_op_name(instr->op), arg2, result);
         } else if (instr->op == TAC_COPY) {
-            printf("  %s = %s\n", instr->result, instr->arg1);
+            printf("  %s = %s\n", result, arg1);
         } else {
-            printf("  %s = %s %s %s\n",
-                   instr->result,
-                   instr->arg1,
-                   tac_op_name(instr->op),
-                   instr->arg2);
+            printf("  %s = %s %s %s\n", result, arg1, tac_op_name(instr->op), arg2);
         }
-        
-        instr = instr->next;
     }
 }
 
@@ -137,6 +297,8 @@ ASTNode* create_node(NodeType type, char* value) {
     node->value = value ? my_strdup(value) : NULL;
     node->left = NULL;
     node->right = NULL;
+    node->is_constant = 0;
+    node->const_value = 0;
     return node;
 }
 
@@ -156,16 +318,13 @@ ASTNode* create_binary_op(char* op, ASTNode* left, ASTNode* right) {
 // ========== TRADUÇÃO DE EXPRESSÕES ==========
 
 typedef struct {
-    char* place;
+    Operand place;
 } ExprResult;
 
-ExprResult* translate_expression(ASTNode* node);
+ExprResult translate_expression(ASTNode* node);
 
-ExprResult* translate_binary_op(ASTNode* node) {
-    ExprResult* left = translate_expression(node->left);
-    ExprResult* right = translate_expression(node->right);
-    
-    char* temp = new_temp();
+ExprResult emit_binary_op(ASTNode* node, ExprResult left, ExprResult right) {
+    Operand temp = new_temp();
     
     TACOp op;
     switch (node->value[0]) {
@@ -178,23 +337,34 @@ ExprResult* translate_binary_op(ASTNode* node) {
             exit(1);
     }
     
-    emit(op, temp, left->place, right->place);
+    emit(op, temp, left.place, right.place);
     
-    ExprResult* result = malloc(sizeof(ExprResult));
-    result->place = temp;
+    ExprResult result = {temp};
     return result;
 }
 
-ExprResult* translate_expression(ASTNode* node) {
-    ExprResult* result = malloc(sizeof(ExprResult));
+ExprResult translate_binary_op(ASTNode* node) {
+    ExprResult left = translate_expression(node->left);
+    ExprResult right = translate_expression(node->right);
+    return emit_binary_op(node, left, right);
+}
+
+ExprResult translate_expression(ASTNode* node) {
+    ExprResult result;
+    
+    // Valor já calculado na compilação: a constante é o endereço
+    if (node->is_constant) {
+        result.place = tac_const(node->const_value);
+        return result;
+    }
     
     switch (node->type) {
         case NODE_NUMBER:
-            result->place = my_strdup(node->value);
+            result.place = tac_const(atoi(node->value));
             break;
             
         case NODE_IDENTIFIER:
-            result->place = my_strdup(node->value);
+            result.place = tac_var(node->value);
             break;
             
         case NODE_BINARY_OP:
@@ -210,47 +380,62 @@ ExprResult* translate_expression(ASTNode* node) {
 
 // ========== OTIMIZAÇÕES ==========
 
-int is_constant(char* place) {
-    if (!place) return 0;
-    int i = (place[0] == '-') ? 1 : 0;
-    while (place[i]) {
-        if (place[i] < '0' || place[i] > '9') return 0;
-        i++;
-    }
-    return place[0] != '\0';
-}
-
-ExprResult* optimize_constant_folding(ASTNode* node) {
-    if (node->type == NODE_BINARY_OP) {
-        ExprResult* left = translate_expression(node->left);
-        ExprResult* right = translate_expression(node->right);
-        
-        if (is_constant(left->place) && is_constant(right->place)) {
-            int val1 = atoi(left->place);
-            int val2 = atoi(right->place);
-            int result_val;
-            
-            switch (node->value[0]) {
-                case '+': result_val = val1 + val2; break;
-                case '-': result_val = val1 - val2; break;
-                case '*': result_val = val1 * val2; break;
-                case '/':
-                    if (val2 != 0) result_val = val1 / val2;
-                    else return translate_expression(node);
-                    break;
-                default: return translate_expression(node);
-            }
-            
-            printf("  [Otimização: %d %s %d = %d]\n",
-                   val1, node->value, val2, result_val);
-            
-            ExprResult* result = malloc(sizeof(ExprResult));
-            result->place = malloc(20);
-            sprintf(result->place, "%d", result_val);
-            return result;
-        }
+/*
+ * Aritmética inteira com volta no estouro (complemento de dois), usada
+ * tanto na avaliação de constantes quanto na VM, para que o valor dobrado
+ * e o executado sejam sempre o mesmo. Em int com sinal o estouro seria
+ * comportamento indefinido. wrap_div exige b != 0.
+ */
+static int wrap_add(int a, int b) { return (int)((unsigned int)a + (unsigned int)b); }
+static int wrap_sub(int a, int b) { return (int)((unsigned int)a - (unsigned int)b); }
+static int wrap_mul(int a, int b) { return (int)((unsigned int)a * (unsigned int)b); }
+static int wrap_div(int a, int b) { return b == -1 ? (int)(0u - (unsigned int)a) : a / b; }
+
+/*
+ * Avaliação de constantes: anota, de baixo para cima, os nós cujo valor é
+ * conhecido na compilação (números e operações entre constantes). A
+ * tradução lê a anotação e usa o valor como endereço, então uma operação
+ * dobrada nunca chega a emit. Divisão por zero não é avaliada e fica para
+ * a execução; a aritmética dá a volta no estouro (wrap_*), como na VM.
+ */
+int evaluate_constants(ASTNode* node, int verbose) {
+    if (node->type == NODE_NUMBER) {
+        node->is_constant = 1;
+        node->const_value = atoi(node->value);
+        return 1;
     }
-    
+    if (node->type != NODE_BINARY_OP) return 0;
+
+    // Os dois lados são sempre visitados, para anotar as subárvores
+    int left = evaluate_constants(node->left, verbose);
+    int right = evaluate_constants(node->right, verbose);
+    if (!left || !right) return 0;
+
+    int a = node->left->const_value;
+    int b = node->right->const_value;
+    int value;
+    switch (node->value[0]) {
+        case '+': value = wrap_add(a, b); break;
+        case '-': value = wrap_sub(a, b); break;
+        case '*': value = wrap_mul(a, b); break;
+        case '/':
+            if (b == 0) return 0;
+            value = wrap_div(a, b);
+            break;
+        default: return 0;
+    }
+
+    if (verbose) {
+        printf("  [Otimização: %d %s %d = %d]\n", a, node->value, b, value);
+    }
+    node->is_constant = 1;
+    node->const_value = value;
+    return 1;
+}
+
+// Traduz a expressão depois de anotar as constantes
+ExprResult optimize_constant_folding(ASTNode* node) {
+    evaluate_constants(node, 1);
     return translate_expression(node);
 }
 
@@ -265,18 +450,18 @@ ExprResult* optimize_constant_folding(ASTNode* node) {
  * valores de comparação viriam da expressão condicional.
  */
 void generate_if_then(ASTNode* cond, ASTNode* then_body) {
-    char* L_then = new_label();
-    char* L_end = new_label();
+    Operand L_then = new_label();
+    Operand L_end = new_label();
     
-    ExprResult* cond_result = translate_expression(cond);
-    emit(TAC_IF_GT, L_then, cond_result->place, "0");
-    emit(TAC_GOTO, L_end, NULL, NULL);
+    ExprResult cond_result = translate_expression(cond);
+    emit(TAC_IF_GT, L_then, cond_result.place, tac_const(0));
+    emit(TAC_GOTO, L_end, NO_OPERAND, NO_OPERAND);
     
-    emit(TAC_LABEL, L_then, NULL, NULL);
-    ExprResult* then_result = translate_expression(then_body);
-    emit(TAC_COPY, "x", then_result->place, NULL);
+    emit(TAC_LABEL, L_then, NO_OPERAND, NO_OPERAND);
+    ExprResult then_result = translate_expression(then_body);
+    emit(TAC_COPY, tac_var("x"), then_result.place, NO_OPERAND);
     
-    emit(TAC_LABEL, L_end, NULL, NULL);
+    emit(TAC_LABEL, L_end, NO_OPERAND, NO_OPERAND);
 }
 
 /*
@@ -288,22 +473,484 @@ void generate_if_then(ASTNode* cond, ASTNode* then_body) {
  * valores de comparação viriam da expressão condicional.
  */
 void generate_while_loop(ASTNode* cond, ASTNode* body) {
-    char* L_start = new_label();
-    char* L_body = new_label();
-    char* L_end = new_label();
+    Operand L_start = new_label();
+    Operand L_body = new_label();
+    Operand L_end = new_label();
     
-    emit(TAC_LABEL, L_start, NULL, NULL);
+    emit(TAC_LABEL, L_start, NO_OPERAND, NO_OPERAND);
     
-    ExprResult* cond_result = translate_expression(cond);
-    emit(TAC_IF_LE, L_body, cond_result->place, "10");
-    emit(TAC_GOTO, L_end, NULL, NULL);
+    ExprResult cond_result = translate_expression(cond);
+    emit(TAC_IF_LE, L_body, cond_result.place, tac_const(10));
+    emit(TAC_GOTO, L_end, NO_OPERAND, NO_OPERAND);
     
-    emit(TAC_LABEL, L_body, NULL, NULL);
-    ExprResult* body_result = translate_expression(body);
-    emit(TAC_COPY, "i", body_result->place, NULL);
-    emit(TAC_GOTO, L_start, NULL, NULL);
+    emit(TAC_LABEL, L_body, NO_OPERAND, NO_OPERAND);
+    ExprResult body_result = translate_expression(body);
+    emit(TAC_COPY, tac_var("i"), body_result.place, NO_OPERAND);
+    emit(TAC_GOTO, L_start, NO_OPERAND, NO_OPERAND);
     
-    emit(TAC_LABEL, L_end, NULL, NULL);
+    emit(TAC_LABEL, L_end, NO_OPERAND, NO_OPERAND);
+}
+
+// ========== MÁQUINA VIRTUAL DE REGISTRADORES ==========
+
+/*
+ * Executa o TAC diretamente. A carga (tac_load) transforma o código em um
+ * vetor de instruções da VM:
+ *   - cada variável, temporário e constante ganha um registrador no banco
+ *     de registradores, nessa ordem; o registrador sai do próprio operando
+ *     (início da faixa do tipo + índice), sem procurar nomes. Constantes
+ *     começam com o seu valor, e a VM não distingue os casos;
+ *   - os rótulos saem do código: goto e if guardam o índice da instrução
+ *     de destino.
+ */
+
+/*
+ * Opcodes da VM: os de TACOp e as superinstruções formadas por tac_fuse,
+ * que executam em um único despacho uma sequência frequente de TAC.
+ */
+typedef enum {
+    SI_IF_LT_ELSE = TAC_OP_COUNT,   // if a cc b goto dst; goto c
+    SI_IF_GT_ELSE,
+    SI_IF_EQ_ELSE,
+    SI_IF_LE_ELSE,
+    SI_IF_GE_ELSE,
+    SI_IF_NE_ELSE,
+    SI_ADD_COPY,                    // t = a op b; dst = t   (t sem outro uso)
+    SI_SUB_COPY,
+    SI_MUL_COPY,
+    SI_COPY_GOTO,                   // dst = a; goto c
+    SI_ADD_COPY_GOTO,               // t = a + b; dst = t; goto c
+    VM_OP_COUNT
+} VMOp;
+
+typedef struct {
+    int op;     // TACOp ou VMOp
+    int dst;    // registrador de destino ou, nos desvios, índice da instrução alvo
+    int a;
+    int b;
+    int c;      // alvo do segundo desvio nas superinstruções
+} VMInstr;
+
+typedef struct {
+    VMInstr* code;
+    int count;
+    int* registers;
+    char** names;               // nome (ou texto da constante) de cada registrador
+    int register_count;
+    int first_temp;             // variáveis em [0, first_temp), temporários
+    int first_const;            // em [first_temp, first_const), depois as constantes
+    long executed;              // instruções executadas pela última tac_run
+    long op_counts[VM_OP_COUNT];
+    long* profile;              // execuções por instrução (NULL = sem perfil)
+} TACProgram;
+
+typedef enum {
+    VM_OK,
+    VM_DIVISAO_POR_ZERO,
+    VM_LIMITE_DE_PASSOS
+} VMStatus;
+
+static int register_of(const TACProgram* prog, Operand operand) {
+    switch (OPERAND_KIND(operand)) {
+        case OPND_VAR:   return OPERAND_INDEX(operand);
+        case OPND_TEMP:  return prog->first_temp + OPERAND_INDEX(operand);
+        case OPND_CONST: return prog->first_const + OPERAND_INDEX(operand);
+        default:         return 0;
+    }
+}
+
+/*
+ * Converte o TAC em código da VM. Devolve NULL (com mensagem) se algum
+ * desvio usa um rótulo que não foi definido.
+ */
+TACProgram* tac_load(const TACCode* input) {
+    TACProgram* prog = calloc(1, sizeof(TACProgram));
+    prog->first_temp = input->var_count;
+    prog->first_const = input->var_count + input->temp_count;
+    prog->register_count = prog->first_const + input->const_count;
+
+    // 1ª passada: posição de cada rótulo no código sem rótulos
+    int* label_targets = malloc((input->label_count + 1) * sizeof(int));
+    for (int l = 0; l < input->label_count; l++) label_targets[l] = -1;
+    int count = 0;
+    for (int i = 0; i < input->count; i++) {
+        if (input->code[i].op == TAC_LABEL) label_targets[OPERAND_INDEX(input->code[i].result)] = count;
+        else count++;
+    }
+
+    // 2ª passada: operandos viram registradores e rótulos viram índices
+    prog->code = malloc((count + 1) * sizeof(VMInstr));
+    for (int i = 0; i < input->count; i++) {
+        const TACInstr* instr = &input->code[i];
+        if (instr->op == TAC_LABEL) continue;
+        VMInstr* out = &prog->code[prog->count++];
+        out->op = instr->op;
+        out->a = out->b = out->c = 0;
+
+        if (instr->op == TAC_GOTO || (instr->op >= TAC_IF_LT && instr->op <= TAC_IF_NE)) {
+            out->dst = label_targets[OPERAND_INDEX(instr->result)];
+            if (out->dst < 0) {
+                fprintf(stderr, "Erro: rótulo 'L%d' não definido\n", OPERAND_INDEX(instr->result));
+                free(label_targets);
+                free(prog->code);
+                free(prog);
+                return NULL;
+            }
+        } else {
+            out->dst = register_of(prog, instr->result);
+        }
+        if (instr->op != TAC_GOTO) out->a = register_of(prog, instr->arg1);
+        if (instr->op != TAC_GOTO && instr->op != TAC_COPY) out->b = register_of(prog, instr->arg2);
+    }
+    free(label_targets);
+
+    // Variáveis e temporários começam em 0; constantes recebem o seu valor
+    prog->registers = calloc(prog->register_count + 1, sizeof(int));
+    prog->names = malloc((prog->register_count + 1) * sizeof(char*));
+    for (int v = 0; v < input->var_count; v++) {
+        prog->names[v] = my_strdup(input->text + input->names[v]);
+    }
+    for (int t = 0; t < input->temp_count; t++) {
+        prog->names[prog->first_temp + t] = malloc(16);
+        sprintf(prog->names[prog->first_temp + t], "t%d", t);
+    }
+    for (int c = 0; c < input->const_count; c++) {
+        prog->registers[prog->first_const + c] = input->constants[c];
+        prog->names[prog->first_const + c] = malloc(16);
+        sprintf(prog->names[prog->first_const + c], "%d", input->constants[c]);
+    }
+    return prog;
+}
+
+void tac_free(TACProgram* prog) {
+    if (!prog) return;
+    for (int i = 0; i < prog->register_count; i++) free(prog->names[i]);
+    free(prog->names);
+    free(prog->registers);
+    free(prog->code);
+    free(prog);
+}
+
+// Atribui um valor inicial à variável; devolve 0 se o programa não a usa
+int tac_set(TACProgram* prog, const char* name, int value) {
+    for (int i = 0; i < prog->first_temp; i++) {
+        if (strcmp(prog->names[i], name) == 0) {
+            prog->registers[i] = value;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int tac_get(const TACProgram* prog, const char* name, int* value) {
+    for (int i = 0; i < prog->first_temp; i++) {
+        if (strcmp(prog->names[i], name) == 0) {
+            *value = prog->registers[i];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Executa o programa a partir da primeira instrução até sair do fim do
+ * código. max_steps limita o número de instruções (laços infinitos).
+ * Em prog->executed e prog->op_counts ficam as contagens da execução.
+ */
+VMStatus tac_run(TACProgram* prog, long max_steps) {
+    const VMInstr* code = prog->code;
+    int* r = prog->registers;
+    int pc = 0;
+    long executed = 0;
+    VMStatus status = VM_OK;
+
+    memset(prog->op_counts, 0, sizeof(prog->op_counts));
+    while (pc < prog->count) {
+        if (executed == max_steps) {
+            status = VM_LIMITE_DE_PASSOS;
+            break;
+        }
+        if (prog->profile) prog->profile[pc]++;
+        const VMInstr* in = &code[pc++];
+        executed++;
+        prog->op_counts[in->op]++;
+
+        switch (in->op) {
+            case TAC_ADD:  r[in->dst] = wrap_add(r[in->a], r[in->b]); break;
+            case TAC_SUB:  r[in->dst] = wrap_sub(r[in->a], r[in->b]); break;
+            case TAC_MUL:  r[in->dst] = wrap_mul(r[in->a], r[in->b]); break;
+            case TAC_DIV:
+                if (r[in->b] == 0) {
+                    status = VM_DIVISAO_POR_ZERO;
+                    pc = prog->count;
+                    break;
+                }
+                r[in->dst] = wrap_div(r[in->a], r[in->b]);
+                break;
+            case TAC_COPY: r[in->dst] = r[in->a]; break;
+            case TAC_GOTO: pc = in->dst; break;
+            case TAC_IF_LT: if (r[in->a] <  r[in->b]) pc = in->dst; break;
+            case TAC_IF_GT: if (r[in->a] >  r[in->b]) pc = in->dst; break;
+            case TAC_IF_EQ: if (r[in->a] == r[in->b]) pc = in->dst; break;
+            case TAC_IF_LE: if (r[in->a] <= r[in->b]) pc = in->dst; break;
+            case TAC_IF_GE: if (r[in->a] >= r[in->b]) pc = in->dst; break;
+            case TAC_IF_NE: if (r[in->a] != r[in->b]) pc = in->dst; break;
+            case TAC_LABEL: break;      // removidos na carga
+
+            case SI_IF_LT_ELSE: pc = r[in->a] <  r[in->b] ? in->dst : in->c; break;
+            case SI_IF_GT_ELSE: pc = r[in->a] >  r[in->b] ? in->dst : in->c; break;
+            case SI_IF_EQ_ELSE: pc = r[in->a] == r[in->b] ? in->dst : in->c; break;
+            case SI_IF_LE_ELSE: pc = r[in->a] <= r[in->b] ? in->dst : in->c; break;
+            case SI_IF_GE_ELSE: pc = r[in->a] >= r[in->b] ? in->dst : in->c; break;
+            case SI_IF_NE_ELSE: pc = r[in->a] != r[in->b] ? in->dst : in->c; break;
+            case SI_ADD_COPY: r[in->dst] = wrap_add(r[in->a], r[in->b]); break;
+            case SI_SUB_COPY: r[in->dst] = wrap_sub(r[in->a], r[in->b]); break;
+            case SI_MUL_COPY: r[in->dst] = wrap_mul(r[in->a], r[in->b]); break;
+            case SI_COPY_GOTO: r[in->dst] = r[in->a]; pc = in->c; break;
+            case SI_ADD_COPY_GOTO: r[in->dst] = wrap_add(r[in->a], r[in->b]); pc = in->c; break;
+        }
+    }
+
+    prog->executed = executed;
+    return status;
+}
+
+int is_temporary(const TACProgram* prog, int reg) {
+    return reg >= prog->first_temp && reg < prog->first_const;
+}
+
+// Mostra o resultado de tac_run e as variáveis (temporários e constantes omitidos)
+void tac_print_state(const TACProgram* prog, VMStatus status) {
+    printf("\nExecução: %ld instruções", prog->executed);
+    if (status == VM_DIVISAO_POR_ZERO) printf(" (interrompida: divisão por zero)");
+    if (status == VM_LIMITE_DE_PASSOS) printf(" (interrompida: limite de passos)");
+    printf("\n ");
+    for (int i = 0; i < prog->first_temp; i++) {
+        printf(" %s = %d", prog->names[i], prog->registers[i]);
+    }
+    printf("\n");
+}
+
+// Carrega o TAC atual, atribui os valores iniciais, executa e mostra o estado
+void run_current_tac(const char* const* names, const int* values, int count) {
+    TACProgram* prog = tac_load(&tac);
+    if (!prog) return;
+    for (int i = 0; i < count; i++) tac_set(prog, names[i], values[i]);
+    VMStatus status = tac_run(prog, 1000000);
+    tac_print_state(prog, status);
+    tac_free(prog);
+}
+
+// ========== SUPERINSTRUÇÕES ==========
+
+/*
+ * O gerador emite sempre as mesmas sequências: "if a < b goto L1" seguido
+ * de "goto L2" em cada condição, e "t = a + b; x = t; goto L0" no fim de
+ * cada laço. Cada instrução paga um despacho (busca, switch, desvio
+ * indireto). tac_fuse troca essas sequências por uma superinstrução que faz
+ * o mesmo trabalho em um só despacho.
+ *
+ * A escolha é dirigida por um perfil: tac_profile executa o programa
+ * contando as execuções de cada instrução. Para cada padrão, os despachos
+ * evitados em um ponto do código são as execuções das instruções que
+ * deixam de existir; só os padrões que evitam pelo menos min_share dos
+ * despachos do perfil são aplicados.
+ *
+ * Uma sequência só é fundida se nenhuma instrução depois da primeira é
+ * alvo de desvio e, nos padrões "t = a op b; x = t", se t é um temporário
+ * lido apenas por essa cópia (a superinstrução não escreve t).
+ */
+
+typedef struct {
+    int length;
+    TACOp ops[3];
+    VMOp fused;
+    const char* name;
+} FusionPattern;
+
+// Trios antes de pares: em cada posição vale o padrão mais longo
+static const FusionPattern fusion_patterns[] = {
+    {3, {TAC_ADD, TAC_COPY, TAC_GOTO}, SI_ADD_COPY_GOTO, "t = a + b; x = t; goto"},
+    {2, {TAC_IF_LT, TAC_GOTO}, SI_IF_LT_ELSE, "if a < b goto; goto"},
+    {2, {TAC_IF_GT, TAC_GOTO}, SI_IF_GT_ELSE, "if a > b goto; goto"},
+    {2, {TAC_IF_EQ, TAC_GOTO}, SI_IF_EQ_ELSE, "if a == b goto; goto"},
+    {2, {TAC_IF_LE, TAC_GOTO}, SI_IF_LE_ELSE, "if a <= b goto; goto"},
+    {2, {TAC_IF_GE, TAC_GOTO}, SI_IF_GE_ELSE, "if a >= b goto; goto"},
+    {2, {TAC_IF_NE, TAC_GOTO}, SI_IF_NE_ELSE, "if a != b goto; goto"},
+    {2, {TAC_ADD, TAC_COPY}, SI_ADD_COPY, "t = a + b; x = t"},
+    {2, {TAC_SUB, TAC_COPY}, SI_SUB_COPY, "t = a - b; x = t"},
+    {2, {TAC_MUL, TAC_COPY}, SI_MUL_COPY, "t = a * b; x = t"},
+    {2, {TAC_COPY, TAC_GOTO}, SI_COPY_GOTO, "x = a; goto"},
+};
+
+#define FUSION_PATTERN_COUNT ((int)(sizeof(fusion_patterns) / sizeof(fusion_patterns[0])))
+
+static int is_branch(int op) {
+    return op == TAC_GOTO || (op >= TAC_IF_LT && op <= TAC_IF_NE) ||
+           (op >= SI_IF_LT_ELSE && op <= SI_IF_NE_ELSE) || op == SI_COPY_GOTO || op == SI_ADD_COPY_GOTO;
+}
+
+// Operandos lidos pela instrução: bit 0 = a, bit 1 = b
+static int operands_read(int op) {
+    if (op == TAC_GOTO || op == TAC_LABEL) return 0;
+    if (op == TAC_COPY || op == SI_COPY_GOTO) return 1;
+    return 3;
+}
+
+const char* vm_op_name(int op) {
+    static const char* const names[] = {
+        "if<;goto", "if>;goto", "if==;goto", "if<=;goto", "if>=;goto", "if!=;goto",
+        "+;=", "-;=", "*;=", "=;goto", "+;=;goto"
+    };
+    return op < TAC_OP_COUNT ? tac_op_name(op) : names[op - TAC_OP_COUNT];
+}
+
+// Executa o programa uma vez e devolve as execuções de cada instrução (liberar com free)
+long* tac_profile(TACProgram* prog, long max_steps) {
+    prog->profile = calloc(prog->count + 1, sizeof(long));
+    tac_run(prog, max_steps);
+    long* profile = prog->profile;
+    prog->profile = NULL;
+    return profile;
+}
+
+static int pattern_matches(const TACProgram* prog, int p, const FusionPattern* pattern,
+                           const char* is_target, const int* reads) {
+    if (p + pattern->length > prog->count) return 0;
+    for (int k = 0; k < pattern->length; k++) {
+        if (prog->code[p + k].op != (int)pattern->ops[k]) return 0;
+        if (k > 0 && is_target[p + k]) return 0;
+    }
+    if (pattern->ops[1] == TAC_COPY) {
+        int temp = prog->code[p].dst;
+        if (prog->code[p + 1].a != temp || reads[temp] != 1 || !is_temporary(prog, temp)) return 0;
+    }
+    return 1;
+}
+
+static VMInstr fuse_instructions(const VMInstr* in, const FusionPattern* pattern) {
+    VMInstr out = {pattern->fused, 0, in[0].a, in[0].b, 0};
+    switch (pattern->fused) {
+        case SI_ADD_COPY_GOTO: out.dst = in[1].dst; out.c = in[2].dst; break;
+        case SI_ADD_COPY:
+        case SI_SUB_COPY:
+        case SI_MUL_COPY: out.dst = in[1].dst; break;
+        case SI_COPY_GOTO: out.dst = in[0].dst; out.c = in[1].dst; break;
+        default: out.dst = in[0].dst; out.c = in[1].dst; break;    // if; goto
+    }
+    return out;
+}
+
+/*
+ * Aplica os padrões que evitam pelo menos min_share (0..1) dos despachos
+ * do perfil e devolve o número de superinstruções formadas. Com verbose,
+ * imprime a tabela de padrões. O perfil deixa de valer para o código novo.
+ */
+int tac_fuse(TACProgram* prog, const long* profile, double min_share, int verbose) {
+    int count = prog->count;
+    char* is_target = calloc(count + 1, 1);
+    int* reads = calloc(prog->register_count, sizeof(int));
+    for (int i = 0; i < count; i++) {
+        const VMInstr* in = &prog->code[i];
+        if (is_branch(in->op)) {
+            is_target[in->dst] = 1;
+            if (in->op >= SI_IF_LT_ELSE) is_target[in->c] = 1;
+        }
+        int mask = operands_read(in->op);
+        if (mask & 1) reads[in->a]++;
+        if (mask & 2) reads[in->b]++;
+    }
+
+    // Despachos evitados por padrão, com os pontos atribuídos como na reescrita
+    long total = 0, saved[FUSION_PATTERN_COUNT] = {0};
+    int sites[FUSION_PATTERN_COUNT] = {0};
+    for (int i = 0; i < count; i++) total += profile[i];
+    for (int p = 0; p < count;) {
+        int length = 1;
+        for (int k = 0; k < FUSION_PATTERN_COUNT; k++) {
+            if (!pattern_matches(prog, p, &fusion_patterns[k], is_target, reads)) continue;
+            sites[k]++;
+            length = fusion_patterns[k].length;
+            for (int j = 1; j < length; j++) saved[k] += profile[p + j];
+            break;
+        }
+        p += length;
+    }
+
+    int selected[FUSION_PATTERN_COUNT];
+    if (verbose) printf("\nPerfil: %ld despachos\n", total);
+    for (int k = 0; k < FUSION_PATTERN_COUNT; k++) {
+        selected[k] = saved[k] > 0 && saved[k] >= min_share * total;
+        if (verbose && sites[k]) {
+            printf("  %-24s %2d ponto(s), %8ld despachos evitáveis (%5.1f%%)%s\n",
+                   fusion_patterns[k].name, sites[k], saved[k],
+                   total ? 100.0 * saved[k] / total : 0.0, selected[k] ? "  -> fundido" : "");
+        }
+    }
+
+    // Reescreve o código; new_index leva cada posição antiga à nova (alvos são sempre inícios)
+    VMInstr* code = malloc((count + 1) * sizeof(VMInstr));
+    int* new_index = malloc((count + 1) * sizeof(int));
+    int out = 0, fused = 0;
+    for (int p = 0; p < count;) {
+        int length = 1;
+        new_index[p] = out;
+        for (int k = 0; k < FUSION_PATTERN_COUNT; k++) {
+            if (selected[k] && pattern_matches(prog, p, &fusion_patterns[k], is_target, reads)) {
+                code[out] = fuse_instructions(&prog->code[p], &fusion_patterns[k]);
+                length = fusion_patterns[k].length;
+                fused++;
+                break;
+            }
+        }
+        if (length == 1) code[out] = prog->code[p];
+        out++;
+        p += length;
+    }
+    new_index[count] = out;
+
+    for (int i = 0; i < out; i++) {
+        if (!is_branch(code[i].op)) continue;
+        if (code[i].op != SI_COPY_GOTO && code[i].op != SI_ADD_COPY_GOTO) code[i].dst = new_index[code[i].dst];
+        if (code[i].op >= SI_IF_LT_ELSE) code[i].c = new_index[code[i].c];
+    }
+
+    free(prog->code);
+    prog->code = code;
+    prog->count = out;
+    free(new_index);
+    free(reads);
+    free(is_target);
+    return fused;
+}
+
+// Lista o código da VM (com as superinstruções)
+void vm_print(const TACProgram* prog) {
+    char* const* n = prog->names;
+    for (int i = 0; i < prog->count; i++) {
+        const VMInstr* in = &prog->code[i];
+        printf("  %3d: ", i);
+        if (in->op == TAC_GOTO) {
+            printf("goto %d\n", in->dst);
+        } else if (in->op >= TAC_IF_LT && in->op <= TAC_IF_NE) {
+            printf("if %s %s %s goto %d\n", n[in->a], tac_op_name(in->op), n[in->b], in->dst);
+        } else if (in->op == TAC_COPY) {
+            printf("%s = %s\n", n[in->dst], n[in->a]);
+        } else if (in->op < TAC_OP_COUNT) {
+            printf("%s = %s %s %s\n", n[in->dst], n[in->a], tac_op_name(in->op), n[in->b]);
+        } else if (in->op >= SI_IF_LT_ELSE && in->op <= SI_IF_NE_ELSE) {
+            printf("if %s %s %s goto %d else %d\t[%s]\n", n[in->a],
+                   tac_op_name(in->op - SI_IF_LT_ELSE + TAC_IF_LT), n[in->b], in->dst, in->c, vm_op_name(in->op));
+        } else if (in->op == SI_COPY_GOTO) {
+            printf("%s = %s; goto %d\t[%s]\n", n[in->dst], n[in->a], in->c, vm_op_name(in->op));
+        } else {
+            static const char symbols[] = {'+', '-', '*'};
+            int arithmetic = in->op == SI_ADD_COPY_GOTO ? 0 : in->op - SI_ADD_COPY;
+            printf("%s = %s %c %s", n[in->dst], n[in->a], symbols[arithmetic], n[in->b]);
+            if (in->op == SI_ADD_COPY_GOTO) printf("; goto %d", in->c);
+            printf("\t[%s]\n", vm_op_name(in->op));
+        }
+    }
 }
 
 // ========== EXEMPLOS ==========
@@ -314,9 +961,7 @@ void exemplo_expressao_complexa() {
     printf("║  Código: (a + b * 3) - (c / 2)            ║\n");
     printf("╚════════════════════════════════════════════╝\n");
     
-    temp_count = 0;
-    label_count = 0;
-    tac_head = tac_tail = NULL;
+    tac_reset();
     
     // Construir AST: (a + b * 3) - (c / 2)
     ASTNode* mult = create_binary_op("*",
@@ -330,11 +975,16 @@ void exemplo_expressao_complexa() {
                                      create_number(2));
     ASTNode* sub = create_binary_op("-", add, div);
     
-    ExprResult* result = translate_expression(sub);
-    emit(TAC_COPY, "resultado", result->place, NULL);
+    ExprResult result = translate_expression(sub);
+    emit(TAC_COPY, tac_var("resultado"), result.place, NO_OPERAND);
     
     print_tac();
-    printf("\nTemporários: %d | Rótulos: %d\n", temp_count, label_count);
+    printf("\nTemporários: %d | Rótulos: %d\n", tac.temp_count, tac.label_count);
+
+    static const char* const names[] = {"a", "b", "c"};
+    static const int values[] = {5, 4, 9};
+    printf("\nCom a = 5, b = 4, c = 9 (esperado: resultado = 13):");
+    run_current_tac(names, values, 3);
 }
 
 void exemplo_comando_if() {
@@ -343,9 +993,7 @@ void exemplo_comando_if() {
     printf("║  Código: if (a > 0) x = a * 2              ║\n");
     printf("╚════════════════════════════════════════════╝\n");
     
-    temp_count = 0;
-    label_count = 0;
-    tac_head = tac_tail = NULL;
+    tac_reset();
     
     ASTNode* mult = create_binary_op("*",
                                       create_node(NODE_IDENTIFIER, "a"),
@@ -354,7 +1002,15 @@ void exemplo_comando_if() {
     generate_if_then(create_node(NODE_IDENTIFIER, "a"), mult);
     
     print_tac();
-    printf("\nTemporários: %d | Rótulos: %d\n", temp_count, label_count);
+    printf("\nTemporários: %d | Rótulos: %d\n", tac.temp_count, tac.label_count);
+
+    static const char* const names[] = {"a"};
+    static const int positive[] = {7};
+    static const int negative[] = {-3};
+    printf("\nCom a = 7 (esperado: x = 14):");
+    run_current_tac(names, positive, 1);
+    printf("\nCom a = -3 (esperado: x = 0):");
+    run_current_tac(names, negative, 1);
 }
 
 void exemplo_loop_while() {
@@ -363,9 +1019,7 @@ void exemplo_loop_while() {
     printf("║  Código: while (i <= 10) i = i + 1        ║\n");
     printf("╚════════════════════════════════════════════╝\n");
     
-    temp_count = 0;
-    label_count = 0;
-    tac_head = tac_tail = NULL;
+    tac_reset();
     
     ASTNode* add = create_binary_op("+",
                                      create_node(NODE_IDENTIFIER, "i"),
@@ -374,7 +1028,28 @@ void exemplo_loop_while() {
     generate_while_loop(create_node(NODE_IDENTIFIER, "i"), add);
     
     print_tac();
-    printf("\nTemporários: %d | Rótulos: %d\n", temp_count, label_count);
+    printf("\nTemporários: %d | Rótulos: %d\n", tac.temp_count, tac.label_count);
+
+    static const char* const names[] = {"i"};
+    static const int values[] = {0};
+    printf("\nCom i = 0 (esperado: i = 11):");
+    run_current_tac(names, values, 1);
+
+    // Superinstruções: perfil de uma execução e fusão das sequências quentes
+    TACProgram* prog = tac_load(&tac);
+    tac_set(prog, "i", 0);
+    long* profile = tac_profile(prog, 1000000);
+    long before = prog->executed;
+    tac_fuse(prog, profile, 0.05, 1);
+    free(profile);
+    printf("\nCódigo com superinstruções:\n");
+    vm_print(prog);
+    tac_set(prog, "i", 0);
+    tac_run(prog, 1000000);
+    int i = 0;
+    tac_get(prog, "i", &i);
+    printf("Execução: i = %d, %ld → %ld despachos\n", i, before, prog->executed);
+    tac_free(prog);
 }
 
 void exemplo_otimizacao() {
@@ -383,36 +1058,254 @@ void exemplo_otimizacao() {
     printf("║  Código: x = 2 + 3 * 4                     ║\n");
     printf("╚════════════════════════════════════════════╝\n");
     
-    temp_count = 0;
-    label_count = 0;
-    tac_head = tac_tail = NULL;
+    tac_reset();
     
     ASTNode* mult = create_binary_op("*", create_number(3), create_number(4));
     ASTNode* add = create_binary_op("+", create_number(2), mult);
     
     printf("\nSem otimização:\n");
-    ExprResult* result1 = translate_expression(add);
-    emit(TAC_COPY, "x", result1->place, NULL);
+    ExprResult result1 = translate_expression(add);
+    emit(TAC_COPY, tac_var("x"), result1.place, NO_OPERAND);
     print_tac();
+    TACProgram* plain = tac_load(&tac);
     
     printf("\n\nCom otimização:\n");
-    temp_count = 0;
-    tac_head = tac_tail = NULL;
+    tac_reset();
     
     // Reconstruir AST
     mult = create_binary_op("*", create_number(3), create_number(4));
     add = create_binary_op("+", create_number(2), mult);
     
-    ExprResult* result2 = optimize_constant_folding(add);
-    emit(TAC_COPY, "x", result2->place, NULL);
+    ExprResult result2 = optimize_constant_folding(add);
+    emit(TAC_COPY, tac_var("x"), result2.place, NO_OPERAND);
     print_tac();
+    TACProgram* folded = tac_load(&tac);
     
     printf("\nTemporários economizados: 2 → 0\n");
+
+    // A otimização é validada executando as duas versões
+    int x_plain = 0, x_folded = 0;
+    tac_run(plain, 1000);
+    tac_run(folded, 1000);
+    tac_get(plain, "x", &x_plain);
+    tac_get(folded, "x", &x_folded);
+    printf("Execução: x = %d (%ld instruções) → x = %d (%ld instruções): %s\n",
+           x_plain, plain->executed, x_folded, folded->executed,
+           x_plain == x_folded ? "resultados iguais" : "RESULTADOS DIFERENTES");
+    tac_free(plain);
+    tac_free(folded);
+}
+
+// ========== BENCHMARK ==========
+
+/*
+ * Laço em TAC que soma 0 + 1 + ... + (n - 1), na forma emitida por
+ * generate_while_loop:
+ *
+ *       i = 0
+ *       s = 0
+ *   L0: if i < n goto L1
+ *       goto L2
+ *   L1: t0 = s + i
+ *       s = t0
+ *       t1 = i + 1
+ *       i = t1
+ *       goto L0
+ *   L2:
+ */
+void build_sum_loop() {
+    tac_reset();
+    Operand i = tac_var("i"), s = tac_var("s"), n = tac_var("n");
+    Operand zero = tac_const(0), one = tac_const(1);
+    Operand L_start = new_label();
+    Operand L_body = new_label();
+    Operand L_end = new_label();
+    emit(TAC_COPY, i, zero, NO_OPERAND);
+    emit(TAC_COPY, s, zero, NO_OPERAND);
+    emit(TAC_LABEL, L_start, NO_OPERAND, NO_OPERAND);
+    emit(TAC_IF_LT, L_body, i, n);
+    emit(TAC_GOTO, L_end, NO_OPERAND, NO_OPERAND);
+    emit(TAC_LABEL, L_body, NO_OPERAND, NO_OPERAND);
+    Operand sum = new_temp();
+    emit(TAC_ADD, sum, s, i);
+    emit(TAC_COPY, s, sum, NO_OPERAND);
+    Operand next = new_temp();
+    emit(TAC_ADD, next, i, one);
+    emit(TAC_COPY, i, next, NO_OPERAND);
+    emit(TAC_GOTO, L_start, NO_OPERAND, NO_OPERAND);
+    emit(TAC_LABEL, L_end, NO_OPERAND, NO_OPERAND);
+}
+
+/*
+ * Dois laços aninhados: s = soma de i * j para i, j em [0, n)
+ *
+ *       i = 0
+ *       s = 0
+ *   L0: if i < n goto L1
+ *       goto L4
+ *   L1: j = 0
+ *   L2: if j < n goto L3
+ *       t0 = i + 1
+ *       i = t0
+ *       goto L0
+ *   L3: t1 = i * j
+ *       t2 = s + t1
+ *       s = t2
+ *       t3 = j + 1
+ *       j = t3
+ *       goto L2
+ *   L4:
+ */
+void build_nested_loop() {
+    tac_reset();
+    Operand i = tac_var("i"), j = tac_var("j"), s = tac_var("s"), n = tac_var("n");
+    Operand zero = tac_const(0), one = tac_const(1);
+    Operand L[5];
+    for (int k = 0; k < 5; k++) L[k] = new_label();
+    emit(TAC_COPY, i, zero, NO_OPERAND);
+    emit(TAC_COPY, s, zero, NO_OPERAND);
+    emit(TAC_LABEL, L[0], NO_OPERAND, NO_OPERAND);
+    emit(TAC_IF_LT, L[1], i, n);
+    emit(TAC_GOTO, L[4], NO_OPERAND, NO_OPERAND);
+    emit(TAC_LABEL, L[1], NO_OPERAND, NO_OPERAND);
+    emit(TAC_COPY, j, zero, NO_OPERAND);
+    emit(TAC_LABEL, L[2], NO_OPERAND, NO_OPERAND);
+    emit(TAC_IF_LT, L[3], j, n);
+    Operand t0 = new_temp();
+    emit(TAC_ADD, t0, i, one);
+    emit(TAC_COPY, i, t0, NO_OPERAND);
+    emit(TAC_GOTO, L[0], NO_OPERAND, NO_OPERAND);
+    emit(TAC_LABEL, L[3], NO_OPERAND, NO_OPERAND);
+    Operand t1 = new_temp();
+    emit(TAC_MUL, t1, i, j);
+    Operand t2 = new_temp();
+    emit(TAC_ADD, t2, s, t1);
+    emit(TAC_COPY, s, t2, NO_OPERAND);
+    Operand t3 = new_temp();
+    emit(TAC_ADD, t3, j, one);
+    emit(TAC_COPY, j, t3, NO_OPERAND);
+    emit(TAC_GOTO, L[2], NO_OPERAND, NO_OPERAND);
+    emit(TAC_LABEL, L[4], NO_OPERAND, NO_OPERAND);
+}
+
+static double time_runs(TACProgram* prog, int n, long repetitions, long* dispatches) {
+    *dispatches = 0;
+    clock_t start = clock();
+    for (long rep = 0; rep < repetitions; rep++) {
+        tac_set(prog, "n", n);
+        tac_run(prog, -1);
+        *dispatches += prog->executed;
+    }
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+/*
+ * Executa o programa atual sem e com superinstruções (perfil de uma
+ * execução, padrões com pelo menos 5% dos despachos) e confere o resultado.
+ */
+static void benchmark_program(const char* title, int n, long repetitions, int expected) {
+    printf("\n=== %s (n = %d, %ld execuções) ===\n", title, n, repetitions);
+    print_tac();
+
+    TACProgram* plain = tac_load(&tac);
+    TACProgram* fused = tac_load(&tac);
+    tac_set(fused, "n", n);
+    long* profile = tac_profile(fused, -1);
+    tac_fuse(fused, profile, 0.05, 1);
+    free(profile);
+    printf("\nCódigo com superinstruções:\n");
+    vm_print(fused);
+
+    long plain_dispatches, fused_dispatches;
+    double plain_seconds = time_runs(plain, n, repetitions, &plain_dispatches);
+    double fused_seconds = time_runs(fused, n, repetitions, &fused_dispatches);
+    int plain_s = 0, fused_s = 0;
+    tac_get(plain, "s", &plain_s);
+    tac_get(fused, "s", &fused_s);
+
+    printf("\n%-22s %14s %10s %12s\n", "", "despachos", "segundos", "milhões/s");
+    printf("%-22s %14ld %10.3f %12.1f\n", "TAC", plain_dispatches, plain_seconds,
+           plain_seconds > 0 ? plain_dispatches / plain_seconds / 1e6 : 0.0);
+    printf("%-22s %14ld %10.3f %12.1f\n", "superinstruções", fused_dispatches, fused_seconds,
+           fused_seconds > 0 ? fused_dispatches / fused_seconds / 1e6 : 0.0);
+    printf("s = %d / %d (esperado %d); despachos %.0f%%, tempo %.2fx\n", plain_s, fused_s, expected,
+           plain_dispatches ? 100.0 * fused_dispatches / plain_dispatches : 0.0,
+           fused_seconds > 0 ? plain_seconds / fused_seconds : 0.0);
+    if (plain_s != expected || fused_s != expected) printf("RESULTADOS DIFERENTES\n");
+
+    tac_free(plain);
+    tac_free(fused);
+}
+
+// Árvore balanceada com as folhas x0, 1, x1, 2, ... (n folhas, n - 1 operações)
+static ASTNode* build_balanced_tree(int first, int n) {
+    if (n == 1) {
+        if (first % 2) return create_number(first % 1000);
+        char name[16];
+        sprintf(name, "x%d", first % 1000);
+        return create_node(NODE_IDENTIFIER, name);
+    }
+    static char* const ops[] = {"+", "-", "*"};
+    return create_binary_op(ops[n % 3], build_balanced_tree(first, n / 2),
+                            build_balanced_tree(first + n / 2, n - n / 2));
+}
+
+static void free_tree(ASTNode* node) {
+    if (!node) return;
+    free_tree(node->left);
+    free_tree(node->right);
+    free(node->value);
+    free(node);
+}
+
+/*
+ * Custo da geração: traduz uma expressão com n folhas várias vezes. Cada
+ * instrução é um registro de 16 bytes no vetor, e temporários e rótulos
+ * não alocam memória.
+ */
+static void benchmark_generation(int n, int repetitions) {
+    ASTNode* tree = build_balanced_tree(0, n);
+    clock_t start = clock();
+    for (int rep = 0; rep < repetitions; rep++) {
+        tac_reset();
+        ExprResult result = translate_expression(tree);
+        emit(TAC_COPY, tac_var("resultado"), result.place, NO_OPERAND);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("\n=== GERAÇÃO (expressão com %d folhas, %d vezes) ===\n", n, repetitions);
+    printf("%d instruções de %zu bytes, %d temporários, %d variáveis, %d constantes\n",
+           tac.count, sizeof(TACInstr), tac.temp_count, tac.var_count, tac.const_count);
+    printf("%.3f s, %.1f milhões de instruções/s\n", seconds,
+           seconds > 0 ? (double)tac.count * repetitions / seconds / 1e6 : 0.0);
+    free_tree(tree);
+}
+
+void run_benchmark(long repetitions) {
+    benchmark_generation(100000, 50);
+
+    build_sum_loop();
+    benchmark_program("SOMA", 10000, repetitions, 10000 * 9999 / 2);
+
+    int n = 300;
+    build_nested_loop();
+    benchmark_program("LAÇOS ANINHADOS", n, repetitions / 10 ? repetitions / 10 : 1, (n * (n - 1) / 2) * (n * (n - 1) / 2));
 }
 
 // ========== MAIN ==========
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        long repetitions = argc > 2 ? atol(argv[2]) : 2000;
+        if (repetitions < 1) {
+            printf("Uso: %s --benchmark [N]\n", argv[0]);
+            return 1;
+        }
+        run_benchmark(repetitions);
+        return 0;
+    }
+
+
     printf("╔════════════════════════════════════════════╗\n");
     printf("║  Gerador de Código Intermediário          ║\n");
     printf("║  Exemplo Completo - TAC                    ║\n");
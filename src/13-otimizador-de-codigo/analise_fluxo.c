@@ -0,0 +1,1232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Blocos Básicos e Grafo de Fluxo de Controle sobre TAC
+ *
+ * O TAC usa o mesmo formato compacto de 12-geracao-codigo-intermediario
+ * (instruções de 16 bytes com operandos inteiros). cfg_build divide o
+ * código em blocos básicos, liga os blocos pelas arestas de controle,
+ * guardadas em vetores de adjacência compactos, e calcula a ordem
+ * pós-ordem reversa. O grafo pode ser exportado em DOT (Graphviz).
+ *
+ * Sobre o CFG roda um framework iterativo de fluxo de dados com conjuntos
+ * de bits densos, parametrizado pela direção e pelo operador de
+ * confluência; reaching definitions, live variables, available
+ * expressions e very busy expressions são instâncias dele.
+ *
+ * Compilação: gcc analise_fluxo.c -o analise_fluxo -std=c99 -O3
+ * Uso:
+ *   ./analise_fluxo                      exemplo: TAC, blocos e análises
+ *   ./analise_fluxo --dot                DOT do exemplo (para o Graphviz)
+ *   ./analise_fluxo --benchmark [N]      CFG e análises de um programa
+ *                                        gerado com N comandos
+ */
+
+// ========== FUNÇÕES AUXILIARES ==========
+
+// Dobra a capacidade do vetor (mínimo 16) e devolve o novo endereço
+static void* grow_array(void* array, int* capacity, size_t element_size) {
+    *capacity = *capacity ? *capacity * 2 : 16;
+    array = realloc(array, (size_t)*capacity * element_size);
+    if (!array) {
+        fprintf(stderr, "Erro: falha ao alocar memória\n");
+        exit(1);
+    }
+    return array;
+}
+
+static double elapsed_seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// ========== CÓDIGO DE TRÊS ENDEREÇOS ==========
+
+typedef enum {
+    TAC_ADD, TAC_SUB, TAC_MUL, TAC_DIV,
+    TAC_COPY, TAC_LABEL, TAC_GOTO,
+    TAC_IF_LT, TAC_IF_GT, TAC_IF_EQ,
+    TAC_IF_LE, TAC_IF_GE, TAC_IF_NE
+} TACOp;
+
+/*
+ * Operando: o tipo nos 3 bits de baixo e um índice no resto. Temporários
+ * e rótulos são só números; variáveis e constantes são índices nas
+ * tabelas do código.
+ */
+typedef uint32_t Operand;
+
+typedef enum {
+    OPND_NONE,
+    OPND_TEMP,
+    OPND_VAR,
+    OPND_CONST,
+    OPND_LABEL
+} OperandKind;
+
+#define OPERAND(kind, index) ((Operand)(((uint32_t)(index) << 3) | (uint32_t)(kind)))
+#define OPERAND_KIND(operand) ((OperandKind)((operand) & 7u))
+#define OPERAND_INDEX(operand) ((int)((operand) >> 3))
+#define NO_OPERAND OPERAND(OPND_NONE, 0)
+
+// Instrução de 16 bytes: nos desvios, result é o rótulo de destino
+typedef struct {
+    uint32_t op;        // TACOp
+    Operand result;
+    Operand arg1;
+    Operand arg2;
+} TACInstr;
+
+/*
+ * Código: as instruções em um vetor contíguo e as tabelas laterais.
+ * Variáveis e constantes são internadas por hash aberto (sondagem
+ * linear); os nomes ficam juntos em um único buffer de texto.
+ */
+typedef struct {
+    TACInstr* code;
+    int count;
+    int capacity;
+
+    int* names;             // deslocamento do nome de cada variável em text
+    int var_count;
+    int var_capacity;
+    char* text;
+    int text_size;
+    int text_capacity;
+
+    int* constants;
+    int const_count;
+    int const_capacity;
+
+    int* slots;             // hash: var + 1, -(const + 1) ou 0 (vazio)
+    int slot_capacity;      // potência de 2
+
+    int temp_count;
+    int label_count;
+} TACCode;
+
+const char* var_name(const TACCode* tac, int var) {
+    return tac->text + tac->names[var];
+}
+
+static unsigned int hash_text(const char* text) {
+    unsigned int hash = 2166136261u;    // FNV-1a
+    while (*text) {
+        hash ^= (unsigned char)*text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static unsigned int hash_value(int value) {
+    unsigned int hash = (unsigned int)value * 2654435761u;
+    return hash ^ (hash >> 16);
+}
+
+static void grow_slots(TACCode* tac) {
+    free(tac->slots);
+    tac->slot_capacity = tac->slot_capacity ? tac->slot_capacity * 2 : 64;
+    tac->slots = calloc(tac->slot_capacity, sizeof(int));
+    unsigned int mask = (unsigned int)tac->slot_capacity - 1;
+    for (int v = 0; v < tac->var_count; v++) {
+        unsigned int i = hash_text(var_name(tac, v)) & mask;
+        while (tac->slots[i]) i = (i + 1) & mask;
+        tac->slots[i] = v + 1;
+    }
+    for (int c = 0; c < tac->const_count; c++) {
+        unsigned int i = hash_value(tac->constants[c]) & mask;
+        while (tac->slots[i]) i = (i + 1) & mask;
+        tac->slots[i] = -(c + 1);
+    }
+}
+
+Operand tac_var(TACCode* tac, const char* name) {
+    if (2 * (tac->var_count + tac->const_count + 1) > tac->slot_capacity) grow_slots(tac);
+    unsigned int mask = (unsigned int)tac->slot_capacity - 1;
+    unsigned int i = hash_text(name) & mask;
+    for (; tac->slots[i]; i = (i + 1) & mask) {
+        int var = tac->slots[i] - 1;
+        if (var >= 0 && strcmp(var_name(tac, var), name) == 0) return OPERAND(OPND_VAR, var);
+    }
+
+    int length = (int)strlen(name) + 1;
+    while (tac->text_size + length > tac->text_capacity) {
+        tac->text = grow_array(tac->text, &tac->text_capacity, 1);
+    }
+    memcpy(tac->text + tac->text_size, name, length);
+    if (tac->var_count == tac->var_capacity) {
+        tac->names = grow_array(tac->names, &tac->var_capacity, sizeof(int));
+    }
+    tac->names[tac->var_count] = tac->text_size;
+    tac->text_size += length;
+    tac->slots[i] = tac->var_count + 1;
+    return OPERAND(OPND_VAR, tac->var_count++);
+}
+
+Operand tac_const(TACCode* tac, int value) {
+    if (2 * (tac->var_count + tac->const_count + 1) > tac->slot_capacity) grow_slots(tac);
+    unsigned int mask = (unsigned int)tac->slot_capacity - 1;
+    unsigned int i = hash_value(value) & mask;
+    for (; tac->slots[i]; i = (i + 1) & mask) {
+        int c = -tac->slots[i] - 1;
+        if (c >= 0 && tac->constants[c] == value) return OPERAND(OPND_CONST, c);
+    }
+
+    if (tac->const_count == tac->const_capacity) {
+        tac->constants = grow_array(tac->constants, &tac->const_capacity, sizeof(int));
+    }
+    tac->constants[tac->const_count] = value;
+    tac->slots[i] = -(tac->const_count + 1);
+    return OPERAND(OPND_CONST, tac->const_count++);
+}
+
+Operand new_temp(TACCode* tac) {
+    return OPERAND(OPND_TEMP, tac->temp_count++);
+}
+
+Operand new_label(TACCode* tac) {
+    return OPERAND(OPND_LABEL, tac->label_count++);
+}
+
+void emit(TACCode* tac, TACOp op, Operand result, Operand arg1, Operand arg2) {
+    if (tac->count == tac->capacity) {
+        tac->code = grow_array(tac->code, &tac->capacity, sizeof(TACInstr));
+    }
+    TACInstr* instr = &tac->code[tac->count++];
+    instr->op = op;
+    instr->result = result;
+    instr->arg1 = arg1;
+    instr->arg2 = arg2;
+}
+
+void tac_free(TACCode* tac) {
+    free(tac->code);
+    free(tac->names);
+    free(tac->text);
+    free(tac->constants);
+    free(tac->slots);
+    memset(tac, 0, sizeof(*tac));
+}
+
+static int is_conditional(uint32_t op) {
+    return op >= TAC_IF_LT && op <= TAC_IF_NE;
+}
+
+static int is_jump(uint32_t op) {
+    return op == TAC_GOTO || is_conditional(op);
+}
+
+const char* tac_op_name(uint32_t op) {
+    static const char* const names[] = {
+        "+", "-", "*", "/", "=", ":", "goto", "<", ">", "==", "<=", ">=", "!="
+    };
+    return op <= TAC_IF_NE ? names[op] : "???";
+}
+
+const char* operand_text(const TACCode* tac, Operand operand, char* buffer) {
+    switch (OPERAND_KIND(operand)) {
+        case OPND_TEMP:  sprintf(buffer, "t%d", OPERAND_INDEX(operand)); return buffer;
+        case OPND_LABEL: sprintf(buffer, "L%d", OPERAND_INDEX(operand)); return buffer;
+        case OPND_CONST: sprintf(buffer, "%d", tac->constants[OPERAND_INDEX(operand)]); return buffer;
+        case OPND_VAR:   return var_name(tac, OPERAND_INDEX(operand));
+        default:         return "";
+    }
+}
+
+// Texto de uma instrução, sem quebra de linha
+void format_instr(const TACCode* tac, const TACInstr* instr, char* out, size_t size) {
+    char r[16], a[16], b[16];
+    const char* result = operand_text(tac, instr->result, r);
+    const char* arg1 = operand_text(tac, instr->arg1, a);
+    const char* arg2 = operand_text(tac, instr->arg2, b);
+
+    if (instr->op == TAC_LABEL) {
+        snprintf(out, size, "%s:", result);
+    } else if (instr->op == TAC_GOTO) {
+        snprintf(out, size, "goto %s", result);
+    } else if (is_conditional(instr->op)) {
+        snprintf(out, size, "if %s %s %s goto %s", arg1, tac_op_name(instr->op), arg2, result);
+    } else if (instr->op == TAC_COPY) {
+        snprintf(out, size, "%s = %s", result, arg1);
+    } else {
+        snprintf(out, size, "%s = %s %s %s", result, arg1, tac_op_name(instr->op), arg2);
+    }
+}
+
+void print_tac(const TACCode* tac) {
+    char line[128];
+    for (int i = 0; i < tac->count; i++) {
+        format_instr(tac, &tac->code[i], line, sizeof(line));
+        printf(tac->code[i].op == TAC_LABEL ? "%4d %s\n" : "%4d     %s\n", i, line);
+    }
+}
+
+// ========== GRAFO DE FLUXO DE CONTROLE ==========
+
+/*
+ * Um bloco básico é a faixa [first, end) de instruções do TAC. Os líderes
+ * (primeiras instruções de bloco) são:
+ *   - a primeira instrução do código;
+ *   - cada rótulo que é alvo de algum desvio;
+ *   - a instrução seguinte a um goto ou if.
+ * Rótulos que ninguém usa não quebram o bloco.
+ *
+ * As arestas ficam em vetores de adjacência compactos (CSR): os
+ * sucessores do bloco b são succ[succ_start[b] .. succ_start[b + 1]), e o
+ * mesmo vale para os predecessores. Um if que desvia para a própria
+ * instrução seguinte gera uma só aresta.
+ *
+ * rpo lista os blocos alcançáveis a partir do bloco 0 em pós-ordem
+ * reversa (cada bloco antes dos seus sucessores, exceto nas arestas de
+ * volta dos laços); rpo_index[b] é a posição de b em rpo, ou -1 se o bloco
+ * é inalcançável.
+ */
+typedef struct {
+    int first;
+    int end;
+} BasicBlock;
+
+typedef struct {
+    BasicBlock* blocks;
+    int block_count;
+    int* block_of;          // bloco de cada instrução
+
+    int* succ_start;        // block_count + 1 posições
+    int* succ;
+    int* pred_start;
+    int* pred;
+    int edge_count;
+
+    int* rpo;
+    int rpo_count;
+    int* rpo_index;
+} CFG;
+
+// Bloco de destino de um desvio; label_block já foi preenchido
+static int jump_target(const int* label_block, const TACInstr* instr) {
+    return label_block[OPERAND_INDEX(instr->result)];
+}
+
+// Pós-ordem reversa por busca em profundidade iterativa (sem recursão)
+static void compute_rpo(CFG* cfg) {
+    int n = cfg->block_count;
+    cfg->rpo = malloc((n + 1) * sizeof(int));
+    cfg->rpo_index = malloc((n + 1) * sizeof(int));
+    for (int b = 0; b < n; b++) cfg->rpo_index[b] = -1;
+    cfg->rpo_count = 0;
+    if (n == 0) return;
+
+    // Pilha de (bloco, próximo sucessor a visitar); rpo_index marca "visitado"
+    int* stack = malloc(n * sizeof(int));
+    int* next = malloc(n * sizeof(int));
+    int* postorder = malloc(n * sizeof(int));
+    int depth = 0, finished = 0;
+    stack[depth] = 0;
+    next[depth++] = cfg->succ_start[0];
+    cfg->rpo_index[0] = 0;
+    while (depth > 0) {
+        int b = stack[depth - 1];
+        if (next[depth - 1] < cfg->succ_start[b + 1]) {
+            int s = cfg->succ[next[depth - 1]++];
+            if (cfg->rpo_index[s] < 0) {
+                cfg->rpo_index[s] = 0;
+                stack[depth] = s;
+                next[depth++] = cfg->succ_start[s];
+            }
+        } else {
+            postorder[finished++] = b;
+            depth--;
+        }
+    }
+
+    for (int i = 0; i < finished; i++) {
+        int b = postorder[finished - 1 - i];
+        cfg->rpo[i] = b;
+        cfg->rpo_index[b] = i;
+    }
+    cfg->rpo_count = finished;
+    free(postorder);
+    free(next);
+    free(stack);
+}
+
+/*
+ * Monta o CFG do código. Devolve NULL (com mensagem) se algum desvio usa
+ * um rótulo que não foi definido.
+ */
+CFG* cfg_build(const TACCode* tac) {
+    int count = tac->count;
+    int* label_at = malloc((tac->label_count + 1) * sizeof(int));
+    for (int l = 0; l < tac->label_count; l++) label_at[l] = -1;
+    for (int i = 0; i < count; i++) {
+        if (tac->code[i].op == TAC_LABEL) label_at[OPERAND_INDEX(tac->code[i].result)] = i;
+    }
+
+    // Líderes
+    char* leader = calloc(count + 1, 1);
+    if (count > 0) leader[0] = 1;
+    for (int i = 0; i < count; i++) {
+        const TACInstr* instr = &tac->code[i];
+        if (!is_jump(instr->op)) continue;
+        int target = label_at[OPERAND_INDEX(instr->result)];
+        if (target < 0) {
+            fprintf(stderr, "Erro: rótulo 'L%d' não definido\n", OPERAND_INDEX(instr->result));
+            free(leader);
+            free(label_at);
+            return NULL;
+        }
+        leader[target] = 1;
+        leader[i + 1] = 1;
+    }
+
+    CFG* cfg = calloc(1, sizeof(CFG));
+    int blocks = 0;
+    for (int i = 0; i < count; i++) blocks += leader[i];
+    cfg->blocks = malloc((blocks + 1) * sizeof(BasicBlock));
+    cfg->block_of = malloc((count + 1) * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        if (leader[i]) {
+            if (cfg->block_count > 0) cfg->blocks[cfg->block_count - 1].end = i;
+            cfg->blocks[cfg->block_count++].first = i;
+        }
+        cfg->block_of[i] = cfg->block_count - 1;
+    }
+    if (cfg->block_count > 0) cfg->blocks[cfg->block_count - 1].end = count;
+    free(leader);
+
+    // O rótulo passa a apontar para o bloco
+    for (int l = 0; l < tac->label_count; l++) {
+        if (label_at[l] >= 0) label_at[l] = cfg->block_of[label_at[l]];
+    }
+
+    // Sucessores: até dois por bloco, dados pela última instrução
+    int n = cfg->block_count;
+    cfg->succ_start = malloc((n + 1) * sizeof(int));
+    cfg->succ = malloc((2 * n + 1) * sizeof(int));
+    cfg->edge_count = 0;
+    for (int b = 0; b < n; b++) {
+        const TACInstr* last = &tac->code[cfg->blocks[b].end - 1];
+        cfg->succ_start[b] = cfg->edge_count;
+        int falls_through = last->op != TAC_GOTO && b + 1 < n;
+        if (is_jump(last->op)) {
+            int target = jump_target(label_at, last);
+            cfg->succ[cfg->edge_count++] = target;
+            if (falls_through && target == b + 1) falls_through = 0;
+        }
+        if (falls_through) cfg->succ[cfg->edge_count++] = b + 1;
+    }
+    cfg->succ_start[n] = cfg->edge_count;
+    free(label_at);
+
+    // Predecessores: contagem por bloco e soma prefixada
+    cfg->pred_start = calloc(n + 2, sizeof(int));
+    cfg->pred = malloc((cfg->edge_count + 1) * sizeof(int));
+    for (int e = 0; e < cfg->edge_count; e++) cfg->pred_start[cfg->succ[e] + 2]++;
+    for (int b = 0; b < n; b++) cfg->pred_start[b + 2] += cfg->pred_start[b + 1];
+    for (int b = 0; b < n; b++) {
+        for (int e = cfg->succ_start[b]; e < cfg->succ_start[b + 1]; e++) {
+            cfg->pred[cfg->pred_start[cfg->succ[e] + 1]++] = b;
+        }
+    }
+
+    compute_rpo(cfg);
+    return cfg;
+}
+
+void cfg_free(CFG* cfg) {
+    if (!cfg) return;
+    free(cfg->blocks);
+    free(cfg->block_of);
+    free(cfg->succ_start);
+    free(cfg->succ);
+    free(cfg->pred_start);
+    free(cfg->pred);
+    free(cfg->rpo);
+    free(cfg->rpo_index);
+    free(cfg);
+}
+
+static void print_block_list(const int* list, int from, int to) {
+    if (from == to) printf(" -");
+    for (int e = from; e < to; e++) printf(" B%d", list[e]);
+}
+
+void cfg_print(const CFG* cfg, const TACCode* tac) {
+    char line[128];
+    for (int b = 0; b < cfg->block_count; b++) {
+        const BasicBlock* block = &cfg->blocks[b];
+        printf("\nB%d  [%d, %d)%s\n", b, block->first, block->end,
+               cfg->rpo_index[b] < 0 ? "  (inalcançável)" : "");
+        printf("  predecessores:");
+        print_block_list(cfg->pred, cfg->pred_start[b], cfg->pred_start[b + 1]);
+        printf("\n  sucessores:   ");
+        print_block_list(cfg->succ, cfg->succ_start[b], cfg->succ_start[b + 1]);
+        printf("\n");
+        for (int i = block->first; i < block->end; i++) {
+            format_instr(tac, &tac->code[i], line, sizeof(line));
+            printf(tac->code[i].op == TAC_LABEL ? "    %s\n" : "        %s\n", line);
+        }
+    }
+
+    printf("\nPós-ordem reversa:");
+    for (int i = 0; i < cfg->rpo_count; i++) printf(" B%d", cfg->rpo[i]);
+    printf("\n");
+}
+
+/*
+ * Exporta o grafo em DOT. Cada bloco é uma caixa com as suas instruções;
+ * nos desvios condicionais, a aresta do desvio é marcada "sim" e a da
+ * instrução seguinte "não". Blocos inalcançáveis ficam tracejados.
+ */
+void cfg_write_dot(const CFG* cfg, const TACCode* tac, FILE* out) {
+    char line[128];
+    fprintf(out, "digraph cfg {\n");
+    fprintf(out, "    node [shape=box, fontname=\"monospace\"];\n");
+    for (int b = 0; b < cfg->block_count; b++) {
+        fprintf(out, "    B%d [label=\"B%d\\l", b, b);
+        for (int i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            format_instr(tac, &tac->code[i], line, sizeof(line));
+            fprintf(out, "%s%s\\l", tac->code[i].op == TAC_LABEL ? "" : "    ", line);
+        }
+        fprintf(out, "\"%s];\n", cfg->rpo_index[b] < 0 ? ", style=dashed" : "");
+    }
+    for (int b = 0; b < cfg->block_count; b++) {
+        const TACInstr* last = &tac->code[cfg->blocks[b].end - 1];
+        int conditional = is_conditional(last->op) && cfg->succ_start[b + 1] - cfg->succ_start[b] == 2;
+        for (int e = cfg->succ_start[b]; e < cfg->succ_start[b + 1]; e++) {
+            fprintf(out, "    B%d -> B%d", b, cfg->succ[e]);
+            if (conditional) fprintf(out, " [label=\"%s\"]", e == cfg->succ_start[b] ? "sim" : "não");
+            fprintf(out, ";\n");
+        }
+    }
+    fprintf(out, "}\n");
+}
+
+// ========== ANÁLISE DE FLUXO DE DADOS ==========
+
+/*
+ * Conjuntos de bits densos: cada conjunto é uma linha de 'words' palavras
+ * de 64 bits, e os conjuntos de todos os blocos de uma análise ficam em
+ * uma única matriz contígua (linha b = conjunto do bloco b). As linhas
+ * têm um número de palavras múltiplo de 4, então os laços de união e
+ * interseção não têm sobra e o compilador os vetoriza (com -O3 ou
+ * -ftree-vectorize) sem código extra de alinhamento.
+ */
+typedef uint64_t Word;
+
+#define WORD_BITS 64
+#define ROW_ALIGN 4
+
+static int words_for(int bits) {
+    int words = (bits + WORD_BITS - 1) / WORD_BITS;
+    return (words + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+}
+
+static Word* bitset_row(Word* matrix, int words, int row) {
+    return matrix + (size_t)row * words;
+}
+
+static void bitset_set(Word* set, int bit) {
+    set[bit / WORD_BITS] |= (Word)1 << (bit % WORD_BITS);
+}
+
+static void bitset_clear(Word* set, int bit) {
+    set[bit / WORD_BITS] &= ~((Word)1 << (bit % WORD_BITS));
+}
+
+static int bitset_test(const Word* set, int bit) {
+    return (int)((set[bit / WORD_BITS] >> (bit % WORD_BITS)) & 1);
+}
+
+// Universo: todos os bits válidos ligados, a sobra da última palavra zerada
+static void bitset_fill(Word* set, int bits, int words) {
+    for (int w = 0; w < words; w++) {
+        int valid = bits - w * WORD_BITS;
+        set[w] = valid >= WORD_BITS ? ~(Word)0 : valid > 0 ? ((Word)1 << valid) - 1 : 0;
+    }
+}
+
+static void bitset_union_into(Word* restrict dst, const Word* restrict src, int words) {
+    for (int w = 0; w < words; w++) dst[w] |= src[w];
+}
+
+static void bitset_intersect_into(Word* restrict dst, const Word* restrict src, int words) {
+    for (int w = 0; w < words; w++) dst[w] &= src[w];
+}
+
+// out = gen ∪ (in - kill); devolve 1 se out mudou
+static int bitset_transfer(Word* restrict out, const Word* restrict gen,
+                           const Word* restrict in, const Word* restrict kill, int words) {
+    Word changed = 0;
+    for (int w = 0; w < words; w++) {
+        Word value = gen[w] | (in[w] & ~kill[w]);
+        changed |= value ^ out[w];
+        out[w] = value;
+    }
+    return changed != 0;
+}
+
+/*
+ * Framework iterativo: a análise define a direção, o operador de
+ * confluência (meet) e os conjuntos GEN e KILL de cada bloco; o solver
+ * aplica as equações até o ponto fixo.
+ *
+ *   para frente:  IN[B]  = meet OUT[P], P predecessor;  OUT[B] = GEN ∪ (IN - KILL)
+ *   para trás:    OUT[B] = meet IN[S],  S sucessor;     IN[B]  = GEN ∪ (OUT - KILL)
+ *
+ * Na fronteira (a entrada do bloco 0 para frente, os blocos sem
+ * sucessores para trás) o conjunto é vazio. Com interseção, os demais
+ * conjuntos começam com o universo; com união, vazios.
+ */
+typedef enum { DF_FORWARD, DF_BACKWARD } DataflowDirection;
+typedef enum { MEET_UNION, MEET_INTERSECTION } DataflowMeet;
+
+typedef struct {
+    const char* name;
+    DataflowDirection direction;
+    DataflowMeet meet;
+    int bits;               // tamanho do universo
+    int words;              // palavras por linha
+    Word* gen;              // block_count linhas cada
+    Word* kill;
+    Word* in;
+    Word* out;
+
+    int* item;              // o que cada bit representa (instrução ou registrador)
+    void (*describe)(const TACCode* tac, int item, char* buffer);
+
+    int visits;             // blocos processados pelo solver
+} Dataflow;
+
+static void dataflow_init(Dataflow* df, const char* name, DataflowDirection direction,
+                          DataflowMeet meet, int block_count, int bits) {
+    memset(df, 0, sizeof(*df));
+    df->name = name;
+    df->direction = direction;
+    df->meet = meet;
+    df->bits = bits;
+    df->words = words_for(bits);
+    size_t size = ((size_t)block_count * df->words + 1) * sizeof(Word);
+    df->gen = calloc(1, size);
+    df->kill = calloc(1, size);
+    df->in = calloc(1, size);
+    df->out = calloc(1, size);
+    if (!df->gen || !df->kill || !df->in || !df->out) {
+        fprintf(stderr, "Erro: falha ao alocar memória\n");
+        exit(1);
+    }
+}
+
+void dataflow_free(Dataflow* df) {
+    free(df->gen);
+    free(df->kill);
+    free(df->in);
+    free(df->out);
+    free(df->item);
+    memset(df, 0, sizeof(*df));
+}
+
+/*
+ * Lista de trabalho ordenada: os blocos pendentes são processados em
+ * varreduras na ordem de iteração (pós-ordem reversa para frente, a ordem
+ * inversa dela para trás; os blocos inalcançáveis no fim). Quando o
+ * resultado de um bloco muda, os blocos que dependem dele ficam
+ * pendentes; os que estão adiante na ordem são tratados na mesma
+ * varredura, e só as arestas de volta dos laços pedem outra. Com uma fila
+ * FIFO simples, as mudanças saem da ordem e cada bloco é visitado muito
+ * mais vezes.
+ */
+void dataflow_solve(Dataflow* df, const CFG* cfg) {
+    int n = cfg->block_count, words = df->words;
+    int forward = df->direction == DF_FORWARD;
+    Word* before = forward ? df->in : df->out;          // lado do meet
+    Word* after = forward ? df->out : df->in;           // lado da transferência
+    const int* meet_start = forward ? cfg->pred_start : cfg->succ_start;
+    const int* meet_edges = forward ? cfg->pred : cfg->succ;
+    const int* dep_start = forward ? cfg->succ_start : cfg->pred_start;
+    const int* dep_edges = forward ? cfg->succ : cfg->pred;
+
+    if (df->meet == MEET_INTERSECTION) {
+        for (int b = 0; b < n; b++) bitset_fill(bitset_row(after, words, b), df->bits, words);
+    }
+
+    int* order = malloc((n + 1) * sizeof(int));
+    int* position = malloc((n + 1) * sizeof(int));
+    char* pending = malloc(n + 1);
+    int count = 0;
+    for (int i = 0; i < cfg->rpo_count; i++) {
+        order[count++] = cfg->rpo[forward ? i : cfg->rpo_count - 1 - i];
+    }
+    for (int b = 0; b < n; b++) {
+        if (cfg->rpo_index[b] < 0) order[count++] = b;
+    }
+    for (int k = 0; k < n; k++) position[order[k]] = k;
+    memset(pending, 1, n);
+
+    df->visits = 0;
+    int again = n > 0;
+    while (again) {
+        again = 0;
+        for (int k = 0; k < n; k++) {
+            if (!pending[k]) continue;
+            pending[k] = 0;
+            int b = order[k];
+            df->visits++;
+
+            Word* row = bitset_row(before, words, b);
+            int from = meet_start[b], to = meet_start[b + 1];
+            if (df->meet == MEET_UNION) {
+                memset(row, 0, words * sizeof(Word));
+                for (int e = from; e < to; e++) {
+                    bitset_union_into(row, bitset_row(after, words, meet_edges[e]), words);
+                }
+            } else if (from == to || (forward && b == 0)) {
+                memset(row, 0, words * sizeof(Word));
+            } else {
+                memcpy(row, bitset_row(after, words, meet_edges[from]), words * sizeof(Word));
+                for (int e = from + 1; e < to; e++) {
+                    bitset_intersect_into(row, bitset_row(after, words, meet_edges[e]), words);
+                }
+            }
+
+            if (bitset_transfer(bitset_row(after, words, b), bitset_row(df->gen, words, b), row,
+                                bitset_row(df->kill, words, b), words)) {
+                for (int e = dep_start[b]; e < dep_start[b + 1]; e++) {
+                    int d = position[dep_edges[e]];
+                    pending[d] = 1;
+                    if (d <= k) again = 1;
+                }
+            }
+        }
+    }
+    free(pending);
+    free(position);
+    free(order);
+}
+
+/*
+ * Registradores: as variáveis ocupam [0, var_count) e os temporários vêm
+ * em seguida. Constantes e rótulos não são registradores (-1).
+ */
+static int register_count(const TACCode* tac) {
+    return tac->var_count + tac->temp_count;
+}
+
+static int register_of(const TACCode* tac, Operand operand) {
+    switch (OPERAND_KIND(operand)) {
+        case OPND_VAR:  return OPERAND_INDEX(operand);
+        case OPND_TEMP: return tac->var_count + OPERAND_INDEX(operand);
+        default:        return -1;
+    }
+}
+
+// Instruções que atribuem a result: aritméticas e cópia
+static int defines(uint32_t op) {
+    return op <= TAC_COPY;
+}
+
+static int is_arithmetic(uint32_t op) {
+    return op <= TAC_DIV;
+}
+
+static void describe_register(const TACCode* tac, int reg, char* buffer) {
+    if (reg < tac->var_count) strcpy(buffer, var_name(tac, reg));
+    else sprintf(buffer, "t%d", reg - tac->var_count);
+}
+
+static void describe_definition(const TACCode* tac, int instr, char* buffer) {
+    format_instr(tac, &tac->code[instr], buffer, 64);
+}
+
+static void describe_expression(const TACCode* tac, int instr, char* buffer) {
+    char a[16], b[16];
+    const TACInstr* code = &tac->code[instr];
+    sprintf(buffer, "%s %s %s", operand_text(tac, code->arg1, a),
+            tac_op_name(code->op), operand_text(tac, code->arg2, b));
+}
+
+/*
+ * Reaching definitions (para frente, união). Cada instrução que atribui a
+ * um registrador é uma definição. KILL[B] reúne todas as definições dos
+ * registradores atribuídos em B; GEN[B], a última definição de cada um.
+ */
+void reaching_definitions(Dataflow* df, const CFG* cfg, const TACCode* tac) {
+    int regs = register_count(tac);
+    int* def_of = malloc((tac->count + 1) * sizeof(int));  // instrução -> definição
+    int* reg_start = calloc(regs + 2, sizeof(int));         // definições de cada registrador (CSR)
+    int defs = 0;
+    for (int i = 0; i < tac->count; i++) {
+        def_of[i] = -1;
+        if (defines(tac->code[i].op)) {
+            def_of[i] = defs++;
+            reg_start[register_of(tac, tac->code[i].result) + 2]++;
+        }
+    }
+    for (int r = 0; r < regs; r++) reg_start[r + 2] += reg_start[r + 1];
+    int* reg_defs = malloc((defs + 1) * sizeof(int));
+    for (int i = 0; i < tac->count; i++) {
+        if (def_of[i] >= 0) reg_defs[reg_start[register_of(tac, tac->code[i].result) + 1]++] = def_of[i];
+    }
+
+    dataflow_init(df, "Reaching definitions", DF_FORWARD, MEET_UNION, cfg->block_count, defs);
+    df->item = malloc((defs + 1) * sizeof(int));
+    df->describe = describe_definition;
+    for (int i = 0; i < tac->count; i++) {
+        if (def_of[i] >= 0) df->item[def_of[i]] = i;
+    }
+
+    int* last_def = malloc((regs + 1) * sizeof(int));     // última definição no bloco
+    for (int r = 0; r < regs; r++) last_def[r] = -1;
+    for (int b = 0; b < cfg->block_count; b++) {
+        Word* gen = bitset_row(df->gen, df->words, b);
+        Word* kill = bitset_row(df->kill, df->words, b);
+        for (int i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            if (def_of[i] < 0) continue;
+            int reg = register_of(tac, tac->code[i].result);
+            if (last_def[reg] >= 0) {
+                bitset_clear(gen, last_def[reg]);
+            } else {
+                for (int k = reg_start[reg]; k < reg_start[reg + 1]; k++) bitset_set(kill, reg_defs[k]);
+            }
+            last_def[reg] = def_of[i];
+            bitset_set(gen, def_of[i]);
+        }
+        for (int i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            if (def_of[i] >= 0) last_def[register_of(tac, tac->code[i].result)] = -1;
+        }
+    }
+    free(last_def);
+    free(reg_defs);
+    free(reg_start);
+    free(def_of);
+
+    dataflow_solve(df, cfg);
+}
+
+/*
+ * Live variables (para trás, união). GEN[B] = USE[B], os registradores
+ * lidos em B antes de qualquer atribuição em B; KILL[B] = DEF[B], os
+ * atribuídos em B.
+ */
+void live_variables(Dataflow* df, const CFG* cfg, const TACCode* tac) {
+    int regs = register_count(tac);
+    dataflow_init(df, "Live variables", DF_BACKWARD, MEET_UNION, cfg->block_count, regs);
+    df->item = malloc((regs + 1) * sizeof(int));
+    df->describe = describe_register;
+    for (int r = 0; r < regs; r++) df->item[r] = r;
+
+    for (int b = 0; b < cfg->block_count; b++) {
+        Word* use = bitset_row(df->gen, df->words, b);
+        Word* def = bitset_row(df->kill, df->words, b);
+        for (int i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            const TACInstr* instr = &tac->code[i];
+            if (instr->op == TAC_LABEL || instr->op == TAC_GOTO) continue;
+            int a = register_of(tac, instr->arg1), c = register_of(tac, instr->arg2);
+            if (a >= 0 && !bitset_test(def, a)) bitset_set(use, a);
+            if (c >= 0 && !bitset_test(def, c)) bitset_set(use, c);
+            if (defines(instr->op)) bitset_set(def, register_of(tac, instr->result));
+        }
+    }
+
+    dataflow_solve(df, cfg);
+}
+
+/*
+ * Expressões: cada (operador, arg1, arg2) aritmético distinto recebe um
+ * bit. + e * são comutativos, então a + b e b + a são a mesma expressão.
+ * uses_start/uses lista, para cada registrador, as expressões que o leem
+ * (CSR): atribuir ao registrador mata todas elas.
+ */
+typedef struct {
+    int* expr_of;           // instrução -> expressão, ou -1
+    int* first_instr;       // expressão -> primeira instrução que a calcula
+    int count;
+    int* uses_start;
+    int* uses;
+} ExpressionTable;
+
+static void expression_key(const TACInstr* instr, Operand* a, Operand* b) {
+    *a = instr->arg1;
+    *b = instr->arg2;
+    if ((instr->op == TAC_ADD || instr->op == TAC_MUL) && *a > *b) {
+        Operand swap = *a;
+        *a = *b;
+        *b = swap;
+    }
+}
+
+static void build_expressions(ExpressionTable* table, const TACCode* tac) {
+    int regs = register_count(tac);
+    int capacity = 64;
+    while (capacity < 2 * tac->count) capacity *= 2;
+    int* slots = malloc(capacity * sizeof(int));           // expressão + 1, ou 0
+    memset(slots, 0, capacity * sizeof(int));
+    table->expr_of = malloc((tac->count + 1) * sizeof(int));
+    table->first_instr = malloc((tac->count + 1) * sizeof(int));
+    table->count = 0;
+
+    for (int i = 0; i < tac->count; i++) {
+        const TACInstr* instr = &tac->code[i];
+        table->expr_of[i] = -1;
+        if (!is_arithmetic(instr->op)) continue;
+        Operand a, b;
+        expression_key(instr, &a, &b);
+        unsigned int h = (instr->op * 31u + a) * 2654435761u ^ b * 40503u;
+        unsigned int slot = (h ^ (h >> 15)) & (unsigned int)(capacity - 1);
+        for (; slots[slot]; slot = (slot + 1) & (unsigned int)(capacity - 1)) {
+            const TACInstr* other = &tac->code[table->first_instr[slots[slot] - 1]];
+            Operand oa, ob;
+            expression_key(other, &oa, &ob);
+            if (other->op == instr->op && oa == a && ob == b) break;
+        }
+        if (!slots[slot]) {
+            table->first_instr[table->count] = i;
+            slots[slot] = ++table->count;
+        }
+        table->expr_of[i] = slots[slot] - 1;
+    }
+    free(slots);
+
+    table->uses_start = calloc(regs + 2, sizeof(int));
+    table->uses = malloc((2 * table->count + 1) * sizeof(int));
+    for (int pass = 0; pass < 2; pass++) {
+        for (int e = 0; e < table->count; e++) {
+            const TACInstr* instr = &tac->code[table->first_instr[e]];
+            int a = register_of(tac, instr->arg1), b = register_of(tac, instr->arg2);
+            if (pass == 0) {
+                if (a >= 0) table->uses_start[a + 2]++;
+                if (b >= 0 && b != a) table->uses_start[b + 2]++;
+            } else {
+                if (a >= 0) table->uses[table->uses_start[a + 1]++] = e;
+                if (b >= 0 && b != a) table->uses[table->uses_start[b + 1]++] = e;
+            }
+        }
+        if (pass == 0) {
+            for (int r = 0; r < regs; r++) table->uses_start[r + 2] += table->uses_start[r + 1];
+        }
+    }
+}
+
+static void free_expressions(ExpressionTable* table) {
+    free(table->expr_of);
+    free(table->first_instr);
+    free(table->uses_start);
+    free(table->uses);
+}
+
+/*
+ * Preenche GEN e KILL de expressões para cada bloco. KILL[B] são as
+ * expressões com algum operando atribuído em B. GEN[B] depende da
+ * direção:
+ *   - available (para frente): calculadas em B sem atribuição posterior
+ *     aos operandos dentro de B;
+ *   - very busy (para trás): calculadas em B antes de qualquer atribuição
+ *     aos operandos dentro de B (o bit de KILL ainda está desligado).
+ */
+static void expression_sets(Dataflow* df, const CFG* cfg, const TACCode* tac,
+                            const ExpressionTable* table) {
+    int forward = df->direction == DF_FORWARD;
+    df->item = malloc((table->count + 1) * sizeof(int));
+    df->describe = describe_expression;
+    memcpy(df->item, table->first_instr, table->count * sizeof(int));
+
+    for (int b = 0; b < cfg->block_count; b++) {
+        Word* gen = bitset_row(df->gen, df->words, b);
+        Word* kill = bitset_row(df->kill, df->words, b);
+        for (int i = cfg->blocks[b].first; i < cfg->blocks[b].end; i++) {
+            const TACInstr* instr = &tac->code[i];
+            if (!defines(instr->op)) continue;
+            int e = table->expr_of[i];
+            if (e >= 0 && (forward || !bitset_test(kill, e))) bitset_set(gen, e);
+
+            int reg = register_of(tac, instr->result);
+            for (int k = table->uses_start[reg]; k < table->uses_start[reg + 1]; k++) {
+                bitset_set(kill, table->uses[k]);
+                if (forward) bitset_clear(gen, table->uses[k]);
+            }
+        }
+    }
+}
+
+// Available expressions (para frente, interseção)
+void available_expressions(Dataflow* df, const CFG* cfg, const TACCode* tac) {
+    ExpressionTable table;
+    build_expressions(&table, tac);
+    dataflow_init(df, "Available expressions", DF_FORWARD, MEET_INTERSECTION,
+                  cfg->block_count, table.count);
+    expression_sets(df, cfg, tac, &table);
+    free_expressions(&table);
+    dataflow_solve(df, cfg);
+}
+
+// Very busy expressions (para trás, interseção)
+void very_busy_expressions(Dataflow* df, const CFG* cfg, const TACCode* tac) {
+    ExpressionTable table;
+    build_expressions(&table, tac);
+    dataflow_init(df, "Very busy expressions", DF_BACKWARD, MEET_INTERSECTION,
+                  cfg->block_count, table.count);
+    expression_sets(df, cfg, tac, &table);
+    free_expressions(&table);
+    dataflow_solve(df, cfg);
+}
+
+typedef void (*Analysis)(Dataflow* df, const CFG* cfg, const TACCode* tac);
+
+static const Analysis analyses[] = {
+    reaching_definitions, live_variables, available_expressions, very_busy_expressions
+};
+
+#define ANALYSIS_COUNT ((int)(sizeof(analyses) / sizeof(analyses[0])))
+
+static void print_set(const Dataflow* df, const TACCode* tac, const Word* set) {
+    char text[80];
+    int first = 1;
+    printf("{");
+    for (int bit = 0; bit < df->bits; bit++) {
+        if (!bitset_test(set, bit)) continue;
+        df->describe(tac, df->item[bit], text);
+        printf(first ? "%s" : ", %s", text);
+        first = 0;
+    }
+    printf("}");
+}
+
+void dataflow_print(const Dataflow* df, const CFG* cfg, const TACCode* tac) {
+    printf("\n--- %s (%s, %s) ---\n", df->name,
+           df->direction == DF_FORWARD ? "para frente" : "para trás",
+           df->meet == MEET_UNION ? "união" : "interseção");
+    printf("%d bits, ponto fixo em %d visitas a blocos\n", df->bits, df->visits);
+    for (int b = 0; b < cfg->block_count; b++) {
+        printf("B%d  IN  = ", b);
+        print_set(df, tac, bitset_row(df->in, df->words, b));
+        printf("\n    OUT = ");
+        print_set(df, tac, bitset_row(df->out, df->words, b));
+        printf("\n");
+    }
+}
+
+// ========== EXEMPLO ==========
+
+/*
+ * Soma dos pares menores que n, com um laço e um if dentro dele:
+ *
+ *       i = 0
+ *       s = 0
+ *   L0: if i < n goto L1
+ *       goto L4
+ *   L1: t0 = i / 2
+ *       t1 = t0 * 2
+ *       if t1 != i goto L3
+ *   L2: t2 = s + i
+ *       s = t2
+ *   L3: t3 = i + 1
+ *       i = t3
+ *       goto L0
+ *   L4: r = s
+ *       goto L5
+ *       r = 0          (inalcançável)
+ *   L5:
+ */
+void build_example(TACCode* tac) {
+    Operand i = tac_var(tac, "i"), s = tac_var(tac, "s"), n = tac_var(tac, "n");
+    Operand r = tac_var(tac, "r");
+    Operand zero = tac_const(tac, 0), one = tac_const(tac, 1), two = tac_const(tac, 2);
+    Operand L[6];
+    for (int k = 0; k < 6; k++) L[k] = new_label(tac);
+
+    emit(tac, TAC_COPY, i, zero, NO_OPERAND);
+    emit(tac, TAC_COPY, s, zero, NO_OPERAND);
+    emit(tac, TAC_LABEL, L[0], NO_OPERAND, NO_OPERAND);
+    emit(tac, TAC_IF_LT, L[1], i, n);
+    emit(tac, TAC_GOTO, L[4], NO_OPERAND, NO_OPERAND);
+    emit(tac, TAC_LABEL, L[1], NO_OPERAND, NO_OPERAND);
+    Operand t0 = new_temp(tac), t1 = new_temp(tac);
+    emit(tac, TAC_DIV, t0, i, two);
+    emit(tac, TAC_MUL, t1, t0, two);
+    emit(tac, TAC_IF_NE, L[3], t1, i);
+    emit(tac, TAC_LABEL, L[2], NO_OPERAND, NO_OPERAND);
+    Operand t2 = new_temp(tac);
+    emit(tac, TAC_ADD, t2, s, i);
+    emit(tac, TAC_COPY, s, t2, NO_OPERAND);
+    emit(tac, TAC_LABEL, L[3], NO_OPERAND, NO_OPERAND);
+    Operand t3 = new_temp(tac);
+    emit(tac, TAC_ADD, t3, i, one);
+    emit(tac, TAC_COPY, i, t3, NO_OPERAND);
+    emit(tac, TAC_GOTO, L[0], NO_OPERAND, NO_OPERAND);
+    emit(tac, TAC_LABEL, L[4], NO_OPERAND, NO_OPERAND);
+    emit(tac, TAC_COPY, r, s, NO_OPERAND);
+    emit(tac, TAC_GOTO, L[5], NO_OPERAND, NO_OPERAND);
+    emit(tac, TAC_COPY, r, zero, NO_OPERAND);
+    emit(tac, TAC_LABEL, L[5], NO_OPERAND, NO_OPERAND);
+}
+
+// ========== BENCHMARK ==========
+
+/*
+ * Gerador de programas estruturados: sequências de atribuições, if/else e
+ * laços while aninhados, com variáveis de um conjunto fixo. O gerador é
+ * determinístico (semente fixa), então o programa é sempre o mesmo.
+ */
+typedef struct {
+    TACCode* tac;
+    Operand vars[64];
+    unsigned int seed;
+    int remaining;          // comandos que ainda podem ser gerados
+} ProgramGenerator;
+
+static unsigned int next_random(ProgramGenerator* gen) {
+    gen->seed = gen->seed * 1103515245u + 12345u;
+    return gen->seed >> 8;
+}
+
+static Operand random_var(ProgramGenerator* gen) {
+    return gen->vars[next_random(gen) % 64];
+}
+
+static Operand random_operand(ProgramGenerator* gen) {
+    if (next_random(gen) % 4 == 0) return tac_const(gen->tac, (int)(next_random(gen) % 16));
+    return random_var(gen);
+}
+
+static void generate_block(ProgramGenerator* gen, int depth);
+
+static void generate_statement(ProgramGenerator* gen, int depth) {
+    TACCode* tac = gen->tac;
+    gen->remaining--;
+    unsigned int choice = next_random(gen) % (depth < 6 ? 5 : 2);
+
+    if (choice < 2) {
+        // x = a op b   (e às vezes uma cópia simples)
+        emit(tac, TAC_ADD + next_random(gen) % 3, random_var(gen), random_var(gen), random_operand(gen));
+        if (choice == 1) emit(tac, TAC_COPY, random_var(gen), random_operand(gen), NO_OPERAND);
+    } else if (choice < 4) {
+        // if a < b { ... } else { ... }
+        Operand L_then = new_label(tac), L_else = new_label(tac), L_end = new_label(tac);
+        emit(tac, TAC_IF_LT + next_random(gen) % 6, L_then, random_var(gen), random_operand(gen));
+        emit(tac, TAC_GOTO, L_else, NO_OPERAND, NO_OPERAND);
+        emit(tac, TAC_LABEL, L_then, NO_OPERAND, NO_OPERAND);
+        generate_block(gen, depth + 1);
+        emit(tac, TAC_GOTO, L_end, NO_OPERAND, NO_OPERAND);
+        emit(tac, TAC_LABEL, L_else, NO_OPERAND, NO_OPERAND);
+        generate_block(gen, depth + 1);
+        emit(tac, TAC_LABEL, L_end, NO_OPERAND, NO_OPERAND);
+    } else {
+        // while (a < b) { ... }
+        Operand L_start = new_label(tac), L_body = new_label(tac), L_end = new_label(tac);
+        emit(tac, TAC_LABEL, L_start, NO_OPERAND, NO_OPERAND);
+        emit(tac, TAC_IF_LT, L_body, random_var(gen), random_operand(gen));
+        emit(tac, TAC_GOTO, L_end, NO_OPERAND, NO_OPERAND);
+        emit(tac, TAC_LABEL, L_body, NO_OPERAND, NO_OPERAND);
+        generate_block(gen, depth + 1);
+        emit(tac, TAC_GOTO, L_start, NO_OPERAND, NO_OPERAND);
+        emit(tac, TAC_LABEL, L_end, NO_OPERAND, NO_OPERAND);
+    }
+}
+
+static void generate_block(ProgramGenerator* gen, int depth) {
+    int statements = 1 + (int)(next_random(gen) % 3);
+    for (int k = 0; k < statements && gen->remaining > 0; k++) {
+        generate_statement(gen, depth);
+    }
+}
+
+// Programa gerado com cerca de 'statements' comandos
+void generate_program(TACCode* tac, int statements) {
+    ProgramGenerator gen;
+    gen.tac = tac;
+    gen.seed = 2024;
+    gen.remaining = statements;
+    for (int v = 0; v < 64; v++) {
+        char name[8];
+        sprintf(name, "v%d", v);
+        gen.vars[v] = tac_var(tac, name);
+    }
+    while (gen.remaining > 0) generate_statement(&gen, 0);
+}
+
+void run_benchmark(int statements) {
+    TACCode tac = {0};
+    clock_t start = clock();
+    generate_program(&tac, statements);
+    double generate = elapsed_seconds(start);
+
+    const int repetitions = 20;
+    CFG* cfg = NULL;
+    start = clock();
+    for (int rep = 0; rep < repetitions; rep++) {
+        cfg_free(cfg);
+        cfg = cfg_build(&tac);
+    }
+    double build = elapsed_seconds(start) / repetitions;
+
+    size_t bytes = (cfg->block_count + 1) * (sizeof(BasicBlock) + 4 * sizeof(int)) +
+                   (size_t)tac.count * sizeof(int) + 2 * (size_t)cfg->edge_count * sizeof(int);
+    printf("Programa gerado com %d comandos: %d instruções TAC (%.3f s)\n",
+           statements, tac.count, generate);
+    printf("CFG: %d blocos, %d arestas, %d alcançáveis\n",
+           cfg->block_count, cfg->edge_count, cfg->rpo_count);
+    printf("Construção (líderes, blocos, arestas, predecessores, pós-ordem reversa):\n");
+    printf("  %.4f s por construção (média de %d), %.1f milhões de instruções/s, %.1f KB\n",
+           build, repetitions, build > 0 ? tac.count / build / 1e6 : 0.0, bytes / 1024.0);
+
+    printf("\nAnálises (GEN/KILL + solver):\n");
+    printf("  %-22s %8s %8s %10s %9s %10s\n", "", "bits", "visitas", "visitas/B", "tempo", "memória");
+    for (int a = 0; a < ANALYSIS_COUNT; a++) {
+        Dataflow df;
+        start = clock();
+        analyses[a](&df, cfg, &tac);
+        double solve = elapsed_seconds(start);
+        double megabytes = 4.0 * cfg->block_count * df.words * sizeof(Word) / (1024.0 * 1024.0);
+        printf("  %-22s %8d %8d %10.2f %7.3f s %7.1f MB\n", df.name, df.bits, df.visits,
+               (double)df.visits / cfg->block_count, solve, megabytes);
+        dataflow_free(&df);
+    }
+
+    cfg_free(cfg);
+    tac_free(&tac);
+}
+
+// ========== MAIN ==========
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--benchmark") == 0) {
+        int statements = argc > 2 ? atoi(argv[2]) : 20000;
+        if (statements < 1) {
+            printf("Uso: %s --benchmark [N]\n", argv[0]);
+            return 1;
+        }
+        run_benchmark(statements);
+        return 0;
+    }
+
+    TACCode tac = {0};
+    build_example(&tac);
+    CFG* cfg = cfg_build(&tac);
+    if (!cfg) return 1;
+
+    if (argc > 1 && strcmp(argv[1], "--dot") == 0) {
+        cfg_write_dot(cfg, &tac, stdout);
+    } else {
+        printf("=== CÓDIGO DE TRÊS ENDEREÇOS ===\n");
+        print_tac(&tac);
+        printf("\n=== BLOCOS BÁSICOS E CFG ===\n");
+        printf("%d blocos, %d arestas\n", cfg->block_count, cfg->edge_count);
+        cfg_print(cfg, &tac);
+
+        printf("\n=== ANÁLISE DE FLUXO DE DADOS ===\n");
+        for (int a = 0; a < ANALYSIS_COUNT; a++) {
+            Dataflow df;
+            analyses[a](&df, cfg, &tac);
+            dataflow_print(&df, cfg, &tac);
+            dataflow_free(&df);
+        }
+        printf("\nPara ver o grafo: %s --dot | dot -Tpng -o cfg.png\n", argv[0]);
+    }
+
+    cfg_free(cfg);
+    tac_free(&tac);
+    return 0;
+}